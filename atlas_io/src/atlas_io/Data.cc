@@ -10,7 +10,10 @@
 
 #include "Data.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "eckit/utils/Compressor.h"
 
@@ -18,24 +21,73 @@
 #include "atlas_io/Trace.h"
 #include "atlas_io/detail/Assert.h"
 #include "atlas_io/detail/Checksum.h"
+#include "atlas_io/detail/Parallel.h"
 
 namespace atlas {
 namespace io {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+namespace {
+
+std::unique_ptr<eckit::Compressor> make_compressor(const std::string& compression) {
+    return std::unique_ptr<eckit::Compressor>(eckit::CompressorFactory::instance().build(compression));
+}
+
+bool no_compression(const eckit::Compressor& compressor) {
+    return dynamic_cast<const eckit::NoCompressor*>(&compressor) != nullptr;
+}
+
+size_t nb_chunks(size_t size, size_t chunk_size) {
+    return (size + chunk_size - 1) / chunk_size;
+}
+
+// The chunk table is stored little-endian, so that it is independent of the data endianness
+
+void put_uint64(unsigned char* p, std::uint64_t v) {
+    for (size_t b = 0; b < 8; ++b) {
+        p[b] = static_cast<unsigned char>(v >> (8 * b));
+    }
+}
+
+std::uint64_t get_uint64(const unsigned char* p) {
+    std::uint64_t v{0};
+    for (size_t b = 0; b < 8; ++b) {
+        v |= std::uint64_t(p[b]) << (8 * b);
+    }
+    return v;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------------------------
+
 Data::Data(void* p, size_t size): buffer_(p, size), size_(size) {}
 
+Data::Data(const void* p, size_t size, std::shared_ptr<const void> keep_alive):
+    size_(size), view_(p), keep_alive_(std::move(keep_alive)) {
+    ATLAS_IO_ASSERT(view_ != nullptr || size_ == 0);
+}
+
+void Data::release_view() {
+    if (view_) {
+        view_ = nullptr;
+        keep_alive_.reset();
+        size_ = 0;
+    }
+}
+
 std::uint64_t Data::write(Stream& out) const {
     ATLAS_IO_TRACE();
     if (size()) {
-        ATLAS_IO_ASSERT(buffer_.size() >= size());
-        return out.write(buffer_.data(), size());
+        ATLAS_IO_ASSERT(view_ || buffer_.size() >= size());
+        return out.write(data(), size());
     }
     return 0;
 }
 
 std::uint64_t Data::read(Stream& in, size_t size) {
+    release_view();
     if (size > size_) {
         buffer_.resize(size);
         size_ = size;
@@ -52,8 +104,10 @@ void Data::compress(const std::string& compression) {
             return;
         }
         eckit::Buffer compressed(size_t(1.2 * size_));
-        size_   = compressor->compress(buffer_, size_, compressed);
+        size_   = compressor->compress(data(), size_, compressed);
         buffer_ = std::move(compressed);
+        view_   = nullptr;
+        keep_alive_.reset();
     }
 }
 
@@ -66,30 +120,108 @@ void Data::decompress(const std::string& compression, size_t uncompressed_size)
     }
 
     eckit::Buffer uncompressed(size_t(1.2 * uncompressed_size));
-    compressor->uncompress(buffer_, size_, uncompressed, uncompressed_size);
+    compressor->uncompress(data(), size_, uncompressed, uncompressed_size);
     size_   = uncompressed_size;
     buffer_ = std::move(uncompressed);
+    view_   = nullptr;
+    keep_alive_.reset();
+}
+
+void Data::compress(const std::string& compression, size_t chunk_size, size_t nb_threads) {
+    if (chunk_size == 0 || size_ <= chunk_size) {
+        compress(compression);
+        return;
+    }
+    ATLAS_IO_TRACE("compress(" + compression + ",chunked)");
+    if (no_compression(*make_compressor(compression))) {
+        return;
+    }
+
+    const size_t nb = nb_chunks(size_, chunk_size);
+    std::vector<eckit::Buffer> chunks(nb);
+    std::vector<size_t> chunk_sizes(nb);
+    const auto* in = static_cast<const unsigned char*>(data());
+    parallel_for(nb, nb_threads, [&](size_t c) {
+        const size_t offset = c * chunk_size;
+        const size_t size   = std::min(chunk_size, size_ - offset);
+        auto compressor     = make_compressor(compression);
+        chunks[c].resize(size_t(1.2 * size) + 1024);
+        chunk_sizes[c] = compressor->compress(in + offset, size, chunks[c]);
+    });
+
+    size_t compressed_size = 8 * (nb + 1);
+    for (size_t c = 0; c < nb; ++c) {
+        compressed_size += chunk_sizes[c];
+    }
+    eckit::Buffer compressed(compressed_size);
+    auto* out = static_cast<unsigned char*>(compressed.data());
+    put_uint64(out, nb);
+    size_t offset = 8 * (nb + 1);
+    for (size_t c = 0; c < nb; ++c) {
+        put_uint64(out + 8 * (c + 1), chunk_sizes[c]);
+        std::memcpy(out + offset, chunks[c].data(), chunk_sizes[c]);
+        offset += chunk_sizes[c];
+    }
+    size_   = compressed_size;
+    buffer_ = std::move(compressed);
+    view_   = nullptr;
+    keep_alive_.reset();
+}
+
+void Data::decompress(const std::string& compression, size_t uncompressed_size, size_t chunk_size,
+                      size_t nb_threads) {
+    if (chunk_size == 0 || uncompressed_size <= chunk_size) {
+        decompress(compression, uncompressed_size);
+        return;
+    }
+    ATLAS_IO_TRACE("decompress(" + compression + ",chunked)");
+    if (no_compression(*make_compressor(compression))) {
+        return;
+    }
+
+    const size_t nb = nb_chunks(uncompressed_size, chunk_size);
+    const auto* in  = static_cast<const unsigned char*>(data());
+    ATLAS_IO_ASSERT_MSG(size_ >= 8 * (nb + 1) && get_uint64(in) == nb, "Corrupted chunked compressed data");
+    std::vector<size_t> offsets(nb + 1);
+    offsets[0] = 8 * (nb + 1);
+    for (size_t c = 0; c < nb; ++c) {
+        offsets[c + 1] = offsets[c] + get_uint64(in + 8 * (c + 1));
+    }
+    ATLAS_IO_ASSERT_MSG(offsets[nb] == size_, "Corrupted chunked compressed data");
+
+    eckit::Buffer uncompressed(uncompressed_size);
+    auto* out = static_cast<unsigned char*>(uncompressed.data());
+    parallel_for(nb, nb_threads, [&](size_t c) {
+        const size_t size = std::min(chunk_size, uncompressed_size - c * chunk_size);
+        auto compressor   = make_compressor(compression);
+        eckit::Buffer chunk(size_t(1.2 * size) + 1024);
+        compressor->uncompress(in + offsets[c], offsets[c + 1] - offsets[c], chunk, size);
+        std::memcpy(out + c * chunk_size, chunk.data(), size);
+    });
+    size_   = uncompressed_size;
+    buffer_ = std::move(uncompressed);
+    view_   = nullptr;
+    keep_alive_.reset();
 }
 
 void Data::clear() {
+    release_view();
     buffer_ = eckit::Buffer{};
     size_   = 0;
 }
 
 std::string Data::checksum(const std::string& algorithm) const {
-    return atlas::io::checksum(buffer_, size_, algorithm);
+    return atlas::io::checksum(data(), size_, algorithm);
 }
 
 void Data::assign(const Data& other) {
-    if (other.size() > buffer_.size()) {
-        buffer_.resize(other.size());
-    }
-    size_ = other.size();
-    buffer_.copy(other.buffer_, size_);
+    assign(other.data(), other.size());
 }
 
 void Data::assign(const void* p, size_t s) {
-    if (s > size()) {
+    auto keep_alive = keep_alive_;  // p may point into the current view
+    release_view();
+    if (s > buffer_.size()) {
         buffer_.resize(s);
     }
     size_ = s;
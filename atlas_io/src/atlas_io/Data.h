@@ -11,6 +11,8 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <string>
 
 #include "eckit/io/Buffer.h"
 
@@ -28,10 +30,17 @@ public:
     Data(Data&&)            = default;
     Data& operator=(Data&&) = default;
 
+    /// @brief Non-owning view of given memory, e.g. a memory mapped file, which is kept valid by keep_alive
+    Data(const void*, size_t, std::shared_ptr<const void> keep_alive);
+
     operator const void*() const { return data(); }
-    const void* data() const { return buffer_.data(); }
+    const void* data() const { return view_ ? view_ : buffer_.data(); }
     size_t size() const { return size_; }
 
+    /// @brief True if this is a non-owning view of memory that is kept valid by keep_alive()
+    bool view() const { return view_ != nullptr; }
+    const std::shared_ptr<const void>& keep_alive() const { return keep_alive_; }
+
     void assign(const Data& other);
     void assign(const void*, size_t);
     void clear();
@@ -40,11 +49,28 @@ public:
     std::uint64_t read(Stream& in, size_t size);
     void compress(const std::string& compression);
     void decompress(const std::string& compression, size_t uncompressed_size);
+
+    /// @brief Compress in independent chunks of chunk_size bytes, concurrently using nb_threads threads
+    ///
+    /// When the data is not larger than chunk_size, this is equivalent to compress(compression).
+    /// Otherwise the compressed data is laid out as
+    ///   [ nb_chunks | compressed size of each chunk | compressed chunks ]
+    /// with the sizes stored as little-endian 64-bit unsigned integers. The result does not depend on nb_threads.
+    void compress(const std::string& compression, size_t chunk_size, size_t nb_threads);
+
+    /// @brief Decompress data compressed with compress(compression, chunk_size, nb_threads)
+    void decompress(const std::string& compression, size_t uncompressed_size, size_t chunk_size, size_t nb_threads);
+
     std::string checksum(const std::string& algorithm = "") const;
 
+private:
+    void release_view();
+
 private:
     eckit::Buffer buffer_;
     size_t size_{0};
+    const void* view_{nullptr};
+    std::shared_ptr<const void> keep_alive_;
 };
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -10,6 +10,8 @@
 
 #include "ReadRequest.h"
 
+#include <chrono>
+
 #include "eckit/log/Log.h"
 
 #include "atlas_io/Exceptions.h"
@@ -33,6 +35,7 @@ static std::string stream_path(Stream stream) {
 ReadRequest::ReadRequest(const std::string& URI, atlas::io::Decoder* decoder):
     uri_(URI), decoder_(decoder), item_(new RecordItem()) {
     do_checksum_ = defaults::checksum_read();
+    do_mmap_     = defaults::read_mmap();
     ATLAS_IO_ASSERT(uri_.size());
 }
 
@@ -57,7 +60,9 @@ ReadRequest::ReadRequest(ReadRequest&& other):
     decoder_(std::move(other.decoder_)),
     item_(std::move(other.item_)),
     do_checksum_{other.do_checksum_},
-    finished_{other.finished_} {
+    do_mmap_{other.do_mmap_},
+    finished_{other.finished_},
+    prefetched_{std::move(other.prefetched_)} {
     other.do_checksum_ = true;
     other.finished_    = true;
 }
@@ -65,6 +70,9 @@ ReadRequest::ReadRequest(ReadRequest&& other):
 //---------------------------------------------------------------------------------------------------------------------
 
 ReadRequest::~ReadRequest() {
+    if (prefetched_.valid()) {
+        prefetched_.wait();  // the background read still refers to the decoder target via item_
+    }
     if (item_) {
         if (not finished_) {
             eckit::Log::error() << "Request for " << uri_ << " was not completed." << std::endl;
@@ -75,12 +83,18 @@ ReadRequest::~ReadRequest() {
 //---------------------------------------------------------------------------------------------------------------------
 
 void ReadRequest::read() {
+    if (prefetched_.valid()) {
+        auto prefetched = std::move(prefetched_);
+        prefetched.get();  // rethrows any exception from reading in the background
+    }
     if (item_->empty()) {
         if (stream_) {
             RecordItemReader{stream_, offset_, key_}.read(*item_);
         }
         else {
-            RecordItemReader(uri_).read(*item_);
+            RecordItemReader reader(uri_);
+            reader.mmap(do_mmap_);
+            reader.read(*item_);
         }
     }
 }
@@ -114,6 +128,10 @@ void ReadRequest::checksum() {
     do_checksum_ = false;
 }
 
+void ReadRequest::mmap(bool b) {
+    do_mmap_ = b;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 
 void ReadRequest::decompress() {
@@ -152,5 +170,17 @@ void ReadRequest::wait() {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+bool ReadRequest::ready() const {
+    if (finished_ || not item_) {
+        return true;
+    }
+    if (prefetched_.valid()) {
+        return prefetched_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    return not item_->empty();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace io
 }  // namespace atlas
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <string>
 
@@ -48,9 +49,17 @@ public:
 
     void wait();
 
+    /// @brief True when wait() does not need to wait for data to be read, e.g. after RecordReader::prefetch
+    bool ready() const;
+
     void checksum(bool);
 
+    /// @brief Read uncompressed native-endian data of file based records through a memory mapping of the file
+    void mmap(bool);
+
 private:
+    friend class RecordReader;
+
     ReadRequest(const std::string& URI, Decoder* decoder);
     ReadRequest(Stream, size_t offset, const std::string& key, Decoder*);
 
@@ -62,9 +71,11 @@ private:
     std::string key_;
     std::string uri_;
     std::unique_ptr<Decoder> decoder_;
-    std::unique_ptr<RecordItem> item_;
+    std::shared_ptr<RecordItem> item_;  ///< Shared with background reads of RecordReader::prefetch
     bool do_checksum_{true};
+    bool do_mmap_{false};
     bool finished_{false};
+    std::shared_future<void> prefetched_;  ///< Completes when the item is read by RecordReader::prefetch
 };
 
 //---------------------------------------------------------------------------------------------------------------------
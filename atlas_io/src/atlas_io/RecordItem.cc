@@ -14,6 +14,7 @@
 
 #include "atlas_io/atlas_compat.h"
 #include "atlas_io/detail/Assert.h"
+#include "atlas_io/detail/Defaults.h"
 
 namespace atlas {
 namespace io {
@@ -98,7 +99,8 @@ void RecordItem::clear() {
 void RecordItem::decompress() {
     ATLAS_IO_ASSERT(not empty());
     if (metadata().data.compressed()) {
-        data_.decompress(metadata().data.compression(), metadata().data.size());
+        data_.decompress(metadata().data.compression(), metadata().data.size(), metadata().data.chunk_size(),
+                         defaults::threads());
     }
     metadata_->data.compressed(false);
 }
@@ -108,7 +110,7 @@ void RecordItem::decompress() {
 void RecordItem::compress() {
     ATLAS_IO_ASSERT(not empty());
     if (not metadata().data.compressed() && metadata().data.compression() != "none") {
-        data_.compress(metadata().data.compression());
+        data_.compress(metadata().data.compression(), metadata().data.chunk_size(), defaults::threads());
         metadata_->data.compressed(true);
     }
 }
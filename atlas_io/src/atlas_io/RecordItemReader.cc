@@ -10,12 +10,15 @@
 
 #include "RecordItemReader.h"
 
+#include <cstring>
+
 #include "atlas_io/Exceptions.h"
 #include "atlas_io/FileStream.h"
 #include "atlas_io/Record.h"
 #include "atlas_io/Session.h"
 #include "atlas_io/Trace.h"
 #include "atlas_io/detail/Assert.h"
+#include "atlas_io/detail/MappedFile.h"
 #include "atlas_io/detail/ParsedRecord.h"
 #include "atlas_io/detail/RecordSections.h"
 
@@ -79,6 +82,20 @@ static Data read_data(const Record& record, int data_section_index, Stream in) {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+static Data map_data(const Record& record, int data_section_index, const std::string& path) {
+    ATLAS_IO_TRACE("map_data(data_section=" + std::to_string(data_section_index) + ")");
+
+    const auto& parsed       = static_cast<const ParsedRecord&>(record);
+    const auto& data_section = parsed.data_sections.at(size_t(data_section_index) - 1);
+
+    // Each item has its own copy-on-write mapping of only its data section, so that writing to one decoded item
+    // never affects other items, or other reads of the same item
+    auto mapped_file = std::make_shared<MappedFile>(path, data_section.offset, data_section.length);
+    return data_section_view(static_cast<const char*>(mapped_file->data()), data_section.length, mapped_file);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 static eckit::PathName make_absolute_path(const std::string& reference_path, RecordItem::URI& uri) {
     eckit::PathName absolute_path = uri.path;
     if (reference_path.size() && uri.path[0] != '/' && uri.path[0] != '~') {
@@ -116,6 +133,24 @@ static Record read_record(Stream in, size_t offset) {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+Data data_section_view(const void* section, size_t length, std::shared_ptr<const void> keep_alive) {
+    ATLAS_IO_ASSERT(length >= sizeof(RecordDataSection::Begin) + sizeof(RecordDataSection::End));
+    const char* begin = static_cast<const char*>(section);
+    const char* end   = begin + length - sizeof(RecordDataSection::End);
+
+    RecordDataSection::Begin data_begin;
+    RecordDataSection::End data_end;
+    std::memcpy(&data_begin, begin, sizeof(data_begin));
+    std::memcpy(&data_end, end, sizeof(data_end));
+    if (not data_begin.valid() || not data_end.valid()) {
+        throw InvalidRecord("Data section is not valid");
+    }
+    begin += sizeof(RecordDataSection::Begin);
+    return atlas::io::Data(begin, size_t(end - begin), std::move(keep_alive));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 RecordItemReader::RecordItemReader(Stream in, size_t offset, const std::string& key): in_(in), uri_{"", offset, key} {
     ATLAS_IO_TRACE("RecordItemReader(Stream,offset,key");
     record_ = read_record(in, uri_.offset);
@@ -213,17 +248,31 @@ void RecordItemReader::read(io::Metadata& metadata, io::Data& data) {
 
     if (metadata.link()) {
         Metadata linked;
-        RecordItemReader{absolute_path.dirName(), metadata.link()}.read(linked, data);
+        RecordItemReader linked_reader{absolute_path.dirName(), metadata.link()};
+        linked_reader.mmap(mmap_);
+        linked_reader.read(linked, data);
         metadata.link(std::move(linked));
     }
     else {
         if (metadata.data.section()) {
-            data = atlas::io::read_data(record_, metadata.data.section(), InputFileStream(absolute_path));
+            // Compressed or byte-swapped data needs to be copied anyway
+            if (mmap_ && not metadata.data.compressed() && metadata.data.endian() == Endian::native) {
+                data = map_data(record_, metadata.data.section(), absolute_path);
+            }
+            else {
+                data = atlas::io::read_data(record_, metadata.data.section(), InputFileStream(absolute_path));
+            }
         }
     }
 };
 
 //---------------------------------------------------------------------------------------------------------------------
 
+void RecordItemReader::mmap(bool b) {
+    mmap_ = b;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace io
 }  // namespace atlas
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "atlas_io/Record.h"
@@ -35,6 +36,9 @@ public:
 
     void read(Metadata&, Data&);
 
+    /// @brief Read uncompressed native-endian data of file based records as a view into a memory mapped file
+    void mmap(bool);
+
 private:
     RecordItemReader(const std::string& ref, const std::string& uri);
 
@@ -43,9 +47,17 @@ private:
 
     std::string ref_{};  // directory to which relative URI's are evaluated
     RecordItem::URI uri_;
+
+    bool mmap_{false};
 };
 
 //---------------------------------------------------------------------------------------------------------------------
 
+/// @brief View of the data in a data section of given length held in memory, which is kept valid by keep_alive
+/// @throws InvalidRecord when the section markers are not valid
+Data data_section_view(const void* section, size_t length, std::shared_ptr<const void> keep_alive);
+
+//---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace io
 }  // namespace atlas
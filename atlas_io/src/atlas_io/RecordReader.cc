@@ -10,12 +10,85 @@
 
 #include "RecordReader.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <memory>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "eckit/io/Buffer.h"
+
+#include "atlas_io/Exceptions.h"
+#include "atlas_io/FileStream.h"
 #include "atlas_io/Metadata.h"
 #include "atlas_io/RecordItemReader.h"
+#include "atlas_io/Trace.h"
+#include "atlas_io/detail/Defaults.h"
+#include "atlas_io/detail/Parallel.h"
+#include "atlas_io/detail/ParsedRecord.h"
 
 namespace atlas {
 namespace io {
 
+namespace {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// File opened for positional reads, so that multiple threads can read concurrently with their own descriptor
+class PositionalFile {
+public:
+    explicit PositionalFile(const std::string& path): path_(path) {
+        fd_ = ::open(path_.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw Exception("Could not open " + path_ + ": " + std::strerror(errno), Here());
+        }
+    }
+    ~PositionalFile() { ::close(fd_); }
+
+    void read(void* buffer, size_t size, std::uint64_t offset) const {
+        char* p = static_cast<char*>(buffer);
+        while (size > 0) {
+            auto bytes = ::pread(fd_, p, size, static_cast<off_t>(offset));
+            if (bytes < 0 && errno == EINTR) {
+                continue;
+            }
+            if (bytes < 0) {
+                throw Exception("Could not read " + path_ + ": " + std::strerror(errno), Here());
+            }
+            if (bytes == 0) {
+                throw InvalidRecord("Unexpected EOF reached in " + path_);
+            }
+            p += bytes;
+            size -= size_t(bytes);
+            offset += std::uint64_t(bytes);
+        }
+    }
+
+private:
+    std::string path_;
+    int fd_;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+Record read_record(const std::string& path, size_t offset) {
+    auto record = Session::record(path, offset);
+    if (record.empty()) {
+        auto in = InputFileStream(path);
+        in.seek(offset);
+        record.read(in);
+    }
+    return record;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace
+
 //---------------------------------------------------------------------------------------------------------------------
 
 RecordReader::RecordReader(const Record::URI& ref): RecordReader(ref.path, ref.offset) {}
@@ -53,12 +126,125 @@ void RecordReader::wait(const std::string& key) {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+void RecordReader::prefetch() {
+    if (stream_) {
+        return;
+    }
+
+    // Requests that are completed, already started, or read via memory mapping are not prefetched
+    auto prefetchable = [](const ReadRequest& request) {
+        return request.item_ && not request.finished_ && not request.prefetched_.valid() && request.item_->empty() &&
+               not request.do_mmap_;
+    };
+    using Pair = std::pair<const std::string, ReadRequest>;
+    if (std::none_of(requests_.begin(), requests_.end(), [&](const Pair& pair) { return prefetchable(pair.second); })) {
+        return;
+    }
+    ATLAS_IO_TRACE("RecordReader::prefetch");
+
+    struct Section {
+        std::shared_ptr<RecordItem> item;  // shared, so that the item outlives its request while being read
+        ReadRequest* request;
+        Metadata metadata;
+        std::uint64_t offset;
+        std::uint64_t length;
+    };
+    struct Block {
+        std::uint64_t begin;
+        std::uint64_t end;
+        std::vector<Section> sections;
+        std::promise<void> done;
+    };
+
+    Record record             = read_record(path_, offset_);
+    const auto& data_sections = static_cast<const ParsedRecord&>(record).data_sections;
+
+    std::vector<Section> sections;
+    for (auto& pair : requests_) {
+        auto& request = pair.second;
+        if (not prefetchable(request) || not record.has(pair.first)) {
+            continue;
+        }
+        const auto& metadata = record.metadata(pair.first);
+        if (metadata.link() || metadata.data.section() == 0) {
+            continue;  // read when waited for
+        }
+        const auto& data_section = data_sections.at(size_t(metadata.data.section()) - 1);
+        sections.emplace_back(Section{request.item_, &request, metadata, data_section.offset, data_section.length});
+    }
+    std::sort(sections.begin(), sections.end(),
+              [](const Section& a, const Section& b) { return a.offset < b.offset; });
+
+    // Coalesce adjacent sections into blocks. Small gaps, e.g. section markers and padding, or items that were
+    // not requested, are read along rather than issuing another read.
+    constexpr std::uint64_t max_gap = 1024 * 1024;
+    const std::uint64_t block_size  = defaults::read_block_size();
+    auto blocks                     = std::make_shared<std::vector<Block>>();
+    for (auto& section : sections) {
+        if (blocks->empty() || section.offset > blocks->back().end + max_gap ||
+            section.offset + section.length - blocks->back().begin > block_size) {
+            blocks->emplace_back(Block{section.offset, section.offset, {}, {}});
+        }
+        auto& block = blocks->back();
+        block.end   = std::max(block.end, section.offset + section.length);
+        block.sections.emplace_back(std::move(section));
+    }
+    for (auto& block : *blocks) {
+        auto done = block.done.get_future().share();
+        for (auto& section : block.sections) {
+            section.request->prefetched_ = done;
+        }
+    }
+
+    auto next               = std::make_shared<std::atomic<size_t>>(0);
+    const size_t nb_threads = std::min(defaults::read_threads(), blocks->size());
+    for (size_t t = 0; t < nb_threads; ++t) {
+        io_tasks_.emplace_back(std::async(std::launch::async, [blocks, next, path = path_]() {
+            TraceSuspend suspend;
+            std::unique_ptr<PositionalFile> file;
+            for (size_t b = (*next)++; b < blocks->size(); b = (*next)++) {
+                auto& block = (*blocks)[b];
+                try {
+                    if (not file) {
+                        file.reset(new PositionalFile(path));
+                    }
+                    auto buffer = std::make_shared<eckit::Buffer>(size_t(block.end - block.begin));
+                    file->read(buffer->data(), buffer->size(), block.begin);
+                    for (auto& section : block.sections) {
+                        auto& item = *section.item;
+                        item.metadata(section.metadata);
+                        item.data(data_section_view(static_cast<const char*>(buffer->data()) +
+                                                        (section.offset - block.begin),
+                                                    section.length, buffer));
+                    }
+                    block.done.set_value();
+                }
+                catch (...) {
+                    block.done.set_exception(std::current_exception());
+                }
+            }
+        }));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 void RecordReader::wait() {
-    // This can be optimized perhaps to overlap IO with decoding in multithreaded environment
+    prefetch();
+
+    std::vector<ReadRequest*> prefetched;
     for (auto& pair : requests_) {
         auto& request = pair.second;
-        request.wait();
+        if (request.prefetched_.valid()) {
+            prefetched.emplace_back(&request);
+        }
+        else {
+            request.wait();
+        }
     }
+
+    // Overlap I/O with decoding: requests are completed concurrently, each waiting only for its own data
+    parallel_for(prefetched.size(), defaults::threads(), [&](size_t i) { prefetched[i]->wait(); });
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -79,6 +265,10 @@ void RecordReader::checksum(bool b) {
     do_checksum_ = b;
 }
 
+void RecordReader::mmap(bool b) {
+    do_mmap_ = b;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 
 }  // namespace io
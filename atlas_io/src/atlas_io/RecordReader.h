@@ -11,8 +11,10 @@
 #pragma once
 
 #include <cstdint>
+#include <future>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "atlas_io/Metadata.h"
 #include "atlas_io/ReadRequest.h"
@@ -45,11 +47,26 @@ public:
         if (do_checksum_ >= 0) {
             requests_.at(key).checksum(do_checksum_);
         }
+        if (do_mmap_ >= 0) {
+            requests_.at(key).mmap(do_mmap_);
+        }
         return requests_.at(key);
     }
 
+    /// @brief Start reading the data of all queued requests in the background, and return immediately
+    ///
+    /// Data sections of the requested items are sorted by file offset, and adjacent sections are coalesced into
+    /// large sequential reads, which are issued concurrently by a pool of I/O threads (see "atlas.io.read.threads"
+    /// and "atlas.io.read.block_size"). Requests are then completed with wait() or wait(key).
+    /// Only file based records are prefetched; other requests are read when waited for.
+    void prefetch();
+
     void wait(const std::string& key);
 
+    /// @brief Complete all requests
+    ///
+    /// All queued requests are prefetched first. Prefetched requests are then checksummed, decompressed and
+    /// decoded concurrently, as soon as their data has been read.
     void wait();
 
     ReadRequest& request(const std::string& key);
@@ -58,6 +75,17 @@ public:
 
     void checksum(bool);
 
+    /// @brief Read uncompressed native-endian data through a memory mapping of the file, instead of copying it
+    ///
+    /// Values read into an ArrayReference are then views into the mapped file, without any copy.
+    /// - Lifetime: each view keeps the mapping alive, also after this RecordReader is destroyed. The mapping is
+    ///   released with the last view referencing it.
+    /// - Mutability: each item has its own private (copy-on-write) mapping of its data. Views may be written to,
+    ///   e.g. when wrapped in an atlas::Field; the written pages are then copied for that view only, so that other
+    ///   reads of the same item, also within a Session, are not affected. The file is never modified.
+    /// - The file must not be truncated or rewritten in place while views exist.
+    void mmap(bool);
+
 private:
     Record::URI uri() const;
 
@@ -76,6 +104,9 @@ private:
     std::uint64_t offset_;
 
     int do_checksum_{-1};
+    int do_mmap_{-1};
+
+    std::vector<std::future<void>> io_tasks_;  // destroyed first, waiting for background reads to finish
 };
 
 //---------------------------------------------------------------------------------------------------------------------
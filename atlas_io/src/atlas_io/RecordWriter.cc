@@ -10,13 +10,16 @@
 
 #include "atlas_io/RecordWriter.h"
 
+#include <algorithm>
 
 #include "atlas_io/Exceptions.h"
 #include "atlas_io/RecordWriter.h"
 #include "atlas_io/Trace.h"
+#include "atlas_io/detail/Assert.h"
 #include "atlas_io/detail/Checksum.h"
 #include "atlas_io/detail/Defaults.h"
 #include "atlas_io/detail/Encoder.h"
+#include "atlas_io/detail/Parallel.h"
 #include "atlas_io/detail/RecordSections.h"
 
 namespace atlas {
@@ -43,6 +46,22 @@ inline void write_string(OStream& out, const std::string& s) {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+/// Number of padding bytes to insert at given position, relative to the record begin, so that a section
+/// of given offset begins at a multiple of RecordDataSection::alignment
+inline size_t padding(size_t position, size_t offset = 0) {
+    constexpr size_t alignment = RecordDataSection::alignment;
+    return (alignment - (position + offset) % alignment) % alignment;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// Chunk size with which data of given uncompressed size is compressed, or 0 if it is compressed as a whole
+inline size_t compression_chunk_size(const DataInfo& info, size_t size) {
+    return (info.compression() != "none" && size > info.chunk_size()) ? info.chunk_size() : 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 size_t RecordWriter::write(Stream out) const {
     ATLAS_IO_TRACE("RecordWriter::write");
     RecordHead r;
@@ -84,32 +103,74 @@ size_t RecordWriter::write(Stream out) const {
 
     // Data sections
     // -------------
+    // Items are encoded, compressed and checksummed concurrently, in batches limited by the write buffer size.
+    // Small items are processed one per thread, large items in chunks by all threads.
+    // Each batch is then written in order, so that the record layout does not depend on the number of threads.
     ATLAS_IO_TRACE_SCOPE("data sections") {
-        size_t i{0};
+        std::vector<const Key*> keys;
+        std::vector<size_t> sizes;
+        keys.reserve(static_cast<size_t>(nb_data_sections_));
+        sizes.reserve(static_cast<size_t>(nb_data_sections_));
         for (auto& key : keys_) {
-            auto& encoder = encoders_.at(key);
-            auto& info    = info_.at(key);
-            if (info.section() == 0) {
-                continue;
+            if (info_.at(key).section()) {
+                atlas::io::Metadata m;
+                keys.emplace_back(&key);
+                sizes.emplace_back(encode_metadata(encoders_.at(key), m));
+            }
+        }
+
+        const size_t buffer_size = defaults::write_buffer_size();
+        for (size_t batch_begin = 0, batch_end = 0; batch_begin < keys.size(); batch_begin = batch_end) {
+            size_t batch_bytes = sizes[batch_end++];
+            while (batch_end < keys.size() && batch_bytes + sizes[batch_end] <= buffer_size) {
+                batch_bytes += sizes[batch_end++];
             }
-            atlas::io::Data data;
-            encode_data(encoder, data);
-            data.compress(info.compression());
-            auto& data_section  = index[i];
-            data_section.offset = position();
-            atlas::io::write_struct(out, RecordDataSection::Begin());
-            if (data.write(out) != data.size()) {
-                throw WriteError("Could not write data for item " + key + " to stream");
+            const size_t batch = batch_end - batch_begin;
+
+            std::vector<atlas::io::Data> data(batch);
+            std::vector<std::string> checksums(batch, "none:");
+            parallel_for(batch, nb_threads_, [&](size_t b) {
+                const size_t i = batch_begin + b;
+                auto& info     = info_.at(*keys[i]);
+                encode_data(encoders_.at(*keys[i]), data[b]);
+                if (compression_chunk_size(info, sizes[i]) == 0) {
+                    data[b].compress(info.compression());
+                    if (do_checksum_) {
+                        checksums[b] = data[b].checksum();
+                    }
+                }
+            });
+            for (size_t b = 0; b < batch; ++b) {
+                const size_t i = batch_begin + b;
+                auto& info     = info_.at(*keys[i]);
+                if (size_t chunk_size = compression_chunk_size(info, sizes[i])) {
+                    data[b].compress(info.compression(), chunk_size, nb_threads_);
+                    if (do_checksum_) {
+                        checksums[b] = data[b].checksum();
+                    }
+                }
+            }
+
+            for (size_t b = 0; b < batch; ++b) {
+                const size_t i      = batch_begin + b;
+                atlas::io::write_string(out, std::string(padding(position(), sizeof(RecordDataSection::Begin)), ' '));
+                auto& data_section  = index[i];
+                data_section.offset = position();
+                atlas::io::write_struct(out, RecordDataSection::Begin());
+                if (data[b].write(out) != data[b].size()) {
+                    throw WriteError("Could not write data for item " + *keys[i] + " to stream");
+                }
+                atlas::io::write_struct(out, RecordDataSection::End());
+                data_section.length   = position() - data_section.offset;
+                data_section.checksum = checksums[b];
+                data[b].clear();
             }
-            atlas::io::write_struct(out, RecordDataSection::End());
-            data_section.length   = position() - data_section.offset;
-            data_section.checksum = do_checksum_ ? data.checksum() : std::string("none:");
-            ++i;
         }
     }
 
     // End Record
     // ----------
+    atlas::io::write_string(out, std::string(padding(position(), sizeof(RecordEnd)), ' '));
     atlas::io::write_struct(out, RecordEnd());
     auto end_of_record = out.position();
 
@@ -157,6 +218,19 @@ void RecordWriter::checksum(bool on) {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+void RecordWriter::compression_chunk_size(size_t chunk_size) {
+    ATLAS_IO_ASSERT(chunk_size > 0);
+    chunk_size_ = chunk_size;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void RecordWriter::threads(size_t nb_threads) {
+    nb_threads_ = std::max<size_t>(1, nb_threads);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 void RecordWriter::set(const RecordWriter::Key& key, Link&& link, const eckit::Configuration&) {
     keys_.emplace_back(key);
     encoders_[key] = std::move(Encoder{link});
@@ -170,6 +244,7 @@ void RecordWriter::set(const RecordWriter::Key& key, Encoder&& encoder, const ec
     if (encoder.encodes_data()) {
         ++nb_data_sections_;
         info.compression(config.getString("compression", compression_));
+        info.chunk_size(config.getUnsigned("compression_chunk_size", chunk_size_));
         info.section(nb_data_sections_);
     }
     keys_.emplace_back(key);
@@ -204,25 +279,35 @@ size_t RecordWriter::estimateMaximumSize() const {
     size += size_t(nb_data_sections_) * sizeof(RecordDataIndexSection::Entry);
     size += sizeof(RecordDataIndexSection::End);
 
+    // Padding is exact for uncompressed data, and its maximum otherwise
+    bool exact = true;
     for (auto& key : keys_) {
         auto& encoder = encoders_.at(key);
         auto& info    = info_.at(key);
         if (info.section() == 0) {
             continue;
         }
+        size += exact ? padding(size, sizeof(RecordDataSection::Begin)) : RecordDataSection::alignment - 1;
         size += sizeof(RecordDataSection::Begin);
         {
             atlas::io::Metadata m;
             size_t max_data_size = encode_metadata(encoder, m);
             if (info.compression() != "none") {
+                size_t chunk_size = compression_chunk_size(info, max_data_size);
+                if (chunk_size) {
+                    // table of chunk sizes
+                    max_data_size += 8 * ((max_data_size + chunk_size - 1) / chunk_size + 1);
+                }
                 max_data_size = size_t(1.2 * max_data_size);
                 max_data_size = std::max<size_t>(max_data_size, 10 * 1024);  // minimum 10KB
+                exact         = false;
             }
             size += max_data_size;
         }
         size += sizeof(RecordDataSection::End);
     }
 
+    size += exact ? padding(size, sizeof(RecordEnd)) : RecordDataSection::alignment - 1;
     size += sizeof(RecordEnd);
 
     return size;
@@ -236,11 +321,14 @@ std::string RecordWriter::metadata() const {
         auto& encoder = encoders_.at(key);
         auto& info    = info_.at(key);
         atlas::io::Metadata m;
-        encode_metadata(encoder, m);
+        size_t size = encode_metadata(encoder, m);
         if (info.section()) {
             m.set("data.section", info.section());
             if (info.compression() != "none") {
                 m.set("data.compression.type", info.compression());
+                if (size_t chunk_size = compression_chunk_size(info, size)) {
+                    m.set("data.compression.chunk_size", chunk_size);
+                }
             }
         }
         metadata.set(key, m);
@@ -59,6 +59,14 @@ public:
     /// @brief Set checksum off or to default
     void checksum(bool);
 
+    /// @brief Set size in bytes of independently compressed chunks of large data items
+    void compression_chunk_size(size_t);
+
+    /// @brief Set number of threads used to encode, compress and checksum data items
+    ///
+    /// The written record does not depend on the number of threads.
+    void threads(size_t);
+
     // -- set( Key, Value ) where Value can be a variety of things
 
     /// @brief Add link to other record item (RecordItem::URI)
@@ -127,6 +135,8 @@ private:
     std::string compression_{defaults::compression_algorithm()};
     int do_checksum_{defaults::checksum_write()};
     int nb_data_sections_{0};
+    size_t chunk_size_{defaults::compression_chunk_size()};
+    size_t nb_threads_{defaults::threads()};
 
     std::string metadata() const;
 };
@@ -15,7 +15,26 @@
 namespace atlas {
 namespace io {
 
+namespace {
+thread_local bool trace_suspended{false};
+}
+
+TraceSuspend::TraceSuspend(): previous_(trace_suspended) {
+    trace_suspended = true;
+}
+
+TraceSuspend::~TraceSuspend() {
+    trace_suspended = previous_;
+}
+
+bool TraceSuspend::active() {
+    return trace_suspended;
+}
+
 atlas::io::Trace::Trace(const eckit::CodeLocation& loc) {
+    if (trace_suspended) {
+        return;
+    }
     for (size_t id = 0; id < TraceHookRegistry::size(); ++id) {
         if (TraceHookRegistry::enabled(id)) {
             hooks_.emplace_back(TraceHookRegistry::hook(id)(loc, loc.func()));
@@ -24,6 +43,9 @@ atlas::io::Trace::Trace(const eckit::CodeLocation& loc) {
 }
 
 Trace::Trace(const eckit::CodeLocation& loc, const std::string& title) {
+    if (trace_suspended) {
+        return;
+    }
     for (size_t id = 0; id < TraceHookRegistry::size(); ++id) {
         if (TraceHookRegistry::enabled(id)) {
             hooks_.emplace_back(TraceHookRegistry::hook(id)(loc, title));
@@ -32,6 +54,9 @@ Trace::Trace(const eckit::CodeLocation& loc, const std::string& title) {
 }
 
 Trace::Trace(const eckit::CodeLocation& loc, const std::string& title, const Labels& labels) {
+    if (trace_suspended) {
+        return;
+    }
     for (size_t id = 0; id < TraceHookRegistry::size(); ++id) {
         if (TraceHookRegistry::enabled(id)) {
             hooks_.emplace_back(TraceHookRegistry::hook(id)(loc, title));
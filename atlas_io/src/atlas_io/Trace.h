@@ -58,6 +58,17 @@ private:
     TraceHookRegistry() = default;
 };
 
+/// Trace hooks are not required to be thread-safe. While an instance is alive, traces in the current thread
+/// are not passed to the hooks, e.g. for the duration of a region executed concurrently by multiple threads.
+struct TraceSuspend {
+    TraceSuspend();
+    ~TraceSuspend();
+    static bool active();
+
+private:
+    bool previous_;
+};
+
 struct Trace {
     using Labels = std::vector<std::string>;
     Trace(const eckit::CodeLocation& loc);
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
 
 #include "eckit/config/Resource.h"
@@ -39,6 +41,47 @@ namespace defaults {
     return compression;
 }
 
+/// Read uncompressed data of file based records through a memory mapping of the file instead of copying it
+[[maybe_unused]] static bool read_mmap() {
+    static bool mmap = eckit::Resource<bool>("atlas.io.read.mmap;$ATLAS_IO_READ_MMAP", false);
+    return mmap;
+}
+
+/// Number of threads used to encode, compress and checksum data, and to decompress data
+/// Threading is opt-in: with one MPI task per core, a thread team per task would oversubscribe the node.
+[[maybe_unused]] static size_t threads() {
+    static size_t threads = std::max<long>(1, eckit::Resource<long>("atlas.io.threads;$ATLAS_IO_THREADS", 1));
+    return threads;
+}
+
+/// Data larger than this size (in bytes) is compressed in independent chunks of this size
+[[maybe_unused]] static size_t compression_chunk_size() {
+    static size_t chunk_size = std::max<long>(
+        1, eckit::Resource<long>("atlas.io.compression.chunk_size;$ATLAS_IO_COMPRESSION_CHUNK_SIZE", 4 * 1024 * 1024));
+    return chunk_size;
+}
+
+/// Number of background threads issuing reads of prefetched data, see RecordReader::prefetch
+/// Like threads(), additional read threads are opt-in.
+[[maybe_unused]] static size_t read_threads() {
+    static size_t threads = std::max<long>(1, eckit::Resource<long>("atlas.io.read.threads;$ATLAS_IO_READ_THREADS", 1));
+    return threads;
+}
+
+/// Maximum size (in bytes) of a single read of adjacent data sections, see RecordReader::prefetch
+[[maybe_unused]] static size_t read_block_size() {
+    static size_t block_size = std::max<long>(
+        1, eckit::Resource<long>("atlas.io.read.block_size;$ATLAS_IO_READ_BLOCK_SIZE", 64 * 1024 * 1024));
+    return block_size;
+}
+
+/// Maximum amount of uncompressed data (in bytes) that the RecordWriter holds in memory at once
+[[maybe_unused]] static size_t write_buffer_size() {
+    static size_t buffer_size =
+        std::max<long>(1, eckit::Resource<long>("atlas.io.write.buffer_size;$ATLAS_IO_WRITE_BUFFER_SIZE",
+                                                256 * 1024 * 1024));
+    return buffer_size;
+}
 
 }  // namespace defaults
 }  // namespace io
@@ -0,0 +1,91 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "atlas_io/Exceptions.h"
+#include "atlas_io/Trace.h"
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+MappedFile::MappedFile(const std::string& path): path_(path) {
+    map(0, 0, true);
+}
+
+MappedFile::MappedFile(const std::string& path, size_t offset, size_t length): path_(path) {
+    map(offset, length, false);
+}
+
+void MappedFile::map(size_t offset, size_t length, bool whole_file) {
+    ATLAS_IO_TRACE("MappedFile(" + path_ + ")");
+    int fd = ::open(path_.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw Exception("Could not open " + path_ + ": " + std::strerror(errno), Here());
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        std::string error = std::strerror(errno);
+        ::close(fd);
+        throw Exception("Could not stat " + path_ + ": " + error, Here());
+    }
+    const size_t file_size = static_cast<size_t>(st.st_size);
+    if (whole_file) {
+        length = file_size;
+    }
+    if (offset + length > file_size) {
+        ::close(fd);
+        throw InvalidRecord("File " + path_ + " is smaller than expected");
+    }
+    offset_ = offset;
+    size_   = length;
+
+    // mmap requires the offset in the file to be a multiple of the page size
+    const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    map_offset_            = offset - offset % page_size;
+    map_size_              = offset + length - map_offset_;
+
+    if (map_size_ > 0) {
+        // Private (copy-on-write) mapping: pages are shared through the page cache until written to, and writes
+        // through views into the mapping modify a private copy of the page, never the file
+        map_ = ::mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(map_offset_));
+        if (map_ == MAP_FAILED) {
+            map_              = nullptr;
+            std::string error = std::strerror(errno);
+            ::close(fd);
+            throw Exception("Could not mmap " + path_ + ": " + error, Here());
+        }
+    }
+
+    // The mapping remains valid after closing the file descriptor
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (map_) {
+        ::munmap(map_, map_size_);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
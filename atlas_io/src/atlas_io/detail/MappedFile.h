@@ -0,0 +1,62 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// @brief Copy-on-write memory mapping of a file, or of a byte range of a file
+///
+/// The file is opened read-only. The mapped memory may be written to: written pages become private copies of
+/// this mapping, and the file itself is never modified. Separate mappings of the same file do not share written
+/// pages. The file must not be truncated while it is mapped.
+class MappedFile {
+public:
+    /// Map the entire file
+    explicit MappedFile(const std::string& path);
+
+    /// Map only the given byte range of the file, which must lie within the file
+    MappedFile(const std::string& path, size_t offset, size_t length);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Start of the mapped range
+    void* data() { return static_cast<char*>(map_) + (offset_ - map_offset_); }
+    const void* data() const { return static_cast<const char*>(map_) + (offset_ - map_offset_); }
+
+    /// Size of the mapped range
+    size_t size() const { return size_; }
+    const std::string& path() const { return path_; }
+
+private:
+    void map(size_t offset, size_t length, bool whole_file);
+
+private:
+    std::string path_;
+    void* map_{nullptr};
+    size_t map_size_{0};
+    size_t map_offset_{0};  ///< offset of the mapping in the file, aligned to the page size
+    size_t offset_{0};
+    size_t size_{0};
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
@@ -0,0 +1,87 @@
+/*
+ * (C) Copyright 2020 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "atlas_io/Trace.h"
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+namespace detail {
+inline thread_local bool in_parallel_for{false};
+}
+
+/// @brief Call f(i) for i in [0,n) using up to nb_threads threads, including the calling thread.
+///
+/// Iterations are handed out dynamically, so the order of execution is unspecified. The first exception
+/// thrown by any iteration is rethrown in the calling thread after all threads have finished.
+/// Traces within f are not recorded when multiple threads are used.
+/// Nested calls, from within f, are executed by a single thread.
+template <typename Function>
+void parallel_for(size_t n, size_t nb_threads, Function&& f) {
+    nb_threads = detail::in_parallel_for ? 1 : std::max<size_t>(1, std::min(nb_threads, n));
+    if (nb_threads == 1) {
+        for (size_t i = 0; i < n; ++i) {
+            f(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+
+    auto work = [&]() {
+        TraceSuspend suspend;
+        detail::in_parallel_for = true;
+        for (size_t i = next++; i < n; i = next++) {
+            try {
+                f(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(exception_mutex);
+                if (not exception) {
+                    exception = std::current_exception();
+                }
+                next = n;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nb_threads - 1);
+    for (size_t t = 1; t < nb_threads; ++t) {
+        threads.emplace_back(work);
+    }
+    work();
+    detail::in_parallel_for = false;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
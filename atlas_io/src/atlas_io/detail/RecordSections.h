@@ -132,6 +132,11 @@ struct RecordDataIndexSection {
 // ------------------------------------------------------------------------------------------------------------------------------------
 
 struct RecordDataSection {
+    /// Data is written starting at offsets, relative to the record begin, that are a multiple of this alignment.
+    /// Together with record lengths being a multiple of this alignment, data of uncompressed arrays in a memory
+    /// mapped file is then suitably aligned to be accessed in place.
+    static constexpr size_t alignment = 64;
+
     struct Begin {  // 32 bytes
         static constexpr size_t bytes = 32;
 
@@ -10,6 +10,8 @@
 
 #include "ArrayReference.h"
 
+#include <cstdint>
+
 #include "atlas_io/atlas_compat.h"
 #include "atlas_io/detail/Assert.h"
 
@@ -67,7 +69,8 @@ ArrayReference::ArrayReference(const void* data, ArrayMetadata::DataType datatyp
 
 //---------------------------------------------------------------------------------------------------------------------
 
-ArrayReference::ArrayReference(ArrayReference&& other): ArrayMetadata(std::move(other)), data_(other.data_) {
+ArrayReference::ArrayReference(ArrayReference&& other):
+    ArrayMetadata(std::move(other)), data_(other.data_), keep_alive_(std::move(other.keep_alive_)) {
     other.data_ = nullptr;
 }
 
@@ -75,12 +78,34 @@ ArrayReference::ArrayReference(ArrayReference&& other): ArrayMetadata(std::move(
 
 ArrayReference& ArrayReference::operator=(ArrayReference&& rhs) {
     ArrayMetadata::operator=(std::move(rhs));
-    data_     = rhs.data_;
-    rhs.data_ = nullptr;
+    data_       = rhs.data_;
+    keep_alive_ = std::move(rhs.keep_alive_);
+    rhs.data_   = nullptr;
     return *this;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 
+void decode(const atlas::io::Metadata& metadata, const atlas::io::Data& data, ArrayReference& out) {
+    ArrayMetadata array(metadata);
+    ATLAS_IO_ASSERT(data.size() == array.bytes());
+
+    const void* p = data.data();
+    std::shared_ptr<const void> keep_alive;
+    if (data.view() && reinterpret_cast<std::uintptr_t>(p) % array.datatype().size() == 0) {
+        keep_alive = data.keep_alive();
+    }
+    else {
+        auto copy = std::make_shared<Data>();
+        copy->assign(data);
+        p          = copy->data();
+        keep_alive = std::move(copy);
+    }
+    out             = ArrayReference(p, array.datatype(), array.shape());
+    out.keep_alive_ = std::move(keep_alive);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace io
 }  // namespace atlas
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "atlas_io/Data.h"
 #include "atlas_io/Metadata.h"
 #include "atlas_io/types/array/ArrayMetadata.h"
@@ -35,10 +37,14 @@ public:
 
     void* data() const { return data_; }
 
+    /// @brief Decode as a view into the data when it is a suitably aligned view itself, e.g. into a memory
+    /// mapped file (see RecordReader::mmap), or else into a copy of the data.
+    /// Either way the referenced memory remains valid for the lifetime of the ArrayReference.
     friend void decode(const atlas::io::Metadata&, const atlas::io::Data&, ArrayReference&);
 
 private:
     void* data_{nullptr};
+    std::shared_ptr<const void> keep_alive_;
 };
 
 //---------------------------------------------------------------------------------------------------------------------
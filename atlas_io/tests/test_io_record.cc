@@ -8,12 +8,19 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "eckit/io/MemoryHandle.h"
 
+#include "atlas_io/detail/RecordSections.h"
+
 #include "TestEnvironment.h"
 
 namespace atlas {
@@ -280,6 +287,51 @@ CASE("Write records in nested subdirectories") {
     }
 }
 
+//-----------------------------------------------------------------------------
+
+CASE("Write record to memory with chunked compression using multiple threads") {
+    const auto& data_write = globals::record3.data;
+
+    auto write = [&](size_t nb_threads, eckit::Buffer& memory) {
+        io::RecordWriter record;
+        record.threads(nb_threads);
+        record.compression_chunk_size(64 * 1024);
+        record.set("v1", io::ref(data_write.v1));
+        record.set("v2", io::ref(data_write.v2));
+        record.set("v3", io::ref(data_write.v3));
+
+        memory.resize(record.estimateMaximumSize());
+        eckit::MemoryHandle datahandle_out{memory};
+        datahandle_out.openForWrite(0);
+        auto record_length = record.write(datahandle_out);
+        datahandle_out.close();
+        return record_length;
+    };
+
+    eckit::Buffer memory1;
+    eckit::Buffer memory4;
+    auto length1 = write(1, memory1);
+    auto length4 = write(4, memory4);
+
+    // Record layout does not depend on number of threads; only the creation time in the record head may differ
+    EXPECT_EQ(length1, length4);
+    size_t offset = sizeof(io::RecordHead);
+    EXPECT(::memcmp(static_cast<const char*>(memory1.data()) + offset,
+                    static_cast<const char*>(memory4.data()) + offset, length1 - offset) == 0);
+
+    Arrays data_read;
+    eckit::MemoryHandle datahandle_in{memory4};
+    datahandle_in.openForRead();
+    io::RecordReader reader(datahandle_in);
+    reader.read("v1", data_read.v1);
+    reader.read("v2", data_read.v2);
+    reader.read("v3", data_read.v3);
+    reader.wait();
+    datahandle_in.close();
+
+    EXPECT(data_read == data_write);
+}
+
 //-----------------------------------------------------------------------------//
 //                                                                             //
 //                               Reading tests                                 //
@@ -359,6 +411,85 @@ CASE("Read records from different files") {
 
 //-----------------------------------------------------------------------------
 
+CASE("Read record with memory mapping") {
+    const auto& data_write = globals::record3.data;
+
+    io::RecordReader record("record3.atlas" + suffix());
+    record.mmap(true);
+
+    // Uncompressed data is referenced in place
+    io::ArrayReference v1;
+    record.read("v1", v1).wait();
+    EXPECT_EQ(v1.size(), data_write.v1.size());
+    EXPECT(reinterpret_cast<std::uintptr_t>(v1.data()) % io::RecordDataSection::alignment == 0);
+    EXPECT(::memcmp(v1.data(), data_write.v1.data(), v1.bytes()) == 0);
+
+    // Possibly compressed data is copied
+    io::ArrayReference v3;
+    record.read("v3", v3).wait();
+    EXPECT_EQ(v3.bytes(), data_write.v3.size() * sizeof(int));
+    EXPECT(::memcmp(v3.data(), data_write.v3.data(), v3.bytes()) == 0);
+
+    Arrays data_read;
+    io::RecordReader reader("record3.atlas" + suffix());
+    reader.mmap(true);
+    reader.read("v1", data_read.v1);
+    reader.read("v2", data_read.v2);
+    reader.read("v3", data_read.v3);
+    reader.wait();
+    EXPECT(data_read == data_write);
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Write to memory mapped data") {
+    const auto& data_write = globals::record3.data;
+
+    {
+        io::ArrayReference v1;
+        {
+            io::RecordReader record("record3.atlas" + suffix());
+            record.mmap(true);
+            record.read("v1", v1).wait();
+            EXPECT(::memcmp(v1.data(), data_write.v1.data(), v1.bytes()) == 0);
+        }
+
+        // The mapping is copy-on-write: the view can be modified, also after the reader is gone
+        auto* values = static_cast<double*>(v1.data());
+        for (size_t i = 0; i < v1.size(); ++i) {
+            values[i] = -values[i] - 1.;
+        }
+        EXPECT_EQ(values[0], -data_write.v1[0] - 1.);
+    }
+
+    // Views of the same item do not alias each other, also within a Session
+    {
+        io::Session session;
+        io::ArrayReference first, second;
+        io::RecordReader record("record3.atlas" + suffix());
+        record.mmap(true);
+        record.read("v1", first).wait();
+        io::RecordReader other("record3.atlas" + suffix());
+        other.mmap(true);
+        other.read("v1", second).wait();
+        EXPECT(first.data() != second.data());
+
+        static_cast<double*>(first.data())[0] = -data_write.v1[0] - 1.;
+        EXPECT_EQ(static_cast<const double*>(second.data())[0], data_write.v1[0]);
+    }
+
+    // The file is not modified
+    Arrays data_read;
+    io::RecordReader reader("record3.atlas" + suffix());
+    reader.read("v1", data_read.v1);
+    reader.read("v2", data_read.v2);
+    reader.read("v3", data_read.v3);
+    reader.wait();
+    EXPECT(data_read == data_write);
+}
+
+//-----------------------------------------------------------------------------
+
 CASE("Read multiple records from same file") {
     Arrays data1, data2;
     io::RecordReader record1(globals::records[0]);
@@ -444,6 +575,80 @@ CASE("Async read") {
 
 //-----------------------------------------------------------------------------
 
+CASE("Prefetched read") {
+    // Items of 2MB each: unrequested items leave gaps larger than the coalescing distance (1MB), so that
+    // requests are read in several blocks, while adjacent requested items are read in one block.
+    constexpr size_t nb_items = 6;
+    constexpr size_t size     = 256 * 1024;
+    auto key                  = [](size_t i) { return "v" + std::to_string(i); };
+
+    std::vector<std::vector<double>> written(nb_items, std::vector<double>(size));
+    for (size_t i = 0; i < nb_items; ++i) {
+        for (size_t j = 0; j < size; ++j) {
+            written[i][j] = double(i * size + j);
+        }
+    }
+    {
+        io::RecordWriter record;
+        for (size_t i = 0; i < nb_items; ++i) {
+            record.set(key(i), io::ref(written[i]), no_compression);
+        }
+        record.write("prefetch.atlas" + suffix());
+    }
+
+    const std::vector<size_t> requested{0, 1, 3, 5};
+    std::vector<std::vector<double>> values(nb_items);
+    io::RecordReader record("prefetch.atlas" + suffix());
+
+    // Request reads
+    for (auto i : requested) {
+        record.read(key(i), values[i]);
+    }
+    for (auto i : requested) {
+        EXPECT(not record.request(key(i)).ready());
+    }
+
+    // Read all requested data in the background, and poll without waiting
+    record.prefetch();
+    auto all_ready = [&]() {
+        return std::all_of(requested.begin(), requested.end(),
+                           [&](size_t i) { return record.request(key(i)).ready(); });
+    };
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (not all_ready() && std::chrono::steady_clock::now() < timeout) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT(all_ready());
+
+    // Nothing is decoded before waiting
+    for (auto i : requested) {
+        EXPECT(values[i].empty());
+    }
+
+    // Wait for a specific request
+    record.wait(key(3));
+    EXPECT(values[3] == written[3]);
+    EXPECT(values[5].empty());
+
+    // Decode remaining requests
+    record.wait();
+    for (auto i : requested) {
+        EXPECT(values[i] == written[i]);
+    }
+    EXPECT(values[2].empty());
+    EXPECT(values[4].empty());
+
+    // Requests that are never waited for do not outlive the data that is still being read into them
+    {
+        std::vector<double> abandoned;
+        io::RecordReader reader("prefetch.atlas" + suffix());
+        reader.read(key(0), abandoned);
+        reader.prefetch();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 CASE("Recursive Write/read records in nested subdirectories") {
     auto reference_path = eckit::PathName{"atlas_test_io_refpath"};
 
@@ -0,0 +1,42 @@
+### Optional CBLAS library, used for single precision dense matrix multiplication (sgemm)
+#   MKL is preferred when found (MKLROOT), otherwise a CBLAS implementation such as OpenBLAS.
+
+ecbuild_add_option( FEATURE CBLAS
+                    DEFAULT ON
+                    DESCRIPTION "Use CBLAS (MKL or e.g. OpenBLAS) for single precision dense matrix multiplication" )
+
+set( atlas_HAVE_MKL 0 )
+
+if( HAVE_CBLAS )
+    find_path( MKL_INCLUDE_DIR NAMES mkl_cblas.h
+               HINTS ${MKL_ROOT} ${MKL_DIR} ENV MKLROOT ENV MKL_ROOT
+               PATH_SUFFIXES include )
+    find_library( MKL_RT_LIBRARY NAMES mkl_rt
+                  HINTS ${MKL_ROOT} ${MKL_DIR} ENV MKLROOT ENV MKL_ROOT
+                  PATH_SUFFIXES lib lib64 lib/intel64 )
+    if( MKL_INCLUDE_DIR AND MKL_RT_LIBRARY )
+        set( CBLAS_INCLUDES ${MKL_INCLUDE_DIR} )
+        set( CBLAS_LIBRARIES ${MKL_RT_LIBRARY} )
+        set( atlas_HAVE_MKL 1 )
+    else()
+        find_path( CBLAS_INCLUDE_DIR NAMES cblas.h
+                   HINTS ${CBLAS_ROOT} ${OPENBLAS_ROOT} ENV CBLAS_ROOT ENV OPENBLAS_ROOT
+                   PATH_SUFFIXES include include/openblas )
+        find_library( CBLAS_LIBRARY NAMES openblas cblas
+                      HINTS ${CBLAS_ROOT} ${OPENBLAS_ROOT} ENV CBLAS_ROOT ENV OPENBLAS_ROOT
+                      PATH_SUFFIXES lib lib64 )
+        if( CBLAS_INCLUDE_DIR AND CBLAS_LIBRARY )
+            set( CBLAS_INCLUDES ${CBLAS_INCLUDE_DIR} )
+            set( CBLAS_LIBRARIES ${CBLAS_LIBRARY} )
+        else()
+            ecbuild_info( "CBLAS not found: single precision dense matrix multiplication uses a generic loop" )
+            set( HAVE_CBLAS 0 )
+            set( atlas_HAVE_CBLAS 0 )
+        endif()
+    endif()
+endif()
+
+if( NOT HAVE_CBLAS )
+    unset( CBLAS_LIBRARIES )
+    unset( CBLAS_INCLUDES )
+endif()
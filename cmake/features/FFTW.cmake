@@ -11,4 +11,16 @@ if( NOT HAVE_FFTW )
     unset( FFTW_INCLUDES )
 endif()
 
+### Optional single precision FFTW library, used by the single precision path of TransLocal
+
+if( HAVE_FFTW )
+    find_library( FFTW_SINGLE_LIBRARY NAMES fftw3f
+                  HINTS ${FFTW_ROOT} ${FFTW_DIR} ${FFTW_PATH} ENV FFTW_ROOT ENV FFTW_DIR ENV FFTW_PATH
+                  PATH_SUFFIXES lib lib64 )
+    if( FFTW_SINGLE_LIBRARY )
+        list( APPEND FFTW_LIBRARIES ${FFTW_SINGLE_LIBRARY} )
+        set( atlas_HAVE_FFTW_SINGLE 1 )
+    endif()
+endif()
+
 endif()
\ No newline at end of file
@@ -69,6 +69,9 @@ public:
 
     void haloExchange(const FieldSet&, bool on_device = false) const override;
     void haloExchange(const Field&, bool on_device = false) const override;
+
+    using FunctionSpaceImpl::haloExchangeBegin;
+    parallel::HaloExchangeHandle haloExchangeBegin(const FieldSet&, bool on_device = false) const override;
     const parallel::HaloExchange& halo_exchange() const;
 
     void gather(const FieldSet&, FieldSet&) const override;
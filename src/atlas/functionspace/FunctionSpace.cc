@@ -12,6 +12,7 @@
 #include "atlas/functionspace/FunctionSpace.h"
 #include "atlas/field/Field.h"
 #include "atlas/functionspace/detail/FunctionSpaceImpl.h"
+#include "atlas/parallel/HaloExchange.h"
 
 namespace atlas {
 
@@ -90,6 +91,18 @@ void FunctionSpace::haloExchange(const FieldSet& fields, bool on_device) const {
     get()->haloExchange(fields, on_device);
 }
 
+parallel::HaloExchangeHandle FunctionSpace::haloExchangeBegin(const FieldSet& fields, bool on_device) const {
+    return get()->haloExchangeBegin(fields, on_device);
+}
+
+parallel::HaloExchangeHandle FunctionSpace::haloExchangeBegin(const Field& field, bool on_device) const {
+    return get()->haloExchangeBegin(field, on_device);
+}
+
+void FunctionSpace::haloExchangeEnd(parallel::HaloExchangeHandle& handle) const {
+    get()->haloExchangeEnd(handle);
+}
+
 void FunctionSpace::adjointHaloExchange(const FieldSet& fields, bool on_device) const {
     get()->adjointHaloExchange(fields, on_device);
 }
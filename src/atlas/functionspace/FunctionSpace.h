@@ -28,6 +28,7 @@ class FunctionSpaceImpl;
 }
 namespace parallel {
 class GatherScatter;
+class HaloExchangeHandle;
 }  // namespace parallel
 
 namespace util {
@@ -64,6 +65,10 @@ public:
     void haloExchange(const FieldSet&, bool on_device = false) const;
     void haloExchange(const Field&, bool on_device = false) const;
 
+    parallel::HaloExchangeHandle haloExchangeBegin(const FieldSet&, bool on_device = false) const;
+    parallel::HaloExchangeHandle haloExchangeBegin(const Field&, bool on_device = false) const;
+    void haloExchangeEnd(parallel::HaloExchangeHandle&) const;
+
     void adjointHaloExchange(const FieldSet&, bool on_device = false) const;
     void adjointHaloExchange(const Field&, bool on_device = false) const;
 
@@ -344,26 +344,6 @@ Field NodeColumns::createField(const Field& other, const eckit::Configuration& c
 
 namespace {
 
-template <int RANK>
-void dispatch_haloExchange(Field& field, const parallel::HaloExchange& halo_exchange, bool on_device) {
-    if (field.datatype() == array::DataType::kind<int>()) {
-        halo_exchange.template execute<int, RANK>(field.array(), on_device);
-    }
-    else if (field.datatype() == array::DataType::kind<long>()) {
-        halo_exchange.template execute<long, RANK>(field.array(), on_device);
-    }
-    else if (field.datatype() == array::DataType::kind<float>()) {
-        halo_exchange.template execute<float, RANK>(field.array(), on_device);
-    }
-    else if (field.datatype() == array::DataType::kind<double>()) {
-        halo_exchange.template execute<double, RANK>(field.array(), on_device);
-    }
-    else {
-        throw_Exception("datatype not supported", Here());
-    }
-    field.set_dirty(false);
-}
-
 template <int RANK>
 void dispatch_adjointHaloExchange(Field& field, const parallel::HaloExchange& halo_exchange, bool on_device) {
     if (field.datatype() == array::DataType::kind<int>()) {
@@ -387,24 +367,14 @@ void dispatch_adjointHaloExchange(Field& field, const parallel::HaloExchange& ha
 }  // namespace
 
 void NodeColumns::haloExchange(const FieldSet& fieldset, bool on_device) const {
+    std::vector<array::Array*> arrays;
+    arrays.reserve(fieldset.size());
     for (idx_t f = 0; f < fieldset.size(); ++f) {
-        Field& field = const_cast<FieldSet&>(fieldset)[f];
-        switch (field.rank()) {
-            case 1:
-                dispatch_haloExchange<1>(field, halo_exchange(), on_device);
-                break;
-            case 2:
-                dispatch_haloExchange<2>(field, halo_exchange(), on_device);
-                break;
-            case 3:
-                dispatch_haloExchange<3>(field, halo_exchange(), on_device);
-                break;
-            case 4:
-                dispatch_haloExchange<4>(field, halo_exchange(), on_device);
-                break;
-            default:
-                throw_Exception("Rank not supported", Here());
-        }
+        arrays.emplace_back(&const_cast<FieldSet&>(fieldset)[f].array());
+    }
+    halo_exchange().execute(arrays, on_device);
+    for (idx_t f = 0; f < fieldset.size(); ++f) {
+        const_cast<FieldSet&>(fieldset)[f].set_dirty(false);
     }
 }
 
@@ -430,6 +400,21 @@ void NodeColumns::adjointHaloExchange(const FieldSet& fieldset, bool on_device)
     }
 }
 
+parallel::HaloExchangeHandle NodeColumns::haloExchangeBegin(const FieldSet& fieldset, bool on_device) const {
+    std::vector<array::Array*> arrays;
+    arrays.reserve(fieldset.size());
+    for (idx_t f = 0; f < fieldset.size(); ++f) {
+        arrays.emplace_back(&const_cast<FieldSet&>(fieldset)[f].array());
+    }
+    auto handle = halo_exchange().exchange_begin(arrays, on_device);
+    handle.on_completion([fieldset]() {
+        for (idx_t f = 0; f < fieldset.size(); ++f) {
+            const_cast<FieldSet&>(fieldset)[f].set_dirty(false);
+        }
+    });
+    return handle;
+}
+
 void NodeColumns::haloExchange(const Field& field, bool on_device) const {
     FieldSet fieldset;
     fieldset.add(field);
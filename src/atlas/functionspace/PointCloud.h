@@ -74,6 +74,9 @@ public:
     void haloExchange(const FieldSet&, bool on_device = false) const override;
     void haloExchange(const Field&, bool on_device = false) const override;
 
+    using FunctionSpaceImpl::haloExchangeBegin;
+    parallel::HaloExchangeHandle haloExchangeBegin(const FieldSet&, bool on_device = false) const override;
+
     void adjointHaloExchange(const FieldSet&, bool on_device = false) const override;
     void adjointHaloExchange(const Field&, bool on_device = false) const override;
 
@@ -10,7 +10,9 @@
 
 #include "FunctionSpaceImpl.h"
 #include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
 #include "atlas/option/Options.h"
+#include "atlas/parallel/HaloExchange.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/util/Metadata.h"
 #include "atlas/parallel/mpi/mpi.h"
@@ -38,6 +40,21 @@ void FunctionSpaceImpl::haloExchange(const Field&, bool) const {
     ATLAS_NOTIMPLEMENTED;
 }
 
+parallel::HaloExchangeHandle FunctionSpaceImpl::haloExchangeBegin(const FieldSet& fieldset, bool on_device) const {
+    haloExchange(fieldset, on_device);
+    return parallel::HaloExchangeHandle();
+}
+
+parallel::HaloExchangeHandle FunctionSpaceImpl::haloExchangeBegin(const Field& field, bool on_device) const {
+    FieldSet fieldset;
+    fieldset.add(field);
+    return haloExchangeBegin(fieldset, on_device);
+}
+
+void FunctionSpaceImpl::haloExchangeEnd(parallel::HaloExchangeHandle& handle) const {
+    handle.wait();
+}
+
 void FunctionSpaceImpl::adjointHaloExchange(const FieldSet&, bool) const {
     ATLAS_NOTIMPLEMENTED;
 }
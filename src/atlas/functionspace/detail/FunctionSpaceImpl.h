@@ -33,6 +33,7 @@ class PartitionPolygons;
 }  // namespace util
 namespace parallel {
 class GatherScatter;
+class HaloExchangeHandle;
 }  // namespace parallel
 
 }  // namespace atlas
@@ -79,6 +80,15 @@ public:
     virtual void haloExchange(const FieldSet&, bool /*on_device*/ = false) const;
     virtual void haloExchange(const Field&, bool /* on_device*/ = false) const;
 
+    /// @brief Start a halo exchange without waiting for its completion
+    /// Work that does not depend on halo values can be done before calling haloExchangeEnd().
+    /// The default implementation performs a blocking haloExchange().
+    virtual parallel::HaloExchangeHandle haloExchangeBegin(const FieldSet&, bool /*on_device*/ = false) const;
+    parallel::HaloExchangeHandle haloExchangeBegin(const Field&, bool /*on_device*/ = false) const;
+
+    /// @brief Complete a halo exchange started with haloExchangeBegin()
+    void haloExchangeEnd(parallel::HaloExchangeHandle&) const;
+
     virtual void adjointHaloExchange(const FieldSet&, bool /*on_device*/ = false) const;
     virtual void adjointHaloExchange(const Field&, bool /* on_device*/ = false) const;
 
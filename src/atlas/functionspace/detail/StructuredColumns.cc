@@ -796,22 +796,18 @@ struct FixupHaloForVectors<3> {
 
 
 template <int RANK>
-void dispatch_haloExchange(Field& field, const parallel::HaloExchange& halo_exchange, const StructuredColumns& fs) {
+void dispatch_fixupHalo(Field& field, const StructuredColumns& fs) {
     FixupHaloForVectors<RANK> fixup_halos(fs);
     if (field.datatype() == array::DataType::kind<int>()) {
-        halo_exchange.template execute<int, RANK>(field.array(), false);
         fixup_halos.template apply<int>(field);
     }
     else if (field.datatype() == array::DataType::kind<long>()) {
-        halo_exchange.template execute<long, RANK>(field.array(), false);
         fixup_halos.template apply<long>(field);
     }
     else if (field.datatype() == array::DataType::kind<float>()) {
-        halo_exchange.template execute<float, RANK>(field.array(), false);
         fixup_halos.template apply<float>(field);
     }
     else if (field.datatype() == array::DataType::kind<double>()) {
-        halo_exchange.template execute<double, RANK>(field.array(), false);
         fixup_halos.template apply<double>(field);
     }
     else {
@@ -848,27 +844,50 @@ void dispatch_adjointHaloExchange(Field& field, const parallel::HaloExchange& ha
 }
 }  // namespace
 
-void StructuredColumns::haloExchange(const FieldSet& fieldset, bool) const {
+namespace {
+void fixup_halos(const FieldSet& fieldset, const StructuredColumns& fs) {
     for (idx_t f = 0; f < fieldset.size(); ++f) {
         Field& field = const_cast<FieldSet&>(fieldset)[f];
         switch (field.rank()) {
             case 1:
-                dispatch_haloExchange<1>(field, halo_exchange(), *this);
+                dispatch_fixupHalo<1>(field, fs);
                 break;
             case 2:
-                dispatch_haloExchange<2>(field, halo_exchange(), *this);
+                dispatch_fixupHalo<2>(field, fs);
                 break;
             case 3:
-                dispatch_haloExchange<3>(field, halo_exchange(), *this);
+                dispatch_fixupHalo<3>(field, fs);
                 break;
             case 4:
-                dispatch_haloExchange<4>(field, halo_exchange(), *this);
+                dispatch_fixupHalo<4>(field, fs);
                 break;
             default:
                 throw_Exception("Rank not supported", Here());
         }
     }
 }
+}  // namespace
+
+void StructuredColumns::haloExchange(const FieldSet& fieldset, bool) const {
+    std::vector<array::Array*> arrays;
+    arrays.reserve(fieldset.size());
+    for (idx_t f = 0; f < fieldset.size(); ++f) {
+        arrays.emplace_back(&const_cast<FieldSet&>(fieldset)[f].array());
+    }
+    halo_exchange().execute(arrays, false);
+    fixup_halos(fieldset, *this);
+}
+
+parallel::HaloExchangeHandle StructuredColumns::haloExchangeBegin(const FieldSet& fieldset, bool) const {
+    std::vector<array::Array*> arrays;
+    arrays.reserve(fieldset.size());
+    for (idx_t f = 0; f < fieldset.size(); ++f) {
+        arrays.emplace_back(&const_cast<FieldSet&>(fieldset)[f].array());
+    }
+    auto handle = halo_exchange().exchange_begin(arrays, false);
+    handle.on_completion([fieldset, this]() { fixup_halos(fieldset, *this); });
+    return handle;
+}
 
 void StructuredColumns::adjointHaloExchange(const FieldSet& fieldset, bool) const {
     for (idx_t f = 0; f < fieldset.size(); ++f) {
@@ -71,6 +71,20 @@ private:
 };
 
 
+class MatrixCacheEntryCompact : public MatrixCacheEntry {
+public:
+    MatrixCacheEntryCompact(CompactMatrix&& matrix, const std::string& uid):
+        MatrixCacheEntry(&shape_, &compact_matrix_, uid),
+        shape_(matrix.rows(), matrix.cols(), std::vector<eckit::linalg::Triplet>{}) {
+        const_cast<CompactMatrix&>(compact_matrix_).swap(matrix);
+    }
+
+private:
+    const Matrix shape_;
+    const CompactMatrix compact_matrix_;
+};
+
+
 MatrixCache::MatrixCache(const Cache& c):
     Cache(c, MatrixCacheEntry::static_type()),
     matrix_{dynamic_cast<const MatrixCacheEntry*>(c.get(MatrixCacheEntry::static_type()))} {}
@@ -82,10 +96,13 @@ MatrixCache::MatrixCache(std::shared_ptr<const Matrix> m, const std::string& uid
 
 MatrixCache::MatrixCache(const Matrix* m): MatrixCache(std::make_shared<MatrixCacheEntry>(m)) {}
 
+MatrixCache::MatrixCache(CompactMatrix&& m, const std::string& uid):
+    MatrixCache(std::make_shared<MatrixCacheEntryCompact>(std::move(m), uid)) {}
+
 MatrixCache::MatrixCache(const Interpolation& interpolation): MatrixCache(Cache(interpolation)) {}
 
 MatrixCache::operator bool() const {
-    return matrix_ && !matrix().empty();
+    return matrix_ && bool(*matrix_);
 }
 
 const MatrixCache::Matrix& MatrixCache::matrix() const {
@@ -93,6 +110,15 @@ const MatrixCache::Matrix& MatrixCache::matrix() const {
     return matrix_->matrix();
 }
 
+bool MatrixCache::compact() const {
+    return matrix_ && matrix_->compact_matrix();
+}
+
+const MatrixCache::CompactMatrix& MatrixCache::compact_matrix() const {
+    ATLAS_ASSERT(compact());
+    return *matrix_->compact_matrix();
+}
+
 const std::string& MatrixCache::uid() const {
     ATLAS_ASSERT(matrix_);
     return matrix_->uid();
@@ -19,6 +19,7 @@
 
 #include "eckit/linalg/SparseMatrix.h"
 
+#include "atlas/linalg/sparse/CompactSparseMatrix.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/util/KDTree.h"
 
@@ -82,20 +83,31 @@ private:
 
 class MatrixCacheEntry : public InterpolationCacheEntry {
 public:
-    using Matrix = eckit::linalg::SparseMatrix;
+    using Matrix        = eckit::linalg::SparseMatrix;
+    using CompactMatrix = linalg::CompactSparseMatrix;
     ~MatrixCacheEntry() override;
     MatrixCacheEntry(const Matrix* matrix, const std::string& uid = ""): matrix_{matrix}, uid_(uid) {
         ATLAS_ASSERT(matrix_ != nullptr);
     }
+    /// For a compact entry, matrix() only carries the shape of the compact matrix, without non-zeros
+    MatrixCacheEntry(const Matrix* shape, const CompactMatrix* compact_matrix, const std::string& uid = ""):
+        matrix_{shape}, compact_matrix_{compact_matrix}, uid_(uid) {
+        ATLAS_ASSERT(matrix_ != nullptr);
+        ATLAS_ASSERT(compact_matrix_ != nullptr);
+    }
     const Matrix& matrix() const { return *matrix_; }
+    const CompactMatrix* compact_matrix() const { return compact_matrix_; }
     const std::string& uid() const { return uid_; }
-    size_t footprint() const override { return matrix_->footprint(); }
-    operator bool() const { return not matrix_->empty(); }
+    size_t footprint() const override {
+        return matrix_->footprint() + (compact_matrix_ ? compact_matrix_->footprint() : 0);
+    }
+    operator bool() const { return compact_matrix_ ? not compact_matrix_->empty() : not matrix_->empty(); }
     static std::string static_type() { return "Matrix"; }
     std::string type() const override { return static_type(); }
 
 private:
     const Matrix* matrix_;
+    const CompactMatrix* compact_matrix_{nullptr};
     const std::string uid_;
 };
 
@@ -103,7 +115,8 @@ private:
 
 class MatrixCache final : public Cache {
 public:
-    using Matrix = MatrixCacheEntry::Matrix;
+    using Matrix        = MatrixCacheEntry::Matrix;
+    using CompactMatrix = MatrixCacheEntry::CompactMatrix;
 
 public:
     MatrixCache() = default;
@@ -111,9 +124,12 @@ public:
     MatrixCache(Matrix&& m);
     MatrixCache(std::shared_ptr<const Matrix> m, const std::string& uid = "");
     MatrixCache(const Matrix* m);
+    MatrixCache(CompactMatrix&& m, const std::string& uid = "");
     MatrixCache(const Interpolation&);
     operator bool() const;
     const Matrix& matrix() const;
+    bool compact() const;
+    const CompactMatrix& compact_matrix() const;
     const std::string& uid() const;
     size_t footprint() const;
 
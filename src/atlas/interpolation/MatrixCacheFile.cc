@@ -0,0 +1,253 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/interpolation/MatrixCacheFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <unistd.h>
+
+#include "eckit/config/Resource.h"
+#include "eckit/utils/MD5.h"
+
+#include "atlas/grid/Grid.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+#include "atlas_io/detail/MappedFile.h"
+
+namespace atlas {
+namespace interpolation {
+
+namespace {
+
+using CompactMatrix = linalg::CompactSparseMatrix;
+
+constexpr char magic[8]          = {'A', 'T', 'L', 'A', 'S', 'M', 'C', '\0'};
+constexpr std::uint32_t version  = 2;
+constexpr std::uint64_t alignment = 64;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t index_size;
+    std::uint32_t scalar_size;
+    std::uint32_t key_size;
+    std::uint64_t rows;
+    std::uint64_t cols;
+    std::uint64_t nnz;
+    std::uint64_t outer_offset;
+    std::uint64_t inner_offset;
+    std::uint64_t data_offset;
+    std::uint64_t file_size;
+    char key[64];
+    std::uint64_t checksum;  // of all preceding header bytes
+};
+
+// FNV-1a hash of the header, excluding the checksum itself
+std::uint64_t header_checksum(const Header& header) {
+    const auto* bytes  = reinterpret_cast<const unsigned char*>(&header);
+    std::uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < offsetof(Header, checksum); ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::uint64_t align(std::uint64_t offset) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+Header make_header(const CompactMatrix& matrix, const std::string& key) {
+    if (key.size() > sizeof(Header::key)) {
+        throw_Exception("MatrixCacheFile: key \"" + key + "\" is too long", Here());
+    }
+    Header header;
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version      = version;
+    header.index_size   = sizeof(CompactMatrix::Index);
+    header.scalar_size  = sizeof(CompactMatrix::Scalar);
+    header.key_size     = static_cast<std::uint32_t>(key.size());
+    header.rows         = matrix.rows();
+    header.cols         = matrix.cols();
+    header.nnz          = matrix.nonZeros();
+    header.outer_offset = align(sizeof(Header));
+    header.inner_offset = align(header.outer_offset + (header.rows + 1) * header.index_size);
+    header.data_offset  = align(header.inner_offset + header.nnz * header.index_size);
+    header.file_size    = header.data_offset + header.nnz * header.scalar_size;
+    std::memcpy(header.key, key.data(), key.size());
+    header.checksum = header_checksum(header);
+    return header;
+}
+
+// Largest rounding error of the single precision weights, relative to the largest absolute weight
+double relative_weight_error(const MatrixCache::Matrix& matrix, const CompactMatrix& compact) {
+    double max_weight = 0.;
+    for (size_t i = 0; i < matrix.nonZeros(); ++i) {
+        max_weight = std::max(max_weight, std::abs(matrix.data()[i]));
+    }
+    return max_weight > 0. ? compact.max_weight_error() / max_weight : 0.;
+}
+
+// Check the CSR structure, so that a corrupt file cannot lead to out of bounds access. This touches every page of
+// the index arrays, so it is only done on request (see MatrixCacheFile::read)
+bool valid_csr(const Header& header, const CompactMatrix::Index* outer, const CompactMatrix::Index* inner) {
+    if (outer[0] != 0 || static_cast<std::uint64_t>(outer[header.rows]) != header.nnz) {
+        return false;
+    }
+    for (std::uint64_t r = 0; r < header.rows; ++r) {
+        if (outer[r] > outer[r + 1]) {
+            return false;
+        }
+    }
+    for (std::uint64_t i = 0; i < header.nnz; ++i) {
+        if (inner[i] < 0 || static_cast<std::uint64_t>(inner[i]) >= header.cols) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void write_at(std::ofstream& out, std::uint64_t offset, const void* data, std::uint64_t size) {
+    static const char padding[alignment] = {};
+    const auto position                  = static_cast<std::uint64_t>(out.tellp());
+    ATLAS_ASSERT(position <= offset);
+    out.write(padding, static_cast<std::streamsize>(offset - position));
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+}  // namespace
+
+std::string MatrixCacheFile::key(const Grid& source, const Grid& target, const util::Config& config, int part,
+                                 int nb_parts) {
+    eckit::MD5 hash;
+    hash.add(source.uid());
+    hash.add(target.uid());
+    hash.add(config.json(eckit::JSON::Formatting::compact()));
+    hash.add(part);
+    hash.add(nb_parts);
+    return hash.digest();
+}
+
+void MatrixCacheFile::write(const eckit::PathName& path, const MatrixCache& cache, const std::string& key,
+                            double tolerance) {
+    ATLAS_TRACE("MatrixCacheFile::write");
+    ATLAS_ASSERT(cache);
+
+    std::unique_ptr<CompactMatrix> converted;
+    if (not cache.compact()) {
+        converted.reset(new CompactMatrix(cache.matrix()));
+        const double error = relative_weight_error(cache.matrix(), *converted);
+        if (not(error <= tolerance)) {
+            throw_Exception("MatrixCacheFile: relative weight rounding error " + std::to_string(error) +
+                                " of single precision conversion exceeds tolerance " + std::to_string(tolerance),
+                            Here());
+        }
+    }
+    const CompactMatrix& matrix = converted ? *converted : cache.compact_matrix();
+
+    const Header header = make_header(matrix, key);
+
+    const std::string tmp = path.asString() + ".tmp." + std::to_string(::getpid());
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (not out) {
+            throw_Exception("MatrixCacheFile: could not open " + tmp + " for writing", Here());
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        write_at(out, header.outer_offset, matrix.outer(), (header.rows + 1) * header.index_size);
+        write_at(out, header.inner_offset, matrix.inner(), header.nnz * header.index_size);
+        write_at(out, header.data_offset, matrix.data(), header.nnz * header.scalar_size);
+        out.close();
+        if (not out) {
+            std::remove(tmp.c_str());
+            throw_Exception("MatrixCacheFile: could not write " + tmp, Here());
+        }
+    }
+    if (std::rename(tmp.c_str(), path.asString().c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw_Exception("MatrixCacheFile: could not rename " + tmp + " to " + path.asString(), Here());
+    }
+    Log::debug() << "MatrixCacheFile: written " << path << std::endl;
+}
+
+MatrixCache MatrixCacheFile::read(const eckit::PathName& path, const std::string& key) {
+    static bool validate_structure = eckit::Resource<bool>("$ATLAS_DEBUG_MATRIX_CACHE_FILE", false);
+    return read(path, key, validate_structure);
+}
+
+MatrixCache MatrixCacheFile::read(const eckit::PathName& path, const std::string& key, bool validate_structure) {
+    ATLAS_TRACE("MatrixCacheFile::read");
+    auto file = std::make_shared<io::MappedFile>(path.asString());
+
+    auto invalid = [&](const std::string& reason) {
+        throw_Exception("MatrixCacheFile: " + path.asString() + " is not a valid matrix cache file: " + reason,
+                        Here());
+    };
+
+    if (file->size() < sizeof(Header)) {
+        invalid("file too small");
+    }
+    Header header;
+    std::memcpy(&header, file->data(), sizeof(Header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+        invalid("wrong magic");
+    }
+    if (header.version != version) {
+        invalid("unsupported version " + std::to_string(header.version));
+    }
+    if (header.checksum != header_checksum(header)) {
+        invalid("header checksum mismatch");
+    }
+    if (header.index_size != sizeof(CompactMatrix::Index) || header.scalar_size != sizeof(CompactMatrix::Scalar)) {
+        invalid("unsupported index or weight size");
+    }
+    if (header.file_size != file->size() ||
+        header.data_offset + header.nnz * header.scalar_size > file->size() ||
+        header.outer_offset + (header.rows + 1) * header.index_size > header.inner_offset ||
+        header.inner_offset + header.nnz * header.index_size > header.data_offset ||
+        header.key_size > sizeof(Header::key)) {
+        invalid("inconsistent header");
+    }
+    const std::string file_key(header.key, header.key_size);
+    if (not key.empty() && key != file_key) {
+        throw_Exception("MatrixCacheFile: key of " + path.asString() + " does not match requested key", Here());
+    }
+
+    const auto* base  = static_cast<const char*>(file->data());
+    const auto* outer = reinterpret_cast<const CompactMatrix::Index*>(base + header.outer_offset);
+    const auto* inner = reinterpret_cast<const CompactMatrix::Index*>(base + header.inner_offset);
+    const auto* data  = reinterpret_cast<const CompactMatrix::Scalar*>(base + header.data_offset);
+
+    const auto max_index = static_cast<std::uint64_t>(std::numeric_limits<CompactMatrix::Index>::max());
+    if (header.rows > max_index || header.cols > max_index || header.nnz > max_index) {
+        invalid("dimensions exceed the range of 32-bit indices");
+    }
+    if (validate_structure && not valid_csr(header, outer, inner)) {
+        invalid("corrupt sparse matrix structure");
+    }
+
+    Log::debug() << "MatrixCacheFile: mapped " << path << std::endl;
+    return MatrixCache(CompactMatrix(header.rows, header.cols, header.nnz, outer, inner, data, file), file_key);
+}
+
+}  // namespace interpolation
+}  // namespace atlas
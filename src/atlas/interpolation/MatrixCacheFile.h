@@ -0,0 +1,64 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "eckit/filesystem/PathName.h"
+
+#include "atlas/interpolation/Cache.h"
+
+namespace atlas {
+class Grid;
+namespace util {
+class Config;
+}
+}  // namespace atlas
+
+namespace atlas {
+namespace interpolation {
+
+//-----------------------------------------------------------------------------
+
+/// @brief Persistent interpolation matrix cache, shareable between processes
+///
+/// A file holds one matrix in CompactSparseMatrix format (32-bit indices, single precision weights),
+/// as 64-byte aligned arrays following a small header. It is written once, e.g. by one process per node,
+/// and opened by every process through a memory mapping. The sparse backends use the mapped arrays in place,
+/// and the physical pages are shared by all processes through the page cache.
+class MatrixCacheFile {
+public:
+    /// @brief Key identifying a matrix by source and target grid, interpolation configuration and partition
+    static std::string key(const Grid& source, const Grid& target, const util::Config& config, int part = 0,
+                           int nb_parts = 1);
+
+    /// @brief Write the matrix of the cache to a file
+    /// The file is written under a temporary name and then renamed, so readers never see partial files.
+    /// A double precision matrix is converted to CompactSparseMatrix format. The conversion throws if the
+    /// largest weight rounding error, relative to the largest absolute weight, exceeds tolerance.
+    static void write(const eckit::PathName&, const MatrixCache&, const std::string& key = "",
+                      double tolerance = 1.e-6);
+
+    /// @brief Open a file written with write(), without copying the matrix
+    /// If key is not empty, it must match the key the file was written with.
+    /// The header is validated against its checksum and the file size, which throws for a truncated file or a
+    /// corrupt header. The sparse matrix structure is only validated with ATLAS_DEBUG_MATRIX_CACHE_FILE=1, as
+    /// this reads all index arrays.
+    static MatrixCache read(const eckit::PathName&, const std::string& key = "");
+
+    /// @brief Open a file written with write(), validating the sparse matrix structure if validate_structure
+    static MatrixCache read(const eckit::PathName&, const std::string& key, bool validate_structure);
+};
+
+//-----------------------------------------------------------------------------
+
+}  // namespace interpolation
+}  // namespace atlas
@@ -9,6 +9,7 @@
  */
 
 #include <memory>
+#include <sstream>
 
 #include "atlas/interpolation/method/Method.h"
 
@@ -95,6 +96,21 @@ void set_missing_values(Field& tgt, const std::vector<idx_t>& missing) {
     }
 }
 
+// Whether the backend supports fields with levels. The eckit_linalg backends only support rank-1 fields.
+bool supports_multilevel(const std::string& linalg_backend) {
+    sparse::Backend backend{linalg_backend};
+    return backend.type() == sparse::backend::openmp::type() ||
+           backend.type() == sparse::backend::openmp_blocked::type();
+}
+
+// Backend for fields with levels
+sparse::Backend multilevel_backend(const std::string& linalg_backend) {
+    if (supports_multilevel(linalg_backend)) {
+        return sparse::Backend{linalg_backend};
+    }
+    return sparse::backend::openmp();
+}
+
 }  // anonymous namespace
 
 
@@ -117,7 +133,6 @@ void Method::interpolate_field_rank1(const Field& src, Field& tgt, const Matrix&
 
 template <typename Value>
 void Method::interpolate_field_rank2(const Field& src, Field& tgt, const Matrix& W) const {
-    sparse::Backend backend{linalg_backend_};
     auto src_v = array::make_view<Value, 2>(src);
     auto tgt_v = array::make_view<Value, 2>(tgt);
 
@@ -150,20 +165,19 @@ void Method::interpolate_field_rank2(const Field& src, Field& tgt, const Matrix&
         }
     }
     else {
-        sparse_matrix_multiply(W, src_v, tgt_v, sparse::backend::openmp());
+        sparse_matrix_multiply(W, src_v, tgt_v, multilevel_backend(linalg_backend_));
     }
 }
 
 
 template <typename Value>
 void Method::interpolate_field_rank3(const Field& src, Field& tgt, const Matrix& W) const {
-    sparse::Backend backend{linalg_backend_};
     auto src_v = array::make_view<Value, 3>(src);
     auto tgt_v = array::make_view<Value, 3>(tgt);
     if (not W.empty() && nonLinear_(src)) {
         ATLAS_ASSERT(false, "nonLinear interpolation not supported for rank-3 fields.");
     }
-    sparse_matrix_multiply(W, src_v, tgt_v, sparse::backend::openmp());
+    sparse_matrix_multiply(W, src_v, tgt_v, multilevel_backend(linalg_backend_));
 }
 
 template <typename Value>
@@ -240,6 +254,17 @@ void Method::check_compatibility(const Field& src, const Field& tgt, const Matri
     ATLAS_ASSERT(src.shape(0) >= static_cast<idx_t>(W.cols()));
 }
 
+void Method::check_compatibility(const Field& src, const Field& tgt, const CompactMatrix& W) const {
+    ATLAS_ASSERT(src.datatype() == tgt.datatype());
+    ATLAS_ASSERT(src.rank() == tgt.rank());
+    ATLAS_ASSERT(src.levels() == tgt.levels());
+    ATLAS_ASSERT(src.variables() == tgt.variables());
+
+    ATLAS_ASSERT(!W.empty());
+    ATLAS_ASSERT(tgt.shape(0) >= static_cast<idx_t>(W.rows()));
+    ATLAS_ASSERT(src.shape(0) >= static_cast<idx_t>(W.cols()));
+}
+
 template <typename Value>
 void Method::interpolate_field(const Field& src, Field& tgt, const Matrix& W) const {
     // do nothing if there are no observations to interpolate (W will be NULL
@@ -263,6 +288,54 @@ void Method::interpolate_field(const Field& src, Field& tgt, const Matrix& W) co
     }
 }
 
+template <typename Value>
+void Method::interpolate_field_compact(const Field& src, Field& tgt, const CompactMatrix& W) const {
+    if (tgt.shape(0) == 0) {
+        return;
+    }
+    check_compatibility(src, tgt, W);
+
+    auto backend = multilevel_backend(linalg_backend_);
+    if (src.rank() == 1) {
+        auto src_v = array::make_view<Value, 1>(src);
+        auto tgt_v = array::make_view<Value, 1>(tgt);
+        sparse_matrix_multiply(W, src_v, tgt_v, backend);
+    }
+    else if (src.rank() == 2) {
+        auto src_v = array::make_view<Value, 2>(src);
+        auto tgt_v = array::make_view<Value, 2>(tgt);
+        sparse_matrix_multiply(W, src_v, tgt_v, backend);
+    }
+    else if (src.rank() == 3) {
+        auto src_v = array::make_view<Value, 3>(src);
+        auto tgt_v = array::make_view<Value, 3>(tgt);
+        sparse_matrix_multiply(W, src_v, tgt_v, backend);
+    }
+    else {
+        ATLAS_NOTIMPLEMENTED;
+    }
+}
+
+template <typename Value, typename WeightMatrix>
+void Method::interpolate_fields(const std::vector<Field>& src, std::vector<Field>& tgt, const WeightMatrix& W) const {
+    ATLAS_TRACE("atlas::interpolation::method::Method::interpolate_fields()");
+
+    // Contiguous fields are treated as rank-2, with all values of a point adjacent in memory.
+    // The backend applies each row of the matrix to all fields at once, reading and writing each field in place.
+    std::vector<View<const Value, 2>> src_v;
+    std::vector<View<Value, 2>> tgt_v;
+    src_v.reserve(src.size());
+    tgt_v.reserve(tgt.size());
+    for (size_t f = 0; f < src.size(); ++f) {
+        const idx_t size = src[f].rank() == 1 ? 1 : src[f].stride(0);
+        ATLAS_ASSERT(size == (tgt[f].rank() == 1 ? 1 : tgt[f].stride(0)));
+        src_v.emplace_back(src[f].array().host_data<Value>(), array::make_shape(src[f].shape(0), size));
+        tgt_v.emplace_back(tgt[f].array().host_data<Value>(), array::make_shape(tgt[f].shape(0), size));
+    }
+
+    sparse_matrix_multiply_fields(W, src_v, tgt_v, multilevel_backend(linalg_backend_));
+}
+
 template <typename Value>
 void Method::adjoint_interpolate_field(Field& src, const Field& tgt, const Matrix& W) const {
     // do nothing if there are no observations to interpolate (W will be NULL
@@ -295,11 +368,49 @@ Method::Method(const Method::Config& config) {
     }
 
     config.get("adjoint", adjoint_);
+
+    // Store the matrix with 32-bit indices and single precision weights
+    config.get("compact_matrix", compact_);
+    config.get("compact_matrix_tolerance", compact_tolerance_);
+}
+
+void Method::compact_matrix() {
+    if (compact_matrix_ != nullptr) {
+        // e.g. a compact matrix read from a MatrixCacheFile
+        if (adjoint_) {
+            throw_NotImplemented("Compact matrix storage is not supported for adjoint interpolation", Here());
+        }
+        if (nonLinear_) {
+            throw_NotImplemented("Compact matrix storage is not supported for non-linear interpolation", Here());
+        }
+        return;
+    }
+    if (not compact_ || matrix_ == nullptr || matrix_->empty()) {
+        return;
+    }
+    if (adjoint_) {
+        throw_NotImplemented("Compact matrix storage is not supported for adjoint interpolation", Here());
+    }
+    if (nonLinear_) {
+        throw_NotImplemented("Compact matrix storage is not supported for non-linear interpolation", Here());
+    }
+    ATLAS_TRACE("atlas::interpolation::method::Method::compact_matrix()");
+
+    CompactMatrix compact(*matrix_);
+    if (compact.max_weight_error() > compact_tolerance_) {
+        std::stringstream msg;
+        msg << "Compact matrix storage: weight rounding error " << compact.max_weight_error()
+            << " exceeds \"compact_matrix_tolerance\" " << compact_tolerance_;
+        throw_Exception(msg.str(), Here());
+    }
+    // The double precision matrix is released when it is not shared with another cache
+    setMatrix(interpolation::MatrixCache(std::move(compact), matrix_cache_.uid()));
 }
 
 void Method::setup(const FunctionSpace& source, const FunctionSpace& target) {
     ATLAS_TRACE("atlas::interpolation::method::Method::setup(FunctionSpace, FunctionSpace)");
     this->do_setup(source, target);
+    compact_matrix();
 
     if (adjoint_ && target.size() > 0) {
         Matrix tmp(*matrix_);
@@ -314,21 +425,25 @@ void Method::setup(const FunctionSpace& source, const FunctionSpace& target) {
 void Method::setup(const Grid& source, const Grid& target) {
     ATLAS_TRACE("atlas::interpolation::method::Method::setup(Grid, Grid)");
     this->do_setup(source, target, Cache());
+    compact_matrix();
 }
 
 void Method::setup(const FunctionSpace& source, const Field& target) {
     ATLAS_TRACE("atlas::interpolation::method::Method::setup(FunctionSpace, Field)");
     this->do_setup(source, target);
+    compact_matrix();
 }
 
 void Method::setup(const FunctionSpace& source, const FieldSet& target) {
     ATLAS_TRACE("atlas::interpolation::method::Method::setup(FunctionSpace, FieldSet)");
     this->do_setup(source, target);
+    compact_matrix();
 }
 
 void Method::setup(const Grid& source, const Grid& target, const Cache& cache) {
     ATLAS_TRACE("atlas::interpolation::method::Method::setup(Grid, Grid, Cache)");
     this->do_setup(source, target, cache);
+    compact_matrix();
 }
 
 Method::Metadata Method::execute(const FieldSet& source, FieldSet& target) const {
@@ -373,7 +488,78 @@ void Method::do_execute(const FieldSet& fieldsSource, FieldSet& fieldsTarget, Me
     const idx_t N = fieldsSource.size();
     ATLAS_ASSERT(N == fieldsTarget.size());
 
-    for (idx_t i = 0; i < fieldsSource.size(); ++i) {
+    // Fields that can share a single pass over the matrix, per data type. Remaining fields are
+    // interpolated one by one. Fields are only combined when the configured backend supports
+    // fields with levels, so that e.g. the eckit_linalg backend is still used for rank-1 fields.
+    std::vector<idx_t> fused_real64;
+    std::vector<idx_t> fused_real32;
+    std::vector<idx_t> unfused;
+    for (idx_t i = 0; i < N; ++i) {
+        const Field& src = fieldsSource[i];
+        const Field& tgt = fieldsTarget[i];
+        const bool fusable = (matrix_ || compact_matrix_) && supports_multilevel(linalg_backend_) && tgt.shape(0) > 0 &&
+                             not nonLinear_(src) && src.rank() <= 3 && src.contiguous() && tgt.contiguous();
+        if (fusable && src.datatype().kind() == array::DataType::KIND_REAL64) {
+            fused_real64.push_back(i);
+        }
+        else if (fusable && src.datatype().kind() == array::DataType::KIND_REAL32) {
+            fused_real32.push_back(i);
+        }
+        else {
+            unfused.push_back(i);
+        }
+    }
+    if (fused_real64.size() < 2) {
+        unfused.insert(unfused.end(), fused_real64.begin(), fused_real64.end());
+        fused_real64.clear();
+    }
+    if (fused_real32.size() < 2) {
+        unfused.insert(unfused.end(), fused_real32.begin(), fused_real32.end());
+        fused_real32.clear();
+    }
+
+    if (fused_real64.size() || fused_real32.size()) {
+        FieldSet exchange;
+        for (auto i : fused_real64) {
+            exchange.add(fieldsSource[i]);
+        }
+        for (auto i : fused_real32) {
+            exchange.add(fieldsSource[i]);
+        }
+        haloExchange(exchange);
+    }
+
+    auto interpolate_fused = [&](const std::vector<idx_t>& fused, auto value) {
+        using Value = decltype(value);
+        if (fused.empty()) {
+            return;
+        }
+        std::vector<Field> src;
+        std::vector<Field> tgt;
+        for (auto i : fused) {
+            src.emplace_back(fieldsSource[i]);
+            tgt.emplace_back(fieldsTarget[i]);
+        }
+        if (compact_matrix_) {
+            for (size_t f = 0; f < src.size(); ++f) {
+                check_compatibility(src[f], tgt[f], *compact_matrix_);
+            }
+            interpolate_fields<Value>(src, tgt, *compact_matrix_);
+        }
+        else {
+            for (size_t f = 0; f < src.size(); ++f) {
+                check_compatibility(src[f], tgt[f], *matrix_);
+            }
+            interpolate_fields<Value>(src, tgt, *matrix_);
+        }
+        for (size_t f = 0; f < src.size(); ++f) {
+            finalise_target(src[f], tgt[f]);
+        }
+    };
+    interpolate_fused(fused_real64, double{});
+    interpolate_fused(fused_real32, float{});
+
+    for (auto i : unfused) {
         Method::do_execute(fieldsSource[i], fieldsTarget[i], metadata);
     }
 }
@@ -383,7 +569,18 @@ void Method::do_execute(const Field& src, Field& tgt, Metadata&) const {
 
     haloExchange(src);
 
-    if( matrix_ ) { // (matrix == nullptr) when a partition is empty
+    if (compact_matrix_) {
+        if (src.datatype().kind() == array::DataType::KIND_REAL64) {
+            interpolate_field_compact<double>(src, tgt, *compact_matrix_);
+        }
+        else if (src.datatype().kind() == array::DataType::KIND_REAL32) {
+            interpolate_field_compact<float>(src, tgt, *compact_matrix_);
+        }
+        else {
+            ATLAS_NOTIMPLEMENTED;
+        }
+    }
+    else if( matrix_ ) { // (matrix == nullptr) when a partition is empty
         if (src.datatype().kind() == array::DataType::KIND_REAL64) {
             interpolate_field<double>(src, tgt, *matrix_);
         }
@@ -395,6 +592,10 @@ void Method::do_execute(const Field& src, Field& tgt, Metadata&) const {
         }
     }
 
+    finalise_target(src, tgt);
+}
+
+void Method::finalise_target(const Field& src, Field& tgt) const {
     // carry over missing value metadata
     if (not tgt.metadata().has("missing_value")) {
         field::MissingValue mv_src(src);
@@ -474,8 +675,18 @@ void Method::normalise(Triplets& triplets) {
 }
 
 void Method::haloExchange(const FieldSet& fields) const {
+    if (not allow_halo_exchange_) {
+        return;
+    }
+    // Exchange all dirty fields together
+    FieldSet dirty;
     for (auto& field : fields) {
-        haloExchange(field);
+        if (field.dirty()) {
+            dirty.add(field);
+        }
+    }
+    if (dirty.size()) {
+        source().haloExchange(dirty);
     }
 }
 void Method::haloExchange(const Field& field) const {
@@ -85,9 +85,10 @@ protected:
     virtual void do_execute_adjoint(FieldSet& source, const FieldSet& target, Metadata&) const;
     virtual void do_execute_adjoint(Field& source, const Field& target, Metadata&) const;
 
-    using Triplet  = eckit::linalg::Triplet;
-    using Triplets = std::vector<Triplet>;
-    using Matrix   = eckit::linalg::SparseMatrix;
+    using Triplet       = eckit::linalg::Triplet;
+    using Triplets      = std::vector<Triplet>;
+    using Matrix        = eckit::linalg::SparseMatrix;
+    using CompactMatrix = linalg::CompactSparseMatrix;
 
     static void normalise(Triplets& triplets);
 
@@ -107,14 +108,16 @@ protected:
             matrix_shared_ = std::make_shared<Matrix>();
         }
         matrix_shared_->swap(m);
-        matrix_cache_ = interpolation::MatrixCache(matrix_shared_, uid);
-        matrix_       = &matrix_cache_.matrix();
+        matrix_cache_   = interpolation::MatrixCache(matrix_shared_, uid);
+        matrix_         = &matrix_cache_.matrix();
+        compact_matrix_ = nullptr;
     }
 
     void setMatrix(interpolation::MatrixCache matrix_cache) {
         ATLAS_ASSERT(matrix_cache);
-        matrix_cache_ = matrix_cache;
-        matrix_       = &matrix_cache_.matrix();
+        matrix_cache_   = matrix_cache;
+        matrix_         = &matrix_cache_.matrix();
+        compact_matrix_ = matrix_cache_.compact() ? &matrix_cache_.compact_matrix() : nullptr;
         matrix_shared_.reset();
     }
 
@@ -122,17 +125,35 @@ protected:
 
     const Matrix& matrix() const { return *matrix_; }
 
+    /// Compact storage of the matrix if "compact_matrix" was requested, otherwise nullptr.
+    /// When set, matrix() only carries the shape and has no non-zeros.
+    const CompactMatrix* compactMatrix() const { return compact_matrix_; }
+
     virtual void do_setup(const FunctionSpace& source, const FunctionSpace& target) = 0;
     virtual void do_setup(const Grid& source, const Grid& target, const Cache&)     = 0;
     virtual void do_setup(const FunctionSpace& source, const Field& target);
     virtual void do_setup(const FunctionSpace& source, const FieldSet& target);
 
     void check_compatibility(const Field& src, const Field& tgt, const Matrix& W) const;
+    void check_compatibility(const Field& src, const Field& tgt, const CompactMatrix& W) const;
 
 private:
     template <typename Value>
     void interpolate_field(const Field& src, Field& tgt, const Matrix&) const;
 
+    template <typename Value>
+    void interpolate_field_compact(const Field& src, Field& tgt, const CompactMatrix&) const;
+
+    // Apply the matrix to several contiguous fields in a single pass over the matrix
+    template <typename Value, typename WeightMatrix>
+    void interpolate_fields(const std::vector<Field>& src, std::vector<Field>& tgt, const WeightMatrix&) const;
+
+    // Replace the matrix with a CompactMatrix when requested with "compact_matrix"
+    void compact_matrix();
+
+    // Set missing value metadata and missing values of an interpolated target field
+    void finalise_target(const Field& src, Field& tgt) const;
+
     template <typename Value>
     void interpolate_field_rank1(const Field& src, Field& tgt, const Matrix&) const;
 
@@ -155,12 +176,15 @@ private:
     void adjoint_interpolate_field_rank3(Field& src, const Field& tgt, const Matrix&) const;
 
 private:
-    const Matrix* matrix_ = nullptr;
+    const Matrix* matrix_                = nullptr;
+    const CompactMatrix* compact_matrix_ = nullptr;
     std::shared_ptr<Matrix> matrix_shared_;
     interpolation::MatrixCache matrix_cache_;
     NonLinear nonLinear_;
     std::string linalg_backend_;
     Matrix matrix_transpose_;
+    bool compact_{false};
+    double compact_tolerance_{1.e-6};
 
 protected:
     bool adjoint_{false};
@@ -38,6 +38,10 @@ Binning::Binning(const Config& config) : Method(config) {
   const auto* conf = dynamic_cast<const eckit::LocalConfiguration*>(&config);
   ATLAS_ASSERT(conf, "config must be derived from eckit::LocalConfiguration");
   interpAncillaryScheme_ = conf->getSubConfiguration("scheme");
+  // the ancillary matrix is transposed and weighted in do_setup, which
+  // requires its double precision non-zeros; "compact_matrix" applies only
+  // to the resulting binning matrix
+  interpAncillaryScheme_.set("compact_matrix", false);
   // enabling or disabling the adjoint operation
   adjoint_ = conf->getBool("adjoint", false);
   // enabling or disabling the halo exchange
@@ -31,7 +31,29 @@ namespace method {
 
 namespace {
 MethodBuilder<GridBoxMaximum> __builder("grid-box-maximum");
+
+// Only the sparsity pattern of the matrix is used, so double precision and compact matrices are treated alike
+template <typename SparseMatrix, typename SourceView, typename TargetView>
+void maximum_over_rows(const SparseMatrix& m, const SourceView& xarray, TargetView& yarray) {
+    const auto* outer = m.outer();
+    const auto* inner = m.inner();
+    for (size_t i = 0; i < m.rows(); ++i) {
+        ATLAS_ASSERT(outer[i] < outer[i + 1]);
+
+        size_t j   = 0;
+        double max = std::numeric_limits<double>::lowest();
+        for (auto k = outer[i]; k < outer[i + 1]; ++k) {
+            ATLAS_ASSERT(size_t(inner[k]) < size_t(xarray.shape(0)));
+            auto value = xarray[inner[k]];
+            if (max < value) {
+                max = value;
+                j   = size_t(inner[k]);
+            }
+        }
+        yarray[i] = xarray[j];
+    }
 }
+}  // namespace
 
 
 void GridBoxMaximum::do_execute(const FieldSet& source, FieldSet& target, Metadata& metadata) const {
@@ -60,25 +82,11 @@ void GridBoxMaximum::do_execute(const Field& source, Field& target, Metadata&) c
 
 
     if (!matrixFree_) {
-        const Matrix& m = matrix();
-        Matrix::const_iterator k(m);
-
-        for (decltype(m.rows()) i = 0, j = 0; i < m.rows(); ++i) {
-            double max = std::numeric_limits<double>::lowest();
-            bool found = false;
-
-            for (; k != m.end(i); ++k) {
-                ATLAS_ASSERT(k.col() < size_t(xarray.shape(0)));
-                auto value = xarray[k.col()];
-                if (max < value) {
-                    max = value;
-                    j   = k.col();
-                }
-                found = true;
-            }
-
-            ATLAS_ASSERT(found);
-            yarray[i] = xarray[j];
+        if (compactMatrix() != nullptr) {
+            maximum_over_rows(*compactMatrix(), xarray, yarray);
+        }
+        else {
+            maximum_over_rows(matrix(), xarray, yarray);
         }
         return;
     }
@@ -204,7 +204,7 @@ void GridBoxMethod::giveUp(const std::forward_list<size_t>& failures) {
 Cache GridBoxMethod::createCache() const {
     Cache cache;
     cache.add(interpolation::IndexKDTreeCache(pTree_));
-    if (not matrix().empty()) {
+    if (not matrix().empty() || compactMatrix() != nullptr) {
         cache.add(Method::createCache());
     }
     return cache;
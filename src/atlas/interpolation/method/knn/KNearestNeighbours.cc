@@ -10,7 +10,9 @@
 
 #include "atlas/interpolation/method/knn/KNearestNeighbours.h"
 
+#include <array>
 #include <limits>
+#include <vector>
 
 #include "eckit/log/Plural.h"
 #include "eckit/types/FloatCompare.h"
@@ -83,31 +85,28 @@ void KNearestNeighbours::do_setup(const FunctionSpace& source, const FunctionSpa
 
     // fill the sparse matrix
     std::vector<Triplet> weights_triplets;
-    weights_triplets.reserve(out_npts * k_);
     {
         Trace timer(Here(), "atlas::interpolation::method::KNearestNeighbour::do_setup()");
 
-        std::vector<double> weights;
-
         Log::debug() << "Computing interpolation weights for " << out_npts << " points." << std::endl;
-        for (size_t ip = 0; ip < out_npts; ++ip) {
-            if (ip && (ip % 1000 == 0)) {
-                timer.pause();
-                auto elapsed = timer.elapsed();
-                timer.resume();
-                auto rate = eckit::types::is_approximately_equal(elapsed, 0.) ? std::numeric_limits<double>::infinity()
-                                                                              : (ip / elapsed);
-                Log::debug() << eckit::BigNum(ip) << " (at " << size_t(rate) << " points/s)... after " << elapsed << " s" << std::endl;
-            }
-
+        auto point_weights = [&](size_t ip, const PointLonLat& p, Triplets& triplets) -> const char* {
             // find the closest input points to the output point
-            auto nn = pTree_.closestPoints(PointLonLat{lonlat(ip, size_t(LON)), lonlat(ip, size_t(LAT))}, k_);
+            auto nn = pTree_.closestPoints(p, k_);
 
             // calculate weights (individual and total, to normalise) using distance
             // squared
             const size_t npts = nn.size();
-            ATLAS_ASSERT(npts);
-            weights.resize(npts, 0);
+            if (npts == 0) {
+                return "no source point found";
+            }
+
+            std::array<double, 32> weights_fixed;
+            std::vector<double> weights_dynamic;
+            double* weights = weights_fixed.data();
+            if (npts > weights_fixed.size()) {
+                weights_dynamic.resize(npts);
+                weights = weights_dynamic.data();
+            }
 
             double sum = 0;
             for (size_t j = 0; j < npts; ++j) {
@@ -117,16 +116,28 @@ void KNearestNeighbours::do_setup(const FunctionSpace& source, const FunctionSpa
                 weights[j] = 1. / (1. + d2);
                 sum += weights[j];
             }
-            ATLAS_ASSERT(sum > 0);
+            if (not(sum > 0)) {
+                return "sum of weights is not positive";
+            }
 
             // insert weights into the matrix
             for (size_t j = 0; j < npts; ++j) {
                 size_t jp = nn[j].payload();
-                ATLAS_ASSERT(jp < inp_npts,
-                             "point found which is not covered within the halo of the source function space");
-                weights_triplets.emplace_back(ip, jp, weights[j] / sum);
+                if (jp >= inp_npts) {
+                    return "point found which is not covered within the halo of the source function space";
+                }
+                triplets.emplace_back(ip, jp, weights[j] / sum);
             }
-        }
+            return nullptr;
+        };
+        weights_triplets = computeTriplets(lonlat, point_weights);
+
+        timer.stop();
+        auto elapsed = timer.elapsed();
+        auto rate    = eckit::types::is_approximately_equal(elapsed, 0.) ? std::numeric_limits<double>::infinity()
+                                                                         : (out_npts / elapsed);
+        Log::debug() << eckit::BigNum(out_npts) << " points (at " << size_t(rate) << " points/s) after " << elapsed
+                     << " s" << std::endl;
     }
 
     // fill sparse matrix and return
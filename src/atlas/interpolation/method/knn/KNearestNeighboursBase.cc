@@ -8,6 +8,12 @@
  * nor does it submit to any jurisdiction. and Interpolation
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <sstream>
+
 #include "eckit/config/Resource.h"
 #include "eckit/log/TraceTimer.h"
 
@@ -20,6 +26,8 @@
 #include "atlas/library/Library.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildXYZField.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
 
@@ -27,6 +35,12 @@ namespace atlas {
 namespace interpolation {
 namespace method {
 
+KNearestNeighboursBase::KNearestNeighboursBase(const Config& config): Method(config) {
+    config.get("sort_queries", sort_queries_);
+    config.get("batch_size", batch_size_);
+    ATLAS_ASSERT(batch_size_ > 0);
+}
+
 void KNearestNeighboursBase::buildPointSearchTree(Mesh& meshSource, const mesh::Halo& _halo) {
     ATLAS_TRACE();
     eckit::TraceTimer<Atlas> tim("KNearestNeighboursBase::buildPointSearchTree()");
@@ -125,6 +139,117 @@ void KNearestNeighboursBase::buildPointSearchTree(const FunctionSpace& functions
     pTree_.build();
 }
 
+namespace {
+
+/// Interleave the bits of 32-bit quantised lon and lat into a Z-order (Morton) key
+std::uint64_t morton_key(double lon, double lat) {
+    auto spread = [](std::uint64_t x) {
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x << 2)) & 0x3333333333333333ull;
+        x = (x | (x << 1)) & 0x5555555555555555ull;
+        return x;
+    };
+    auto quantise = [](double x, double xmin, double xmax) {
+        constexpr double nb_keys = 4294967295.;
+        double r                 = (x - xmin) / (xmax - xmin);
+        r                        = std::min(std::max(r, 0.), 1.);
+        return static_cast<std::uint64_t>(r * nb_keys);
+    };
+    lon -= 360. * std::floor(lon / 360.);
+    return spread(quantise(lon, 0., 360.)) | (spread(quantise(lat, -90., 90.)) << 1);
+}
+
+}  // namespace
+
+Method::Triplets KNearestNeighboursBase::computeTriplets(const array::ArrayView<double, 2>& lonlat,
+                                                         const PointWeights& weights) const {
+    ATLAS_TRACE("KNearestNeighboursBase::computeTriplets");
+    const size_t out_npts = lonlat.shape(0);
+
+    std::vector<size_t> order;
+    if (sort_queries_) {
+        ATLAS_TRACE_SCOPE("sort queries") {
+            std::vector<std::uint64_t> keys(out_npts);
+            atlas_omp_parallel_for (size_t ip = 0; ip < out_npts; ++ip) {
+                keys[ip] = morton_key(lonlat(ip, LON), lonlat(ip, LAT));
+            }
+            order.resize(out_npts);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+        }
+    }
+
+    const size_t nb_batches = (out_npts + batch_size_ - 1) / batch_size_;
+    std::vector<Triplets> batches(nb_batches);
+
+    // exceptions must not escape the parallel region: record the failing point of each batch instead
+    std::vector<size_t> failed_point(nb_batches, out_npts);
+    std::vector<const char*> failure(nb_batches, nullptr);
+
+    ATLAS_TRACE_SCOPE("query batches") {
+        atlas_omp_parallel_for (size_t b = 0; b < nb_batches; ++b) {
+            const size_t begin = b * batch_size_;
+            const size_t end   = std::min(begin + batch_size_, out_npts);
+            Triplets& triplets = batches[b];
+            for (size_t i = begin; i < end; ++i) {
+                const size_t ip = sort_queries_ ? order[i] : i;
+                if (const char* error = weights(ip, PointLonLat{lonlat(ip, LON), lonlat(ip, LAT)}, triplets)) {
+                    failed_point[b] = ip;
+                    failure[b]      = error;
+                    break;
+                }
+            }
+        }
+    }
+
+    size_t failed_batch = nb_batches;
+    for (size_t b = 0; b < nb_batches; ++b) {
+        if (failure[b] != nullptr && (failed_batch == nb_batches || failed_point[b] < failed_point[failed_batch])) {
+            failed_batch = b;
+        }
+    }
+    if (failed_batch < nb_batches) {
+        const size_t ip = failed_point[failed_batch];
+        std::stringstream msg;
+        msg << failure[failed_batch] << " (target point " << ip << " at lonlat " << lonlat(ip, LON) << ", "
+            << lonlat(ip, LAT) << ")";
+        throw_Exception(msg.str(), Here());
+    }
+
+    Triplets triplets;
+    ATLAS_TRACE_SCOPE("merge batches") {
+        size_t nnz = 0;
+        for (const auto& batch : batches) {
+            nnz += batch.size();
+        }
+        triplets.reserve(nnz);
+        if (not sort_queries_) {
+            for (const auto& batch : batches) {
+                triplets.insert(triplets.end(), batch.begin(), batch.end());
+            }
+        }
+        else {
+            // counting sort on rows; the triplets of one row are contiguous within a single batch
+            std::vector<size_t> offset(out_npts + 1, 0);
+            for (const auto& batch : batches) {
+                for (const auto& t : batch) {
+                    ++offset[t.row() + 1];
+                }
+            }
+            std::partial_sum(offset.begin(), offset.end(), offset.begin());
+            triplets.resize(nnz);
+            for (const auto& batch : batches) {
+                for (const auto& t : batch) {
+                    triplets[offset[t.row()]++] = t;
+                }
+            }
+        }
+    }
+    return triplets;
+}
+
 bool KNearestNeighboursBase::extractTreeFromCache(const Cache& c) {
     IndexKDTreeCache cache(c);
     if (cache) {
@@ -10,8 +10,10 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
+#include "atlas/array/ArrayView.h"
 #include "atlas/interpolation/method/Method.h"
 #include "atlas/mesh/Halo.h"
 #include "atlas/mesh/Mesh.h"
@@ -23,16 +25,32 @@ namespace method {
 
 class KNearestNeighboursBase : public Method {
 public:
-    KNearestNeighboursBase(const Config& config): Method(config) {}
+    KNearestNeighboursBase(const Config& config);
     virtual ~KNearestNeighboursBase() override {}
 
 protected:
+    /// Appends the triplets of target point ip; returns nullptr on success, or a description of the failure
+    using PointWeights = std::function<const char*(size_t ip, const PointLonLat&, Triplets&)>;
+
     void buildPointSearchTree(Mesh& meshSource) { buildPointSearchTree(meshSource, mesh::Halo(meshSource)); }
     void buildPointSearchTree(Mesh& meshSource, const mesh::Halo&);
     void buildPointSearchTree(const FunctionSpace&);
     bool extractTreeFromCache(const Cache&);
 
+    /// @brief Compute the triplets of all target points in parallel
+    ///
+    /// Target points are queried in batches distributed over OpenMP threads, each batch appending
+    /// to its own triplets. The returned triplets are in row order, independent of the number of threads.
+    /// With "sort_queries", target points are visited along a Z-order (Morton) curve in (lon,lat),
+    /// so that consecutive tree searches traverse the same branches.
+    /// A failure is recorded per batch and thrown after the parallel region, for the lowest failing point.
+    Triplets computeTriplets(const array::ArrayView<double, 2>& lonlat, const PointWeights&) const;
+
     util::IndexKDTree pTree_;
+
+private:
+    bool sort_queries_{false};
+    size_t batch_size_{1024};
 };
 
 }  // namespace method
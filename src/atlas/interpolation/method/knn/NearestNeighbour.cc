@@ -77,28 +77,28 @@ void NearestNeighbour::do_setup(const FunctionSpace& source, const FunctionSpace
 
     // fill the sparse matrix
     std::vector<Triplet> weights_triplets;
-    weights_triplets.reserve(out_npts);
     {
         Trace timer(Here(), "atlas::interpolation::method::NearestNeighbour::do_setup()");
-        for (size_t ip = 0; ip < out_npts; ++ip) {
-            if (ip && (ip % 1000 == 0)) {
-                timer.pause();
-                auto elapsed = timer.elapsed();
-                timer.resume();
-                auto rate = eckit::types::is_approximately_equal(elapsed, 0.) ? std::numeric_limits<double>::infinity()
-                                                                              : (ip / elapsed);
-                Log::debug() << eckit::BigNum(ip) << " (at " << rate << " points/s)... after " << elapsed << " s" << std::endl;
-            }
-
+        auto point_weights = [&](size_t ip, const PointLonLat& p, Triplets& triplets) -> const char* {
             // find the closest input point to the output point
-            auto nn   = pTree_.closestPoint(PointLonLat{lonlat(ip, size_t(LON)), lonlat(ip, size_t(LAT))});
+            auto nn   = pTree_.closestPoint(p);
             size_t jp = nn.payload();
 
             // insert the weights into the interpolant matrix
-            ATLAS_ASSERT(jp < inp_npts,
-                         "point found which is not covered within the halo of the source function space");
-            weights_triplets.emplace_back(ip, jp, 1);
-        }
+            if (jp >= inp_npts) {
+                return "point found which is not covered within the halo of the source function space";
+            }
+            triplets.emplace_back(ip, jp, 1);
+            return nullptr;
+        };
+        weights_triplets = computeTriplets(lonlat, point_weights);
+
+        timer.stop();
+        auto elapsed = timer.elapsed();
+        auto rate    = eckit::types::is_approximately_equal(elapsed, 0.) ? std::numeric_limits<double>::infinity()
+                                                                         : (out_npts / elapsed);
+        Log::debug() << eckit::BigNum(out_npts) << " points (at " << rate << " points/s) after " << elapsed << " s"
+                     << std::endl;
     }
 
     // fill sparse matrix and return
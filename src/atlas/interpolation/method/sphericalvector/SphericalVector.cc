@@ -40,6 +40,9 @@ SphericalVector::SphericalVector(const Config& config) : Method(config) {
   const auto* conf = dynamic_cast<const eckit::LocalConfiguration*>(&config);
   ATLAS_ASSERT(conf, "config must be derived from eckit::LocalConfiguration");
   interpolationScheme_ = conf->getSubConfiguration("scheme");
+  // the complex weights are built from the double precision non-zeros of the
+  // scheme matrix in do_setup
+  interpolationScheme_.set("compact_matrix", false);
   adjoint_ = conf->getBool("adjoint", false);
 }
 
@@ -8,9 +8,12 @@
  * nor does it submit to any jurisdiction. and Interpolation
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <limits>
+#include <string>
+#include <vector>
 
 #include "FiniteElement.h"
 
@@ -33,12 +36,14 @@
 #include "atlas/parallel/GatherScatter.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/Earth.h"
 #include "atlas/util/Point.h"
+#include "atlas/util/Topology.h"
 
 
 namespace atlas {
@@ -52,6 +57,24 @@ MethodBuilder<FiniteElement> __builder("finite-element");
 // epsilon used to scale edge tolerance when projecting ray to intesect element
 static const double parametricEpsilon = 1e-15;
 
+// Number of nodes of an element, where a pentagon whose first and last point coincide degenerates to a quad
+idx_t element_nb_nodes(const mesh::MultiBlockConnectivity& connectivity, const array::ArrayView<double, 2>& xyz,
+                       idx_t elem_id) {
+    idx_t nb_cols = connectivity.cols(elem_id);
+    if (nb_cols == 5) {
+        // Check if pentagon degenerates to quad. Otherwise abort.
+        // For now only check if first and last point coincide.
+        auto i1    = connectivity(elem_id, 0);
+        auto iN    = connectivity(elem_id, nb_cols - 1);
+        auto first = PointXYZ{xyz(i1, XX), xyz(i1, YY), xyz(i1, ZZ)};
+        auto last  = PointXYZ{xyz(iN, XX), xyz(iN, YY), xyz(iN, ZZ)};
+        if (first == last) {
+            return 4;
+        }
+    }
+    return nb_cols;
+}
+
 }  // namespace
 
 
@@ -152,12 +175,24 @@ void FiniteElement::print(std::ostream& out) const {
     auto stencil_size_loc    = array::make_view<idx_t, 1>(field_stencil_size_loc);
     stencil_size_loc.assign(0);
 
-    for (auto it = matrix().begin(); it != matrix().end(); ++it) {
-        idx_t p                   = idx_t(it.row());
+    auto add_to_stencil = [&](idx_t p, idx_t col, double weight) {
         idx_t& i                  = stencil_size_loc(p);
-        stencil_points_loc(p, i)  = gidx_src(it.col());
-        stencil_weights_loc(p, i) = *it;
+        stencil_points_loc(p, i)  = gidx_src(col);
+        stencil_weights_loc(p, i) = weight;
         ++i;
+    };
+    if (const auto* compact = compactMatrix()) {
+        // matrix() only carries the shape; the weights are in the CSR arrays of the compact matrix
+        for (size_t r = 0; r < compact->rows(); ++r) {
+            for (auto j = compact->outer()[r]; j < compact->outer()[r + 1]; ++j) {
+                add_to_stencil(idx_t(r), idx_t(compact->inner()[j]), compact->data()[j]);
+            }
+        }
+    }
+    else {
+        for (auto it = matrix().begin(); it != matrix().end(); ++it) {
+            add_to_stencil(idx_t(it.row()), idx_t(it.col()), *it);
+        }
     }
 
     gidx_t global_size = tgt.gather().glb_dof();
@@ -240,11 +275,6 @@ void FiniteElement::setup(const FunctionSpace& source) {
 
     idx_t Nelements = meshSource.cells().size();
 
-    // weights -- one per vertex of element, triangles (3) or quads (4)
-
-    Triplets weights_triplets;               // structure to fill-in sparse matrix
-    weights_triplets.reserve(out_npts * 4);  // preallocate space as if all elements where quads
-
     // search nearest k cell centres
 
     const idx_t maxNbElemsToTry = std::max<idx_t>(8, idx_t(Nelements * max_fraction_elems_to_try_));
@@ -257,60 +287,153 @@ void FiniteElement::setup(const FunctionSpace& source) {
         Log::debug() << "k-d tree: search radius = " << search_radius/1000. << " km" << std::endl;
     }
 
-    std::vector<size_t> failures;
-
-    ATLAS_TRACE_SCOPE("Computing interpolation matrix") {
-        eckit::ProgressTimer progress("Computing interpolation weights", out_npts, "point", double(5), Log::debug());
-        for (idx_t ip = 0; ip < out_npts; ++ip, ++progress) {
-            if (out_ghosts(ip)) {
+    // Validate the elements that can be found in the k-d tree up front, as exceptions must not escape
+    // the parallel region below. Invalid elements are skipped by the projection; they are only an error
+    // when a target point cannot be located in any other element.
+    enum InvalidElement : char
+    {
+        VALID = 0,
+        NODE_OUT_OF_RANGE,
+        UNSUPPORTED_SHAPE
+    };
+    ATLAS_TRACE_SCOPE("Validating source elements") {
+        const auto flags = array::make_view<int, 1>(meshSource.cells().flags());
+        invalid_elements_.assign(Nelements, VALID);
+        for (idx_t e = 0; e < Nelements; ++e) {
+            if (util::Topology::view(flags(e)).check(util::Topology::INVALID)) {
                 continue;
             }
+            for (idx_t n = 0; n < connectivity_->cols(e); ++n) {
+                if ((*connectivity_)(e, n) >= inp_npts) {
+                    invalid_elements_[e] = NODE_OUT_OF_RANGE;
+                }
+            }
+            if (invalid_elements_[e] == VALID) {
+                const idx_t nb_nodes = element_nb_nodes(*connectivity_, *icoords_, e);
+                if (nb_nodes != 3 && nb_nodes != 4) {
+                    invalid_elements_[e] = UNSUPPORTED_SHAPE;
+                }
+            }
+        }
+    }
 
-            PointXYZ p{(*ocoords_)(ip, 0), (*ocoords_)(ip, 1), (*ocoords_)(ip, 2)};  // lookup point
+    // Target points are independent: they are split in contiguous blocks, each filling its own
+    // triplets. Blocks are merged in order, so the matrix does not depend on the number of threads.
+    struct Block {
+        Triplets triplets;                      // weights -- one per vertex of element, triangles (3) or quads (4)
+        std::vector<size_t> failures;
+        std::vector<std::string> failures_log;  // only filled when failures are reported
+        idx_t max_neighbours{0};
+        idx_t invalid_point{-1};  // first point which could only be located in an invalid element
+        idx_t invalid_elem{-1};
+    };
+    const idx_t nb_blocks = std::min<idx_t>(out_npts, 16 * atlas_omp_get_max_threads());
+    std::vector<Block> blocks(nb_blocks);
 
-            idx_t kpts   = 1;
-            bool success = false;
-            std::ostringstream failures_log;
+    ATLAS_TRACE_SCOPE("Computing interpolation matrix") {
+        eckit::ProgressTimer progress("Computing interpolation weights", nb_blocks, "block", double(5), Log::debug());
+        atlas_omp_parallel_for (idx_t b = 0; b < nb_blocks; ++b) {
+            const idx_t begin = static_cast<idx_t>(size_t(b) * size_t(out_npts) / size_t(nb_blocks));
+            const idx_t end   = static_cast<idx_t>(size_t(b + 1) * size_t(out_npts) / size_t(nb_blocks));
+            Block& block      = blocks[b];
+            block.triplets.reserve((end - begin) * 4);  // preallocate space as if all elements where quads
+
+            for (idx_t ip = begin; ip < end; ++ip) {
+                if (out_ghosts(ip)) {
+                    continue;
+                }
 
-            if (search_radius != 0.) {
-                ElemIndex3::NodeList cs = eTree->findInSphere(p,search_radius);
-                if (cs.size()) {
-                    Triplets triplets       = projectPointToElements(ip, cs, failures_log);
+                PointXYZ p{(*ocoords_)(ip, 0), (*ocoords_)(ip, 1), (*ocoords_)(ip, 2)};  // lookup point
 
-                    if (triplets.size()) {
-                        std::copy(triplets.begin(), triplets.end(), std::back_inserter(weights_triplets));
-                        success = true;
+                idx_t kpts         = 1;
+                bool success       = false;
+                idx_t invalid_elem = -1;
+                std::ostringstream failures_log;
+
+                if (search_radius != 0.) {
+                    ElemIndex3::NodeList cs = eTree->findInSphere(p,search_radius);
+                    if (cs.size()) {
+                        Triplets triplets = projectPointToElements(ip, cs, failures_log, invalid_elem);
+
+                        if (triplets.size()) {
+                            std::copy(triplets.begin(), triplets.end(), std::back_inserter(block.triplets));
+                            success = true;
+                        }
                     }
                 }
-            }
-            else {
-                while (!success && kpts <= maxNbElemsToTry) {
-                    max_neighbours = std::max(kpts, max_neighbours);
-                    ElemIndex3::NodeList cs = eTree->kNearestNeighbours(p, kpts);
-                    Triplets triplets       = projectPointToElements(ip, cs, failures_log);
-
-                    if (triplets.size()) {
-                        std::copy(triplets.begin(), triplets.end(), std::back_inserter(weights_triplets));
-                        success = true;
+                else {
+                    while (!success && kpts <= maxNbElemsToTry) {
+                        block.max_neighbours = std::max(kpts, block.max_neighbours);
+                        ElemIndex3::NodeList cs = eTree->kNearestNeighbours(p, kpts);
+                        if (cs.empty()) {
+                            break;
+                        }
+                        Triplets triplets = projectPointToElements(ip, cs, failures_log, invalid_elem);
+
+                        if (triplets.size()) {
+                            std::copy(triplets.begin(), triplets.end(), std::back_inserter(block.triplets));
+                            success = true;
+                        }
+                        kpts *= 2;
+                    }
+                }
+
+                if (!success && invalid_elem >= 0 && block.invalid_point < 0) {
+                    block.invalid_point = ip;
+                    block.invalid_elem  = invalid_elem;
+                }
+                if (!success) {
+                    block.failures.push_back(ip);
+                    if (not treat_failure_as_missing_value_) {
+                        block.failures_log.emplace_back(failures_log.str());
                     }
-                    kpts *= 2;
                 }
             }
+            atlas_omp_critical { ++progress; }
+        }
+    }
 
-            if (!success) {
+    Triplets weights_triplets;  // structure to fill-in sparse matrix
+    std::vector<size_t> failures;
+    ATLAS_TRACE_SCOPE("Merging interpolation weights") {
+        size_t nb_triplets = 0;
+        for (const auto& block : blocks) {
+            nb_triplets += block.triplets.size();
+        }
+        weights_triplets.reserve(nb_triplets);
+        for (auto& block : blocks) {
+            std::copy(block.triplets.begin(), block.triplets.end(), std::back_inserter(weights_triplets));
+            Triplets().swap(block.triplets);
+            for (size_t j = 0; j < block.failures.size(); ++j) {
+                const size_t ip = block.failures[j];
                 failures.push_back(ip);
                 if (not treat_failure_as_missing_value_) {
                     Log::debug() << "------------------------------------------------------"
                                     "---------------------\n";
                     const PointLonLat pll{out_lonlat(ip, 0), out_lonlat(ip, 1)};
                     Log::debug() << "Failed to project point (lon,lat)=" << pll << '\n';
-                    Log::debug() << failures_log.str();
+                    Log::debug() << block.failures_log[j];
                 }
             }
+            max_neighbours = std::max(max_neighbours, block.max_neighbours);
         }
     }
     Log::debug() << "Maximum neighbours searched was " << eckit::Plural(max_neighbours, "element") << std::endl;
 
+    for (const auto& block : blocks) {
+        if (block.invalid_point >= 0) {
+            const idx_t ip = block.invalid_point;
+            const idx_t e  = block.invalid_elem;
+            const PointLonLat pll{out_lonlat(ip, 0), out_lonlat(ip, 1)};
+            std::ostringstream msg;
+            msg << "Rank " << mpi::rank() << " failed to project point (lon,lat) = " << pll
+                << ", which can only be located in source element " << e << ": "
+                << (invalid_elements_[e] == NODE_OUT_OF_RANGE ? "its nodes are not in the source function space"
+                                                              : "only triangles and quadrilaterals are supported");
+            throw_Exception(msg.str(), Here());
+        }
+    }
+
     if (failures.size()) {
         if (treat_failure_as_missing_value_) {
             missing_.resize(failures.size());
@@ -345,10 +468,8 @@ struct ElementEdge {
 };
 
 Method::Triplets FiniteElement::projectPointToElements(size_t ip, const ElemIndex3::NodeList& elems,
-                                                       std::ostream& /* failures_log */) const {
-    ATLAS_ASSERT(elems.begin() != elems.end());
-
-    const size_t inp_points = icoords_->shape(0);
+                                                       std::ostream& /* failures_log */, idx_t& invalid_elem) const {
+    // Called from within a parallel region: elems is not empty and its elements have been validated in setup()
     std::array<size_t, 4> idx;
     std::array<double, 4> w;
 
@@ -360,29 +481,16 @@ Method::Triplets FiniteElement::projectPointToElements(size_t ip, const ElemInde
     idx_t single_point;
     for (ElemIndex3::NodeList::const_iterator itc = elems.begin(); itc != elems.end(); ++itc) {
         const idx_t elem_id = idx_t((*itc).value().payload());
-        ATLAS_ASSERT(elem_id < connectivity_->rows());
-
-        const idx_t nb_cols = [&]() {
-            int nb_cols = connectivity_->cols(elem_id);
-            if (nb_cols == 5) {
-                // Check if pentagon degenerates to quad. Otherwise abort.
-                // For now only check if first and last point coincide.
-                auto i1    = (*connectivity_)(elem_id, 0);
-                auto iN    = (*connectivity_)(elem_id, nb_cols - 1);
-                auto first = PointXYZ{(*icoords_)(i1, XX), (*icoords_)(i1, YY), (*icoords_)(i1, ZZ)};
-                auto last  = PointXYZ{(*icoords_)(iN, XX), (*icoords_)(iN, YY), (*icoords_)(iN, ZZ)};
-                if (first == last) {
-                    return 4;
-                }
+        if (invalid_elements_[elem_id]) {
+            if (invalid_elem < 0) {
+                invalid_elem = elem_id;
             }
-            return nb_cols;
-        }();
-
-        ATLAS_ASSERT(nb_cols == 3 || nb_cols == 4);
+            continue;
+        }
+        const idx_t nb_cols = element_nb_nodes(*connectivity_, *icoords_, elem_id);
 
         for (idx_t i = 0; i < nb_cols; ++i) {
             idx[i] = (*connectivity_)(elem_id, i);
-            ATLAS_ASSERT(idx[i] < inp_points);
         }
 
         constexpr double tolerance = 1.e-12;
@@ -484,7 +592,6 @@ Method::Triplets FiniteElement::projectPointToElements(size_t ip, const ElemInde
             // pick an epsilon based on a characteristic length (sqrt(area))
             // (this scales linearly so it better compares with linear weights u,v,w)
             const double edgeEpsilon = parametricEpsilon * std::sqrt(triag.area());
-            ATLAS_ASSERT(edgeEpsilon >= 0);
 
             Intersect is = triag.intersects(ray, edgeEpsilon);
 
@@ -528,7 +635,6 @@ Method::Triplets FiniteElement::projectPointToElements(size_t ip, const ElemInde
             // pick an epsilon based on a characteristic length (sqrt(area))
             // (this scales linearly so it better compares with linear weights u,v,w)
             const double edgeEpsilon = parametricEpsilon * std::sqrt(quad.area());
-            ATLAS_ASSERT(edgeEpsilon >= 0);
 
             Intersect is = quad.intersects(ray, edgeEpsilon);
 
@@ -13,6 +13,7 @@
 #include "atlas/interpolation/method/Method.h"
 
 #include <string>
+#include <vector>
 
 #include "eckit/config/Configuration.h"
 #include "eckit/memory/NonCopyable.h"
@@ -56,8 +57,10 @@ protected:
    * the
    * point to the nearest element(s), returning the (normalized) interpolation
    * weights
+   * Invalid elements (see invalid_elements_) are skipped; the first one skipped is returned in invalid_elem
    */
-    Triplets projectPointToElements(size_t ip, const ElemIndex3::NodeList& elems, std::ostream& failures_log) const;
+    Triplets projectPointToElements(size_t ip, const ElemIndex3::NodeList& elems, std::ostream& failures_log,
+                                    idx_t& invalid_elem) const;
 
     virtual const FunctionSpace& source() const override { return source_; }
     virtual const FunctionSpace& target() const override { return target_; }
@@ -74,6 +77,9 @@ protected:
     std::unique_ptr<array::ArrayView<double, 2>> ocoords_;
     std::unique_ptr<array::ArrayView<gidx_t, 1>> igidx_;
 
+    /// Source elements which cannot be projected to: 0 if valid, otherwise the reason (see setup())
+    std::vector<char> invalid_elements_;
+
     Field target_lonlat_;
     Field target_xyz_;
     Field target_ghost_;
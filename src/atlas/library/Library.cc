@@ -66,6 +66,10 @@ static bool feature_MKL() {
 #endif
 #endif
 
+#if ATLAS_HAVE_FFTW
+#include "atlas/trans/local/FFTWWisdom.h"
+#endif
+
 using eckit::LocalPathName;
 using eckit::Main;
 using eckit::PathName;
@@ -369,6 +373,11 @@ void Library::finalise() {
         Log::info() << atlas::Trace::report() << std::endl;
     }
 
+#if ATLAS_HAVE_FFTW
+    // Persist FFTW wisdom gathered by TransLocal, while MPI is still available
+    trans::FFTWWisdom::instance().save();
+#endif
+
     if (getEnv("ATLAS_FINALISES_MPI", false)) {
         Log::debug() << "ATLAS_FINALISES_MPI is set: calling atlas::mpi::finalize()" << std::endl;
         mpi::finalise();
@@ -476,6 +485,7 @@ void Library::Information::print(std::ostream& out) const {
     bool feature_ecTrans(ATLAS_HAVE_ECTRANS);
     bool feature_FFTW(ATLAS_HAVE_FFTW);
     bool feature_Eigen(ATLAS_HAVE_EIGEN);
+    bool feature_CBLAS(ATLAS_HAVE_CBLAS);
     bool feature_Tesselation(ATLAS_HAVE_TESSELATION);
     bool feature_PROJ(ATLAS_HAVE_PROJ);
     bool feature_BoundsChecking(ATLAS_ARRAYVIEW_BOUNDS_CHECKING);
@@ -503,6 +513,7 @@ void Library::Information::print(std::ostream& out) const {
         << "    ecTrans        : " << str(feature_ecTrans) << '\n'
         << "    FFTW           : " << str(feature_FFTW) << '\n'
         << "    Eigen          : " << str(feature_Eigen) << '\n'
+        << "    CBLAS          : " << str(feature_CBLAS) << '\n'
         << "    MKL            : " << str(feature_MKL()) << '\n'
         << "    Tesselation    : " << str(feature_Tesselation) << '\n'
         << "    PROJ           : " << str(feature_PROJ) << '\n'
@@ -25,6 +25,27 @@ namespace linalg {
 using Matrix        = eckit::linalg::Matrix;
 using Configuration = eckit::Configuration;
 
+/// Single precision matrix wrapping external memory, column-major like eckit::linalg::Matrix
+class MatrixFloat {
+public:
+    using Scalar = float;
+    using Size   = eckit::linalg::Size;
+
+    MatrixFloat(Scalar* data, Size rows, Size cols): data_(data), rows_(rows), cols_(cols) {}
+
+    Size rows() const { return rows_; }
+    Size cols() const { return cols_; }
+    Size size() const { return rows_ * cols_; }
+
+    Scalar* data() { return data_; }
+    const Scalar* data() const { return data_; }
+
+private:
+    Scalar* data_;
+    Size rows_;
+    Size cols_;
+};
+
 // C = A . B
 template <typename Matrix>
 void matrix_multiply(const Matrix& A, const Matrix& B, Matrix& C);
@@ -32,6 +53,14 @@ void matrix_multiply(const Matrix& A, const Matrix& B, Matrix& C);
 template <typename Matrix>
 void matrix_multiply(const Matrix& A, const Matrix& B, Matrix& C, const eckit::Configuration&);
 
+// C = A . B in single precision
+// eckit::linalg backends only support double precision. The BLAS based backends ("mkl", "lapack", and the eckit
+// default) call cblas_sgemm when atlas is built with CBLAS (MKL or e.g. OpenBLAS). Other backends, or a build without
+// CBLAS, use a native cache-blocked implementation, threaded with OpenMP.
+void matrix_multiply(const MatrixFloat& A, const MatrixFloat& B, MatrixFloat& C);
+
+void matrix_multiply(const MatrixFloat& A, const MatrixFloat& B, MatrixFloat& C, const eckit::Configuration&);
+
 class MatrixMultiply {
 public:
     MatrixMultiply() = default;
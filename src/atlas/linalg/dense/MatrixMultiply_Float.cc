@@ -0,0 +1,125 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <string>
+
+#include "atlas/library/config.h"
+#if ATLAS_ECKIT_HAVE_ECKIT_585
+#include "eckit/linalg/LinearAlgebraDense.h"
+#else
+#include "eckit/linalg/LinearAlgebra.h"
+#endif
+
+#if ATLAS_HAVE_MKL
+#include <mkl_cblas.h>
+#elif ATLAS_HAVE_CBLAS
+#include <cblas.h>
+#endif
+
+#include "atlas/linalg/dense/MatrixMultiply.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace linalg {
+
+namespace {
+// Number of columns of C computed together, reusing the loaded columns of A
+constexpr long column_block = 4;
+// Number of columns of A traversed for one block of columns of C, so that they remain in cache
+constexpr long inner_block = 256;
+
+bool has_eckit_backend(const std::string& backend) {
+#if ATLAS_ECKIT_HAVE_ECKIT_585
+    return eckit::linalg::LinearAlgebraDense::hasBackend(backend);
+#else
+    return eckit::linalg::LinearAlgebra::hasBackend(backend);
+#endif
+}
+
+// True if the configured backend is BLAS based and sgemm can be called directly, false if the generic
+// implementation is used. Backends are resolved as for double precision, see MatrixMultiply.tcc
+bool use_blas(const eckit::Configuration& config) {
+    std::string type = config.getString("type", dense::current_backend());
+    if (type == dense::backend::eckit_linalg::type()) {
+        type = config.getString("backend", "default");
+    }
+    if (type == "mkl" || type == "lapack" || type == "default") {
+        return ATLAS_HAVE_CBLAS;
+    }
+    if (type == "generic" || type == "openmp" || has_eckit_backend(type)) {
+        return false;
+    }
+    throw_NotImplemented("matrix_multiply cannot be performed with unsupported backend [" + type + "]", Here());
+}
+
+#if ATLAS_HAVE_CBLAS
+void sgemm(const MatrixFloat& A, const MatrixFloat& B, MatrixFloat& C) {
+    ATLAS_ASSERT(A.rows() <= INT_MAX && A.cols() <= INT_MAX && B.cols() <= INT_MAX,
+                 "Matrix dimensions exceed the range of BLAS integers");
+    const int m = static_cast<int>(A.rows());
+    const int k = static_cast<int>(A.cols());
+    const int n = static_cast<int>(C.cols());
+    cblas_sgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m, n, k, 1.f, A.data(), std::max(1, m), B.data(),
+                std::max(1, k), 0.f, C.data(), std::max(1, m));
+}
+#endif
+
+void generic_sgemm(const MatrixFloat& A, const MatrixFloat& B, MatrixFloat& C) {
+    const long m   = static_cast<long>(A.rows());
+    const long k   = static_cast<long>(A.cols());
+    const long n   = static_cast<long>(C.cols());
+    const float* a = A.data();
+    const float* b = B.data();
+    float* c       = C.data();
+
+    atlas_omp_parallel_for(long j0 = 0; j0 < n; j0 += column_block) {
+        const long j1 = std::min(j0 + column_block, n);
+        std::fill(c + m * j0, c + m * j1, 0.f);
+        for (long l0 = 0; l0 < k; l0 += inner_block) {
+            const long l1 = std::min(l0 + inner_block, k);
+            for (long j = j0; j < j1; ++j) {
+                float* cj       = c + m * j;
+                const float* bj = b + k * j;
+                for (long l = l0; l < l1; ++l) {
+                    const float blj = bj[l];
+                    const float* al = a + m * l;
+                    for (long i = 0; i < m; ++i) {
+                        cj[i] += al[i] * blj;
+                    }
+                }
+            }
+        }
+    }
+}
+}  // namespace
+
+void matrix_multiply(const MatrixFloat& A, const MatrixFloat& B, MatrixFloat& C) {
+    matrix_multiply(A, B, C, dense::Backend());
+}
+
+void matrix_multiply(const MatrixFloat& A, const MatrixFloat& B, MatrixFloat& C, const eckit::Configuration& config) {
+    ATLAS_ASSERT(A.cols() == B.rows());
+    ATLAS_ASSERT(A.rows() == C.rows());
+    ATLAS_ASSERT(B.cols() == C.cols());
+
+    if (use_blas(config)) {
+#if ATLAS_HAVE_CBLAS
+        sgemm(A, B, C);
+        return;
+#endif
+    }
+    generic_sgemm(A, B, C);
+}
+
+}  // namespace linalg
+}  // namespace atlas
@@ -96,7 +96,7 @@ Backend::Backend(const eckit::Configuration& other): util::Config(other) {
 
 bool Backend::available() const {
     std::string t = type();
-    if (t == backend::openmp::type()) {
+    if (t == backend::openmp::type() || t == backend::openmp_blocked::type()) {
         return true;
     }
     if (t == backend::eckit_linalg::type()) {
@@ -39,6 +39,11 @@ struct openmp : Backend {
     openmp(): Backend(type()) {}
 };
 
+struct openmp_blocked : Backend {
+    static std::string type() { return "openmp_blocked"; }
+    openmp_blocked(): Backend(type()) {}
+};
+
 struct eckit_linalg : Backend {
     static std::string type() { return "eckit_linalg"; }
     eckit_linalg(): Backend(type()) {}
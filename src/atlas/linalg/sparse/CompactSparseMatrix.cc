@@ -0,0 +1,91 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/linalg/sparse/CompactSparseMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "eckit/linalg/SparseMatrix.h"
+
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace linalg {
+
+CompactSparseMatrix::CompactSparseMatrix(): owned_outer_(1, 0) {
+    outer_ = owned_outer_.data();
+}
+
+CompactSparseMatrix::CompactSparseMatrix(const eckit::linalg::SparseMatrix& matrix):
+    rows_(matrix.rows()), cols_(matrix.cols()), nnz_(matrix.nonZeros()) {
+    const auto max_index = static_cast<Size>(std::numeric_limits<Index>::max());
+    if (rows_ > max_index || cols_ > max_index || nnz_ > max_index) {
+        throw_Exception("CompactSparseMatrix: matrix dimensions exceed the range of 32-bit indices", Here());
+    }
+
+    const auto outer  = matrix.outer();
+    const auto inner  = matrix.inner();
+    const auto weight = matrix.data();
+
+    owned_outer_.assign(rows_ + 1, 0);
+    for (Size r = 0; outer != nullptr && r <= rows_; ++r) {
+        owned_outer_[r] = static_cast<Index>(outer[r]);
+    }
+
+    owned_inner_.resize(nnz_);
+    owned_data_.resize(nnz_);
+    for (Size i = 0; i < nnz_; ++i) {
+        owned_inner_[i]   = static_cast<Index>(inner[i]);
+        owned_data_[i]    = static_cast<Scalar>(weight[i]);
+        max_weight_error_ = std::max(max_weight_error_, std::abs(weight[i] - static_cast<double>(owned_data_[i])));
+    }
+
+    outer_ = owned_outer_.data();
+    inner_ = owned_inner_.data();
+    data_  = owned_data_.data();
+}
+
+CompactSparseMatrix::CompactSparseMatrix(Size rows, Size cols, Size nonZeros, const Index* outer, const Index* inner,
+                                         const Scalar* data, std::shared_ptr<const void> storage):
+    rows_(rows),
+    cols_(cols),
+    nnz_(nonZeros),
+    outer_(outer),
+    inner_(inner),
+    data_(data),
+    storage_(std::move(storage)) {
+    ATLAS_ASSERT(outer_ != nullptr);
+    ATLAS_ASSERT(storage_ != nullptr);
+    ATLAS_ASSERT(static_cast<Size>(outer_[rows_]) == nnz_);
+}
+
+size_t CompactSparseMatrix::footprint() const {
+    return sizeof(*this) + (rows_ + 1) * sizeof(Index) + nnz_ * (sizeof(Index) + sizeof(Scalar));
+}
+
+void CompactSparseMatrix::swap(CompactSparseMatrix& other) {
+    std::swap(rows_, other.rows_);
+    std::swap(cols_, other.cols_);
+    std::swap(nnz_, other.nnz_);
+    std::swap(outer_, other.outer_);
+    std::swap(inner_, other.inner_);
+    std::swap(data_, other.data_);
+    owned_outer_.swap(other.owned_outer_);
+    owned_inner_.swap(other.owned_inner_);
+    owned_data_.swap(other.owned_data_);
+    storage_.swap(other.storage_);
+    std::swap(max_weight_error_, other.max_weight_error_);
+}
+
+}  // namespace linalg
+}  // namespace atlas
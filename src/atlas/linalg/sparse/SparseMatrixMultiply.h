@@ -10,12 +10,15 @@
 
 #pragma once
 
+#include <vector>
+
 #include "eckit/config/Configuration.h"
 #include "eckit/linalg/SparseMatrix.h"
 
 #include "atlas/linalg/Indexing.h"
 #include "atlas/linalg/View.h"
 #include "atlas/linalg/sparse/Backend.h"
+#include "atlas/linalg/sparse/CompactSparseMatrix.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/util/Config.h"
 
@@ -38,6 +41,13 @@ template <typename Matrix, typename SourceView, typename TargetView>
 void sparse_matrix_multiply(const Matrix& matrix, const SourceView& src, TargetView& tgt, Indexing,
                             const Configuration& config);
 
+/// Apply the matrix to several fields in one pass, reading each row of the matrix once for all fields.
+/// Each field is a rank-2 view with Indexing::layout_left, i.e. (point, values of the point), and is read from and
+/// written to its own storage. Only the openmp and openmp_blocked backends are supported.
+template <typename Matrix, typename SourceValue, typename TargetValue>
+void sparse_matrix_multiply_fields(const Matrix& matrix, const std::vector<View<SourceValue, 2>>& src,
+                                   std::vector<View<TargetValue, 2>>& tgt, const Configuration& config);
+
 class SparseMatrixMultiply {
 public:
     SparseMatrixMultiply() = default;
@@ -65,11 +75,23 @@ namespace sparse {
 // Template class which needs (full or partial) specialization for concrete template parameters
 template <typename Backend, Indexing, int Rank, typename SourceValue, typename TargetValue>
 struct SparseMatrixMultiply {
-    static void apply(const SparseMatrix&, const View<SourceValue, Rank>&, View<TargetValue, Rank>&,
+    template <typename Matrix>
+    static void apply(const Matrix&, const View<SourceValue, Rank>&, View<TargetValue, Rank>&,
                       const Configuration&) {
         throw_NotImplemented("SparseMatrixMultiply needs a template specialization with the implementation", Here());
     }
 };
+
+// Template class for the application to several fields, which needs specialization per backend
+template <typename Backend, typename SourceValue, typename TargetValue>
+struct SparseMatrixMultiplyFields {
+    template <typename Matrix>
+    static void apply(const Matrix&, const std::vector<View<SourceValue, 2>>&, std::vector<View<TargetValue, 2>>&,
+                      const Configuration&) {
+        throw_NotImplemented("SparseMatrixMultiplyFields needs a template specialization with the implementation",
+                             Here());
+    }
+};
 }  // namespace sparse
 
 }  // namespace linalg
@@ -78,3 +100,4 @@ struct SparseMatrixMultiply {
 #include "SparseMatrixMultiply.tcc"
 #include "SparseMatrixMultiply_EckitLinalg.h"
 #include "SparseMatrixMultiply_OpenMP.h"
+#include "SparseMatrixMultiply_OpenMPBlocked.h"
@@ -18,6 +18,8 @@
 #include "atlas/linalg/sparse/Backend.h"
 #include "atlas/runtime/Exception.h"
 
+#include <type_traits>
+
 #if ATLAS_ECKIT_HAVE_ECKIT_585
 #include "eckit/linalg/LinearAlgebraSparse.h"
 #else
@@ -32,8 +34,8 @@ namespace sparse {
 namespace {
 template <typename Backend, Indexing indexing>
 struct SparseMatrixMultiplyHelper {
-    template <typename SourceView, typename TargetView>
-    static void apply( const SparseMatrix& W, const SourceView& src, TargetView& tgt,
+    template <typename Matrix, typename SourceView, typename TargetView>
+    static void apply( const Matrix& W, const SourceView& src, TargetView& tgt,
                        const eckit::Configuration& config ) {
         using SourceValue = const typename std::remove_const<typename SourceView::value_type>::type;
         using TargetValue = typename std::remove_const<typename TargetView::value_type>::type;
@@ -74,9 +76,21 @@ template <typename Matrix, typename SourceView, typename TargetView>
 void sparse_matrix_multiply( const Matrix& matrix, const SourceView& src, TargetView& tgt, Indexing indexing,
                              const eckit::Configuration& config ) {
     std::string type = config.getString( "type", sparse::current_backend() );
-    if ( type == sparse::backend::openmp::type() ) {
+    if constexpr ( std::is_same_v<Matrix, CompactSparseMatrix> ) {
+        // Only the openmp backends support CompactSparseMatrix
+        if ( type == sparse::backend::openmp_blocked::type() ) {
+            sparse::dispatch_sparse_matrix_multiply<sparse::backend::openmp_blocked>( matrix, src, tgt, indexing, config );
+        }
+        else {
+            sparse::dispatch_sparse_matrix_multiply<sparse::backend::openmp>( matrix, src, tgt, indexing, config );
+        }
+    }
+    else if ( type == sparse::backend::openmp::type() ) {
         sparse::dispatch_sparse_matrix_multiply<sparse::backend::openmp>( matrix, src, tgt, indexing, config );
     }
+    else if ( type == sparse::backend::openmp_blocked::type() ) {
+        sparse::dispatch_sparse_matrix_multiply<sparse::backend::openmp_blocked>( matrix, src, tgt, indexing, config );
+    }
     else if ( type == sparse::backend::eckit_linalg::type() ) {
         sparse::dispatch_sparse_matrix_multiply<sparse::backend::eckit_linalg>( matrix, src, tgt, indexing, config );
     }
@@ -93,6 +107,23 @@ void sparse_matrix_multiply( const Matrix& matrix, const SourceView& src, Target
     }
 }
 
+template <typename Matrix, typename SourceValue, typename TargetValue>
+void sparse_matrix_multiply_fields( const Matrix& matrix, const std::vector<View<SourceValue, 2>>& src,
+                                    std::vector<View<TargetValue, 2>>& tgt, const eckit::Configuration& config ) {
+    ATLAS_ASSERT( src.size() == tgt.size() );
+    std::string type = config.getString( "type", sparse::current_backend() );
+    if ( type == sparse::backend::openmp::type() ) {
+        sparse::SparseMatrixMultiplyFields<sparse::backend::openmp, SourceValue, TargetValue>::apply( matrix, src, tgt, config );
+    }
+    else if ( type == sparse::backend::openmp_blocked::type() ) {
+        sparse::SparseMatrixMultiplyFields<sparse::backend::openmp_blocked, SourceValue, TargetValue>::apply( matrix, src, tgt, config );
+    }
+    else {
+        throw_NotImplemented( "sparse_matrix_multiply_fields cannot be performed with unsupported backend [" + type + "]",
+                              Here() );
+    }
+}
+
 template <typename Matrix, typename SourceView, typename TargetView>
 void sparse_matrix_multiply( const Matrix& matrix, const SourceView& src, TargetView& tgt, const eckit::Configuration& config ) {
     sparse_matrix_multiply( matrix, src, tgt, Indexing::layout_left, config );
@@ -18,8 +18,9 @@ namespace linalg {
 namespace sparse {
 
 template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
 void SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 1, SourceValue, TargetValue>::apply(
-    const SparseMatrix& W, const View<SourceValue, 1>& src, View<TargetValue, 1>& tgt, const Configuration&) {
+    const Matrix& W, const View<SourceValue, 1>& src, View<TargetValue, 1>& tgt, const Configuration&) {
     using Value       = TargetValue;
     const auto outer  = W.outer();
     const auto index  = W.inner();
@@ -41,8 +42,9 @@ void SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 1, SourceValue
 
 
 template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
 void SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 2, SourceValue, TargetValue>::apply(
-    const SparseMatrix& W, const View<SourceValue, 2>& src, View<TargetValue, 2>& tgt, const Configuration&) {
+    const Matrix& W, const View<SourceValue, 2>& src, View<TargetValue, 2>& tgt, const Configuration&) {
     using Value       = TargetValue;
     const auto outer  = W.outer();
     const auto index  = W.inner();
@@ -68,8 +70,9 @@ void SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 2, SourceValue
 }
 
 template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
 void SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 3, SourceValue, TargetValue>::apply(
-    const SparseMatrix& W, const View<SourceValue, 3>& src, View<TargetValue, 3>& tgt, const Configuration& config) {
+    const Matrix& W, const View<SourceValue, 3>& src, View<TargetValue, 3>& tgt, const Configuration& config) {
     if (src.contiguous() && tgt.contiguous()) {
         // We can take a more optimized route by reducing rank
         auto src_v = View<SourceValue, 2>(src.data(), array::make_shape(src.shape(0), src.stride(0)));
@@ -105,15 +108,17 @@ void SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 3, SourceValue
 }
 
 template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
 void SparseMatrixMultiply<backend::openmp, Indexing::layout_right, 1, SourceValue, TargetValue>::apply(
-    const SparseMatrix& W, const View<SourceValue, 1>& src, View<TargetValue, 1>& tgt, const Configuration& config) {
+    const Matrix& W, const View<SourceValue, 1>& src, View<TargetValue, 1>& tgt, const Configuration& config) {
     return SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 1, SourceValue, TargetValue>::apply(W, src, tgt,
                                                                                                             config);
 }
 
 template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
 void SparseMatrixMultiply<backend::openmp, Indexing::layout_right, 2, SourceValue, TargetValue>::apply(
-    const SparseMatrix& W, const View<SourceValue, 2>& src, View<TargetValue, 2>& tgt, const Configuration&) {
+    const Matrix& W, const View<SourceValue, 2>& src, View<TargetValue, 2>& tgt, const Configuration&) {
     using Value       = TargetValue;
     const auto outer  = W.outer();
     const auto index  = W.inner();
@@ -139,8 +144,9 @@ void SparseMatrixMultiply<backend::openmp, Indexing::layout_right, 2, SourceValu
 }
 
 template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
 void SparseMatrixMultiply<backend::openmp, Indexing::layout_right, 3, SourceValue, TargetValue>::apply(
-    const SparseMatrix& W, const View<SourceValue, 3>& src, View<TargetValue, 3>& tgt, const Configuration& config) {
+    const Matrix& W, const View<SourceValue, 3>& src, View<TargetValue, 3>& tgt, const Configuration& config) {
     if (src.contiguous() && tgt.contiguous()) {
         // We can take a more optimized route by reducing rank
         auto src_v = View<SourceValue, 2>(src.data(), array::make_shape(src.shape(0), src.stride(0)));
@@ -175,16 +181,71 @@ void SparseMatrixMultiply<backend::openmp, Indexing::layout_right, 3, SourceValu
     }
 }
 
-#define EXPLICIT_TEMPLATE_INSTANTIATION(TYPE)                                                           \
-    template struct SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 1, TYPE const, TYPE>;  \
-    template struct SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 2, TYPE const, TYPE>;  \
-    template struct SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 3, TYPE const, TYPE>;  \
-    template struct SparseMatrixMultiply<backend::openmp, Indexing::layout_right, 1, TYPE const, TYPE>; \
-    template struct SparseMatrixMultiply<backend::openmp, Indexing::layout_right, 2, TYPE const, TYPE>; \
-    template struct SparseMatrixMultiply<backend::openmp, Indexing::layout_right, 3, TYPE const, TYPE>;
+template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
+void SparseMatrixMultiplyFields<backend::openmp, SourceValue, TargetValue>::apply(
+    const Matrix& W, const std::vector<View<SourceValue, 2>>& src, std::vector<View<TargetValue, 2>>& tgt,
+    const Configuration&) {
+    using Value            = TargetValue;
+    const auto outer       = W.outer();
+    const auto index       = W.inner();
+    const auto weight      = W.data();
+    const idx_t rows       = static_cast<idx_t>(W.rows());
+    const size_t nb_fields = src.size();
+
+    ATLAS_ASSERT(tgt.size() == nb_fields);
+    for (size_t f = 0; f < nb_fields; ++f) {
+        ATLAS_ASSERT(src[f].shape(0) >= W.cols());
+        ATLAS_ASSERT(tgt[f].shape(0) >= W.rows());
+        ATLAS_ASSERT(src[f].shape(1) == tgt[f].shape(1));
+    }
+
+    atlas_omp_parallel_for(idx_t r = 0; r < rows; ++r) {
+        for (size_t f = 0; f < nb_fields; ++f) {
+            auto& t        = tgt[f];
+            const idx_t Nk = t.shape(1);
+            for (idx_t k = 0; k < Nk; ++k) {
+                t(r, k) = 0.;
+            }
+        }
+        for (idx_t c = outer[r]; c < outer[r + 1]; ++c) {
+            idx_t n = index[c];
+            Value w = static_cast<Value>(weight[c]);
+            for (size_t f = 0; f < nb_fields; ++f) {
+                const auto& s  = src[f];
+                auto& t        = tgt[f];
+                const idx_t Nk = t.shape(1);
+                for (idx_t k = 0; k < Nk; ++k) {
+                    t(r, k) += w * s(n, k);
+                }
+            }
+        }
+    }
+}
 
-EXPLICIT_TEMPLATE_INSTANTIATION(double);
-EXPLICIT_TEMPLATE_INSTANTIATION(float);
+#define EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(INDEXING, RANK, MATRIX, TYPE)                                      \
+    template void SparseMatrixMultiply<backend::openmp, INDEXING, RANK, TYPE const, TYPE>::apply<MATRIX>( \
+        const MATRIX&, const View<TYPE const, RANK>&, View<TYPE, RANK>&, const Configuration&);
+
+#define EXPLICIT_TEMPLATE_INSTANTIATION_FIELDS(MATRIX, TYPE)                                           \
+    template void SparseMatrixMultiplyFields<backend::openmp, TYPE const, TYPE>::apply<MATRIX>(           \
+        const MATRIX&, const std::vector<View<TYPE const, 2>>&, std::vector<View<TYPE, 2>>&, const Configuration&);
+
+#define EXPLICIT_TEMPLATE_INSTANTIATION_MATRIX(MATRIX, TYPE)                          \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_left, 1, MATRIX, TYPE)  \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_left, 2, MATRIX, TYPE)  \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_left, 3, MATRIX, TYPE)  \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_right, 1, MATRIX, TYPE) \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_right, 2, MATRIX, TYPE) \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_right, 3, MATRIX, TYPE) \
+    EXPLICIT_TEMPLATE_INSTANTIATION_FIELDS(MATRIX, TYPE)
+
+#define EXPLICIT_TEMPLATE_INSTANTIATION(TYPE)                         \
+    EXPLICIT_TEMPLATE_INSTANTIATION_MATRIX(SparseMatrix, TYPE)        \
+    EXPLICIT_TEMPLATE_INSTANTIATION_MATRIX(CompactSparseMatrix, TYPE)
+
+EXPLICIT_TEMPLATE_INSTANTIATION(double)
+EXPLICIT_TEMPLATE_INSTANTIATION(float)
 
 }  // namespace sparse
 }  // namespace linalg
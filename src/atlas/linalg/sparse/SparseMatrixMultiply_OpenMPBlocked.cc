@@ -0,0 +1,371 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/linalg/sparse/SparseMatrixMultiply_OpenMPBlocked.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace linalg {
+namespace sparse {
+
+namespace {
+
+constexpr idx_t default_row_block = 64;
+
+// Number of levels per block in the variable non-zeros kernel, so that the target row stays in L1 cache
+constexpr idx_t level_block = 512;
+
+// Contiguous row ranges with approximately equal number of non-zeros, one per thread.
+template <typename Matrix>
+std::vector<idx_t> partition_rows(const Matrix& W, int nb_parts) {
+    using Index      = std::remove_cv_t<std::remove_pointer_t<decltype(W.outer())>>;
+    const auto outer = W.outer();
+    const idx_t rows = static_cast<idx_t>(W.rows());
+    const auto nnz   = static_cast<size_t>(outer[rows] - outer[0]);
+
+    std::vector<idx_t> begin(nb_parts + 1, rows);
+    begin[0] = 0;
+    for (int p = 1; p < nb_parts; ++p) {
+        const auto target = static_cast<Index>(outer[0] + (nnz * p) / nb_parts);
+        const auto row    = static_cast<idx_t>(std::lower_bound(outer, outer + rows, target) - outer);
+        begin[p]          = std::max(begin[p - 1], row);
+    }
+    return begin;
+}
+
+// Number of non-zeros of each row if this is the same for all rows, 0 otherwise
+template <typename Matrix>
+idx_t fixed_nonzeros_per_row(const Matrix& W) {
+    const auto outer = W.outer();
+    const idx_t rows = static_cast<idx_t>(W.rows());
+    if (rows == 0) {
+        return 0;
+    }
+    const auto nnz = outer[1] - outer[0];
+    if (outer[rows] - outer[0] != nnz * rows) {
+        return 0;
+    }
+    for (idx_t r = 1; r < rows; ++r) {
+        if (outer[r + 1] - outer[r] != nnz) {
+            return 0;
+        }
+    }
+    return static_cast<idx_t>(nnz);
+}
+
+// Call function with the number of non-zeros per row as compile-time constant for bilinear (4)
+// and bicubic (16) matrices, or with 0 for matrices with variable number of non-zeros.
+template <typename Matrix, typename Function>
+void dispatch_nonzeros(const Matrix& W, const Function& function) {
+    switch (fixed_nonzeros_per_row(W)) {
+        case 4:
+            function(std::integral_constant<int, 4>{});
+            break;
+        case 16:
+            function(std::integral_constant<int, 16>{});
+            break;
+        default:
+            function(std::integral_constant<int, 0>{});
+    }
+}
+
+// Statically schedule the row partitions over the threads
+template <typename Matrix, typename Kernel>
+void for_each_partition(const Matrix& W, const Kernel& kernel) {
+    const int nb_parts   = std::max(1, atlas_omp_get_max_threads());
+    const auto partition = partition_rows(W, nb_parts);
+    atlas_omp_parallel {
+        const int nb_threads = atlas_omp_get_num_threads();
+        for (int p = atlas_omp_get_thread_num(); p < nb_parts; p += nb_threads) {
+            kernel(partition[p], partition[p + 1]);
+        }
+    }
+}
+
+template <int NNZ, typename SourceValue, typename TargetValue, typename Matrix>
+inline TargetValue row_dot(const Matrix& W, idx_t r, const SourceValue* src, idx_t src_stride) {
+    const auto outer  = W.outer();
+    const auto index  = W.inner();
+    const auto weight = W.data();
+    const auto c0     = outer[r];
+    const auto c1     = NNZ > 0 ? c0 + NNZ : outer[r + 1];
+    TargetValue sum   = 0.;
+    for (auto c = c0; c < c1; ++c) {
+        sum += static_cast<TargetValue>(weight[c]) * src[static_cast<size_t>(index[c]) * src_stride];
+    }
+    return sum;
+}
+
+// tgt[r] = sum_c W(r,c) * src[c], for rows [r_begin, r_end)
+template <int NNZ, typename SourceValue, typename TargetValue, typename Matrix>
+void multiply_rows(const Matrix& W, idx_t r_begin, idx_t r_end, const SourceValue* src, idx_t src_stride,
+                   TargetValue* tgt, idx_t tgt_stride) {
+    for (idx_t r = r_begin; r < r_end; ++r) {
+        tgt[static_cast<size_t>(r) * tgt_stride] = row_dot<NNZ, SourceValue, TargetValue>(W, r, src, src_stride);
+    }
+}
+
+// tgt(r,k) = sum_c W(r,c) * src(c,k), for rows [r_begin, r_end), with k contiguous in memory
+template <int NNZ, typename SourceValue, typename TargetValue, typename Matrix>
+void multiply_rows_levels(const Matrix& W, idx_t r_begin, idx_t r_end, const SourceValue* src,
+                          idx_t src_stride, TargetValue* tgt, idx_t tgt_stride, idx_t Nk) {
+    using Value       = TargetValue;
+    const auto outer  = W.outer();
+    const auto index  = W.inner();
+    const auto weight = W.data();
+
+    for (idx_t r = r_begin; r < r_end; ++r) {
+        Value* t      = tgt + static_cast<size_t>(r) * tgt_stride;
+        const auto c0 = outer[r];
+        if constexpr (NNZ > 0) {
+            // All source columns are combined in a single pass, writing each target value once
+            const SourceValue* s[NNZ];
+            Value w[NNZ];
+            for (int j = 0; j < NNZ; ++j) {
+                s[j] = src + static_cast<size_t>(index[c0 + j]) * src_stride;
+                w[j] = static_cast<Value>(weight[c0 + j]);
+            }
+            atlas_omp_pragma(omp simd)
+            for (idx_t k = 0; k < Nk; ++k) {
+                Value sum = 0.;
+                for (int j = 0; j < NNZ; ++j) {
+                    sum += w[j] * s[j][k];
+                }
+                t[k] = sum;
+            }
+        }
+        else {
+            const auto c1 = outer[r + 1];
+            for (idx_t k_begin = 0; k_begin < Nk; k_begin += level_block) {
+                const idx_t k_end = std::min(k_begin + level_block, Nk);
+                if (c0 == c1) {
+                    atlas_omp_pragma(omp simd)
+                    for (idx_t k = k_begin; k < k_end; ++k) {
+                        t[k] = 0.;
+                    }
+                    continue;
+                }
+                // First non-zero initialises the target, avoiding a separate pass to zero it
+                {
+                    const SourceValue* s = src + static_cast<size_t>(index[c0]) * src_stride;
+                    const Value w        = static_cast<Value>(weight[c0]);
+                    atlas_omp_pragma(omp simd)
+                    for (idx_t k = k_begin; k < k_end; ++k) {
+                        t[k] = w * s[k];
+                    }
+                }
+                for (auto c = c0 + 1; c < c1; ++c) {
+                    const SourceValue* s = src + static_cast<size_t>(index[c]) * src_stride;
+                    const Value w        = static_cast<Value>(weight[c]);
+                    atlas_omp_pragma(omp simd)
+                    for (idx_t k = k_begin; k < k_end; ++k) {
+                        t[k] += w * s[k];
+                    }
+                }
+            }
+        }
+    }
+}
+
+// tgt(k,r) = sum_c W(r,c) * src(k,c), for rows [r_begin, r_end), with r and c contiguous in memory.
+// Rows are processed in blocks, so that the matrix entries of a block are reused from cache for all levels.
+template <int NNZ, typename SourceValue, typename TargetValue, typename Matrix>
+void multiply_rows_blocked(const Matrix& W, idx_t r_begin, idx_t r_end, idx_t row_block,
+                           const SourceValue* src, idx_t src_stride, TargetValue* tgt, idx_t tgt_stride, idx_t Nk) {
+    for (idx_t rb_begin = r_begin; rb_begin < r_end; rb_begin += row_block) {
+        const idx_t rb_end = std::min(rb_begin + row_block, r_end);
+        for (idx_t k = 0; k < Nk; ++k) {
+            const SourceValue* s = src + static_cast<size_t>(k) * src_stride;
+            TargetValue* t       = tgt + static_cast<size_t>(k) * tgt_stride;
+            atlas_omp_pragma(omp simd)
+            for (idx_t r = rb_begin; r < rb_end; ++r) {
+                t[r] = row_dot<NNZ, SourceValue, TargetValue>(W, r, s, 1);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
+void SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_left, 1, SourceValue, TargetValue>::apply(
+    const Matrix& W, const View<SourceValue, 1>& src, View<TargetValue, 1>& tgt, const Configuration&) {
+    ATLAS_ASSERT(src.shape(0) >= W.cols());
+    ATLAS_ASSERT(tgt.shape(0) >= W.rows());
+
+    const idx_t src_stride = src.stride(0);
+    const idx_t tgt_stride = tgt.stride(0);
+    dispatch_nonzeros(W, [&](auto nnz) {
+        constexpr int NNZ = decltype(nnz)::value;
+        for_each_partition(W, [&](idx_t r_begin, idx_t r_end) {
+            multiply_rows<NNZ>(W, r_begin, r_end, src.data(), src_stride, tgt.data(), tgt_stride);
+        });
+    });
+}
+
+template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
+void SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_left, 2, SourceValue, TargetValue>::apply(
+    const Matrix& W, const View<SourceValue, 2>& src, View<TargetValue, 2>& tgt, const Configuration& config) {
+    ATLAS_ASSERT(src.shape(0) >= W.cols());
+    ATLAS_ASSERT(tgt.shape(0) >= W.rows());
+
+    if (src.stride(1) != 1 || tgt.stride(1) != 1) {
+        SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 2, SourceValue, TargetValue>::apply(W, src, tgt,
+                                                                                                         config);
+        return;
+    }
+
+    const idx_t Nk         = src.shape(1);
+    const idx_t src_stride = src.stride(0);
+    const idx_t tgt_stride = tgt.stride(0);
+    dispatch_nonzeros(W, [&](auto nnz) {
+        constexpr int NNZ = decltype(nnz)::value;
+        for_each_partition(W, [&](idx_t r_begin, idx_t r_end) {
+            multiply_rows_levels<NNZ>(W, r_begin, r_end, src.data(), src_stride, tgt.data(), tgt_stride, Nk);
+        });
+    });
+}
+
+template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
+void SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_left, 3, SourceValue, TargetValue>::apply(
+    const Matrix& W, const View<SourceValue, 3>& src, View<TargetValue, 3>& tgt, const Configuration& config) {
+    if (src.contiguous() && tgt.contiguous()) {
+        auto src_v = View<SourceValue, 2>(src.data(), array::make_shape(src.shape(0), src.stride(0)));
+        auto tgt_v = View<TargetValue, 2>(tgt.data(), array::make_shape(tgt.shape(0), tgt.stride(0)));
+        SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_left, 2, SourceValue, TargetValue>::apply(
+            W, src_v, tgt_v, config);
+        return;
+    }
+    SparseMatrixMultiply<backend::openmp, Indexing::layout_left, 3, SourceValue, TargetValue>::apply(W, src, tgt,
+                                                                                                     config);
+}
+
+template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
+void SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_right, 1, SourceValue, TargetValue>::apply(
+    const Matrix& W, const View<SourceValue, 1>& src, View<TargetValue, 1>& tgt, const Configuration& config) {
+    SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_left, 1, SourceValue, TargetValue>::apply(W, src, tgt,
+                                                                                                            config);
+}
+
+template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
+void SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_right, 2, SourceValue, TargetValue>::apply(
+    const Matrix& W, const View<SourceValue, 2>& src, View<TargetValue, 2>& tgt, const Configuration& config) {
+    ATLAS_ASSERT(src.shape(1) >= W.cols());
+    ATLAS_ASSERT(tgt.shape(1) >= W.rows());
+
+    if (src.stride(1) != 1 || tgt.stride(1) != 1) {
+        SparseMatrixMultiply<backend::openmp, Indexing::layout_right, 2, SourceValue, TargetValue>::apply(W, src, tgt,
+                                                                                                          config);
+        return;
+    }
+
+    const idx_t Nk         = src.shape(0);
+    const idx_t src_stride = src.stride(0);
+    const idx_t tgt_stride = tgt.stride(0);
+    const idx_t row_block  = std::max<idx_t>(1, config.getInt("row_block", default_row_block));
+    dispatch_nonzeros(W, [&](auto nnz) {
+        constexpr int NNZ = decltype(nnz)::value;
+        for_each_partition(W, [&](idx_t r_begin, idx_t r_end) {
+            multiply_rows_blocked<NNZ>(W, r_begin, r_end, row_block, src.data(), src_stride, tgt.data(), tgt_stride,
+                                       Nk);
+        });
+    });
+}
+
+template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
+void SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_right, 3, SourceValue, TargetValue>::apply(
+    const Matrix& W, const View<SourceValue, 3>& src, View<TargetValue, 3>& tgt, const Configuration& config) {
+    if (src.contiguous() && tgt.contiguous()) {
+        // Merge the two outer dimensions into a single level dimension
+        auto src_v = View<SourceValue, 2>(src.data(), array::make_shape(src.shape(0) * src.shape(1), src.shape(2)));
+        auto tgt_v = View<TargetValue, 2>(tgt.data(), array::make_shape(tgt.shape(0) * tgt.shape(1), tgt.shape(2)));
+        SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_right, 2, SourceValue, TargetValue>::apply(
+            W, src_v, tgt_v, config);
+        return;
+    }
+    SparseMatrixMultiply<backend::openmp, Indexing::layout_right, 3, SourceValue, TargetValue>::apply(W, src, tgt,
+                                                                                                      config);
+}
+
+// Several fields, each with contiguous levels. Rows are processed in blocks, and each block is applied to all
+// fields in turn, so that the matrix entries of a block are read from memory once and reused from cache.
+template <typename SourceValue, typename TargetValue>
+template <typename Matrix>
+void SparseMatrixMultiplyFields<backend::openmp_blocked, SourceValue, TargetValue>::apply(
+    const Matrix& W, const std::vector<View<SourceValue, 2>>& src, std::vector<View<TargetValue, 2>>& tgt,
+    const Configuration& config) {
+    const size_t nb_fields = src.size();
+    ATLAS_ASSERT(tgt.size() == nb_fields);
+    for (size_t f = 0; f < nb_fields; ++f) {
+        ATLAS_ASSERT(src[f].shape(0) >= W.cols());
+        ATLAS_ASSERT(tgt[f].shape(0) >= W.rows());
+        ATLAS_ASSERT(src[f].shape(1) == tgt[f].shape(1));
+        if (src[f].stride(1) != 1 || tgt[f].stride(1) != 1) {
+            SparseMatrixMultiplyFields<backend::openmp, SourceValue, TargetValue>::apply(W, src, tgt, config);
+            return;
+        }
+    }
+
+    const idx_t row_block = std::max<idx_t>(1, config.getInt("row_block", default_row_block));
+    dispatch_nonzeros(W, [&](auto nnz) {
+        constexpr int NNZ = decltype(nnz)::value;
+        for_each_partition(W, [&](idx_t r_begin, idx_t r_end) {
+            for (idx_t rb_begin = r_begin; rb_begin < r_end; rb_begin += row_block) {
+                const idx_t rb_end = std::min(rb_begin + row_block, r_end);
+                for (size_t f = 0; f < nb_fields; ++f) {
+                    const auto& s = src[f];
+                    auto& t       = tgt[f];
+                    multiply_rows_levels<NNZ>(W, rb_begin, rb_end, s.data(), s.stride(0), t.data(), t.stride(0),
+                                              s.shape(1));
+                }
+            }
+        });
+    });
+}
+
+#define EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(INDEXING, RANK, MATRIX, TYPE)                                      \
+    template void SparseMatrixMultiply<backend::openmp_blocked, INDEXING, RANK, TYPE const, TYPE>::apply<MATRIX>( \
+        const MATRIX&, const View<TYPE const, RANK>&, View<TYPE, RANK>&, const Configuration&);
+
+#define EXPLICIT_TEMPLATE_INSTANTIATION_FIELDS(MATRIX, TYPE)                                           \
+    template void SparseMatrixMultiplyFields<backend::openmp_blocked, TYPE const, TYPE>::apply<MATRIX>(   \
+        const MATRIX&, const std::vector<View<TYPE const, 2>>&, std::vector<View<TYPE, 2>>&, const Configuration&);
+
+#define EXPLICIT_TEMPLATE_INSTANTIATION_MATRIX(MATRIX, TYPE)                          \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_left, 1, MATRIX, TYPE)  \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_left, 2, MATRIX, TYPE)  \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_left, 3, MATRIX, TYPE)  \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_right, 1, MATRIX, TYPE) \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_right, 2, MATRIX, TYPE) \
+    EXPLICIT_TEMPLATE_INSTANTIATION_APPLY(Indexing::layout_right, 3, MATRIX, TYPE) \
+    EXPLICIT_TEMPLATE_INSTANTIATION_FIELDS(MATRIX, TYPE)
+
+#define EXPLICIT_TEMPLATE_INSTANTIATION(TYPE)                         \
+    EXPLICIT_TEMPLATE_INSTANTIATION_MATRIX(SparseMatrix, TYPE)        \
+    EXPLICIT_TEMPLATE_INSTANTIATION_MATRIX(CompactSparseMatrix, TYPE)
+
+EXPLICIT_TEMPLATE_INSTANTIATION(double)
+EXPLICIT_TEMPLATE_INSTANTIATION(float)
+
+}  // namespace sparse
+}  // namespace linalg
+}  // namespace atlas
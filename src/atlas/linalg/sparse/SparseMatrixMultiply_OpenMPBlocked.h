@@ -0,0 +1,79 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include "atlas/linalg/sparse/SparseMatrixMultiply.h"
+
+namespace atlas {
+namespace linalg {
+namespace sparse {
+
+// Sparse matrix multiply backend "openmp_blocked", optimised for the application of interpolation
+// matrices to multi-level fields:
+//   - rows are distributed over threads in contiguous ranges of equal number of non-zeros
+//   - inner loops run over contiguous levels and are vectorised
+//   - for Indexing::layout_right, rows are processed in cache blocks while sweeping over levels
+//   - matrices with a fixed number of non-zeros per row (4: bilinear, 16: bicubic) use unrolled kernels
+// Configuration:
+//   - "row_block" : number of rows per cache block (default 64)
+
+template <typename SourceValue, typename TargetValue>
+struct SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_left, 1, SourceValue, TargetValue> {
+    template <typename Matrix>
+    static void apply(const Matrix& W, const View<SourceValue, 1>& src, View<TargetValue, 1>& tgt,
+                      const Configuration&);
+};
+
+template <typename SourceValue, typename TargetValue>
+struct SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_left, 2, SourceValue, TargetValue> {
+    template <typename Matrix>
+    static void apply(const Matrix& W, const View<SourceValue, 2>& src, View<TargetValue, 2>& tgt,
+                      const Configuration&);
+};
+
+template <typename SourceValue, typename TargetValue>
+struct SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_left, 3, SourceValue, TargetValue> {
+    template <typename Matrix>
+    static void apply(const Matrix& W, const View<SourceValue, 3>& src, View<TargetValue, 3>& tgt,
+                      const Configuration&);
+};
+
+template <typename SourceValue, typename TargetValue>
+struct SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_right, 1, SourceValue, TargetValue> {
+    template <typename Matrix>
+    static void apply(const Matrix& W, const View<SourceValue, 1>& src, View<TargetValue, 1>& tgt,
+                      const Configuration&);
+};
+
+template <typename SourceValue, typename TargetValue>
+struct SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_right, 2, SourceValue, TargetValue> {
+    template <typename Matrix>
+    static void apply(const Matrix& W, const View<SourceValue, 2>& src, View<TargetValue, 2>& tgt,
+                      const Configuration&);
+};
+
+template <typename SourceValue, typename TargetValue>
+struct SparseMatrixMultiply<backend::openmp_blocked, Indexing::layout_right, 3, SourceValue, TargetValue> {
+    template <typename Matrix>
+    static void apply(const Matrix& W, const View<SourceValue, 3>& src, View<TargetValue, 3>& tgt,
+                      const Configuration&);
+};
+
+template <typename SourceValue, typename TargetValue>
+struct SparseMatrixMultiplyFields<backend::openmp_blocked, SourceValue, TargetValue> {
+    template <typename Matrix>
+    static void apply(const Matrix& W, const std::vector<View<SourceValue, 2>>& src,
+                      std::vector<View<TargetValue, 2>>& tgt, const Configuration&);
+};
+
+}  // namespace sparse
+}  // namespace linalg
+}  // namespace atlas
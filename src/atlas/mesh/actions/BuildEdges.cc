@@ -34,8 +34,11 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/detail/AccumulateFacets.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/sort.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/LonLatMicroDeg.h"
 #include "atlas/util/MicroDeg.h"
@@ -61,8 +64,25 @@ struct Sort {
     }
     gidx_t g;
     idx_t i;
-    bool operator<(const Sort& other) const { return (g < other.g); }
+    // Ties are ordered by index, so that the sorted order does not depend on the sorting algorithm or number of threads
+    bool operator<(const Sort& other) const { return (g < other.g) || (g == other.g && i < other.i); }
 };
+
+// Sort edges by unique id computed from its nodes, for bit-reproducibility
+std::vector<Sort> sort_edges_by_uid(const Mesh& mesh) {
+    ATLAS_TRACE();
+    const idx_t nb_edges                                             = mesh.edges().size();
+    const mesh::HybridElements::Connectivity& edge_node_connectivity = mesh.edges().node_connectivity();
+
+    UniqueLonLat compute_uid(mesh);
+
+    std::vector<Sort> edge_sort(nb_edges);
+    atlas_omp_parallel_for(idx_t jedge = 0; jedge < nb_edges; ++jedge) {
+        edge_sort[jedge] = Sort(compute_uid(edge_node_connectivity.row(jedge)), jedge);
+    }
+    omp::sort(edge_sort.begin(), edge_sort.end());
+    return edge_sort;
+}
 }  // anonymous namespace
 
 void build_element_to_edge_connectivity(Mesh& mesh) {
@@ -87,17 +107,7 @@ void build_element_to_edge_connectivity(Mesh& mesh) {
     auto is_pole_edge = [&](idx_t e) { return Topology::check(edge_flags(e), Topology::POLE); };
 
     // Sort edges for bit-reproducibility
-    std::vector<Sort> edge_sort;
-    edge_sort.reserve(nb_edges);
-    {
-        UniqueLonLat compute_uid(mesh);
-
-        for (idx_t jedge = 0; jedge < nb_edges; ++jedge) {
-            edge_sort.emplace_back(Sort(compute_uid(edge_node_connectivity.row(jedge)), jedge));
-        }
-
-        std::sort(edge_sort.data(), edge_sort.data() + nb_edges);
-    }
+    const std::vector<Sort> edge_sort = sort_edges_by_uid(mesh);
 
     // Fill in cell_edge_connectivity
     std::vector<idx_t> edge_cnt(mesh.cells().size());
@@ -155,7 +165,9 @@ void build_element_to_edge_connectivity(Mesh& mesh) {
 }
 
 void build_node_to_edge_connectivity(Mesh& mesh) {
+    ATLAS_TRACE();
     mesh::Nodes& nodes   = mesh.nodes();
+    const idx_t nb_nodes = nodes.size();
     const idx_t nb_edges = mesh.edges().size();
 
     mesh::Nodes::Connectivity& node_to_edge = nodes.edge_connectivity();
@@ -163,34 +175,44 @@ void build_node_to_edge_connectivity(Mesh& mesh) {
 
     const mesh::HybridElements::Connectivity& edge_node_connectivity = mesh.edges().node_connectivity();
 
-    std::vector<idx_t> to_edge_size(nodes.size(), 0);
+    std::vector<idx_t> to_edge_size(nb_nodes, 0);
     for (idx_t jedge = 0; jedge < nb_edges; ++jedge) {
         for (idx_t j = 0; j < 2; ++j) {
             ++to_edge_size[edge_node_connectivity(jedge, j)];
         }
     }
 
-    node_to_edge.add(nodes.size(), to_edge_size.data());
+    node_to_edge.add(nb_nodes, to_edge_size.data());
 
-    for (idx_t jnode = 0; jnode < nodes.size(); ++jnode) {
-        to_edge_size[jnode] = 0;
+    // Edges of each node are ordered by their position in the edges sorted by uid
+    const std::vector<Sort> edge_sort = sort_edges_by_uid(mesh);
+    std::vector<idx_t> edge_order(nb_edges);
+    atlas_omp_parallel_for(idx_t jedge = 0; jedge < nb_edges; ++jedge) {
+        edge_order[edge_sort[jedge].i] = jedge;
     }
 
-    UniqueLonLat compute_uid(mesh);
-    std::vector<Sort> edge_sort(nb_edges);
-    for (idx_t jedge = 0; jedge < nb_edges; ++jedge) {
-        edge_sort[jedge] = Sort(compute_uid(edge_node_connectivity.row(jedge)), jedge);
+    // Gather the edges of each node in any order, then order each node's edges.
+    std::vector<idx_t> displs(nb_nodes + 1, 0);
+    for (idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
+        displs[jnode + 1]   = displs[jnode] + to_edge_size[jnode];
+        to_edge_size[jnode] = 0;
     }
-    std::stable_sort(edge_sort.data(), edge_sort.data() + nb_edges);
-
-    for (idx_t jedge = 0; jedge < nb_edges; ++jedge) {
-        idx_t iedge = edge_sort[jedge].i;
-        ATLAS_ASSERT(iedge < nb_edges);
+    std::vector<idx_t> node_edges(displs[nb_nodes]);
+    atlas_omp_parallel_for(idx_t jedge = 0; jedge < nb_edges; ++jedge) {
         for (idx_t j = 0; j < 2; ++j) {
-            idx_t node = edge_node_connectivity(iedge, j);
-            node_to_edge.set(node, to_edge_size[node]++, iedge);
+            idx_t node = edge_node_connectivity(jedge, j);
+            idx_t n;
+            atlas_omp_pragma(omp atomic capture)
+            n = to_edge_size[node]++;
+            node_edges[displs[node] + n] = jedge;
         }
     }
+    atlas_omp_parallel_for(idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
+        auto first = node_edges.begin() + displs[jnode];
+        auto last  = node_edges.begin() + displs[jnode + 1];
+        std::sort(first, last, [&edge_order](idx_t a, idx_t b) { return edge_order[a] < edge_order[b]; });
+        node_to_edge.set(jnode, node_edges.data() + displs[jnode]);
+    }
 }
 
 class AccumulatePoleEdges {
@@ -398,8 +420,8 @@ void build_edges(Mesh& mesh, const eckit::Configuration& config) {
                 idx_t lowest_node_idx = std::min(edge_nodes_data.at(2 * iedge + 0), edge_nodes_data.at(2 * iedge + 1));
                 sorted_edges_by_lowest_node_index.emplace_back(lowest_node_idx, e);
             }
-            std::sort(sorted_edges_by_lowest_node_index.begin(), sorted_edges_by_lowest_node_index.end());
-            for (idx_t e = edge_start; e < edge_end; ++e) {
+            omp::sort(sorted_edges_by_lowest_node_index.begin(), sorted_edges_by_lowest_node_index.end());
+            atlas_omp_parallel_for(idx_t e = edge_start; e < edge_end; ++e) {
                 const idx_t iedge = edge_halo_offsets[halo] + (e - edge_start);
                 const idx_t sedge =
                     edge_halo_offsets[halo] + (sorted_edges_by_lowest_node_index[e - edge_start].second - edge_start);
@@ -409,7 +431,7 @@ void build_edges(Mesh& mesh, const eckit::Configuration& config) {
                 sorted_edge_to_elem_data[2 * iedge + 1] = edge_to_elem_data[2 * sedge + 1];
             }
 
-            for (idx_t e = edge_start; e < edge_end; ++e) {
+            atlas_omp_parallel_for(idx_t e = edge_start; e < edge_end; ++e) {
                 const idx_t iedge                = edge_halo_offsets[halo] + (e - edge_start);
                 edge_nodes_data[2 * iedge + 0]   = sorted_edge_nodes_data[2 * iedge + 0];
                 edge_nodes_data[2 * iedge + 1]   = sorted_edge_nodes_data[2 * iedge + 1];
@@ -433,7 +455,15 @@ void build_edges(Mesh& mesh, const eckit::Configuration& config) {
         auto edge_flags   = array::make_view<int, 1>(mesh.edges().flags());
 
         ATLAS_ASSERT(cell_nodes.missing_value() == missing_value);
+        // Checked before the parallel loop, where a failed assertion cannot be propagated as an exception
         for (idx_t edge = edge_start; edge < edge_end; ++edge) {
+            const idx_t iedge = edge_halo_offsets[halo] + (edge - edge_start);
+            ATLAS_ASSERT(idx_t(edge_nodes(edge, 0)) < nb_nodes);
+            ATLAS_ASSERT(idx_t(edge_nodes(edge, 1)) < nb_nodes);
+            ATLAS_ASSERT(edge_to_elem_data[2 * iedge + 0] != cell_nodes.missing_value());
+        }
+        // Each edge is independent of the others, and compute_uid is thread-safe
+        atlas_omp_parallel_for(idx_t edge = edge_start; edge < edge_end; ++edge) {
             const idx_t iedge = edge_halo_offsets[halo] + (edge - edge_start);
             const int ip1     = edge_nodes(edge, 0);
             const int ip2     = edge_nodes(edge, 1);
@@ -442,8 +472,6 @@ void build_edges(Mesh& mesh, const eckit::Configuration& config) {
                 edge_nodes.set(edge, swapped);
             }
 
-            ATLAS_ASSERT(idx_t(edge_nodes(edge, 0)) < nb_nodes);
-            ATLAS_ASSERT(idx_t(edge_nodes(edge, 1)) < nb_nodes);
             edge_glb_idx(edge) = compute_uid(edge_nodes.row(edge));
             edge_part(edge)    = std::min(node_part(edge_nodes(edge, 0)), node_part(edge_nodes(edge, 1)));
             edge_ridx(edge)    = edge;
@@ -453,7 +481,6 @@ void build_edges(Mesh& mesh, const eckit::Configuration& config) {
             const idx_t e1 = edge_to_elem_data[2 * iedge + 0];
             const idx_t e2 = edge_to_elem_data[2 * iedge + 1];
 
-            ATLAS_ASSERT(e1 != cell_nodes.missing_value());
             if (e2 == cell_nodes.missing_value()) {
                 // do nothing
             }
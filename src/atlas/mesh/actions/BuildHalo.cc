@@ -8,14 +8,14 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <numeric>
 #include <stdexcept>
-#include <unordered_map>
-#include <unordered_set>
 
 #include "atlas/array.h"
 #include "atlas/array/IndexView.h"
@@ -28,6 +28,7 @@
 #include "atlas/mesh/actions/BuildHalo.h"
 #include "atlas/mesh/actions/BuildParallelFields.h"
 #include "atlas/mesh/detail/AccumulateFacets.h"
+#include "atlas/parallel/GlobalIndexRenumbering.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/parallel/omp/omp.h"
@@ -40,6 +41,7 @@
 #include "atlas/util/MicroDeg.h"
 #include "atlas/util/PeriodicTransform.h"
 #include "atlas/util/Unique.h"
+#include "atlas/util/detail/FlatHashMap.h"
 
 //#define DEBUG_OUTPUT
 #ifdef DEBUG_OUTPUT
@@ -62,16 +64,6 @@ namespace atlas {
 namespace mesh {
 namespace actions {
 
-struct Entity {
-    Entity(gidx_t gid, idx_t idx) {
-        g = gid;
-        i = idx;
-    }
-    gidx_t g;
-    idx_t i;
-    bool operator<(const Entity& other) const { return (g < other.g); }
-};
-
 void make_nodes_global_index_human_readable(const mesh::actions::BuildHalo& build_halo, mesh::Nodes& nodes,
                                             bool do_all) {
     ATLAS_TRACE();
@@ -80,10 +72,6 @@ void make_nodes_global_index_human_readable(const mesh::actions::BuildHalo& buil
     // uid,
     //     and could receive different gidx for different tasks
 
-    // unused // int mypart = mpi::rank();
-    int nparts  = mpi::size();
-    size_t root = 0;
-
     array::ArrayView<gidx_t, 1> nodes_glb_idx = array::make_view<gidx_t, 1>(nodes.global_index());
     // nodes_glb_idx.dump( Log::info() );
     //  ATLAS_DEBUG( "min = " << nodes.global_index().metadata().getLong("min") );
@@ -133,50 +121,7 @@ void make_nodes_global_index_human_readable(const mesh::actions::BuildHalo& buil
     //    }
     //  }
 
-    // 1) Gather all global indices, together with location
-
-    std::vector<int> recvcounts(mpi::size());
-    std::vector<int> recvdispls(mpi::size());
-
-    ATLAS_TRACE_MPI(GATHER) { mpi::comm().gather(nb_nodes, recvcounts, root); }
-    idx_t glb_nb_nodes = std::accumulate(recvcounts.begin(), recvcounts.end(), 0);
-
-    recvdispls[0] = 0;
-    for (int jpart = 1; jpart < nparts; ++jpart) {  // start at 1
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-
-    std::vector<gidx_t> glb_idx_gathered(glb_nb_nodes);
-    ATLAS_TRACE_MPI(GATHER) {
-        mpi::comm().gatherv(glb_idx.data(), glb_idx.size(), glb_idx_gathered.data(), recvcounts.data(),
-                            recvdispls.data(), root);
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Entity> node_sort;
-    node_sort.reserve(glb_nb_nodes);
-    const idx_t nb_glb_idx_gathered = static_cast<idx_t>(glb_idx_gathered.size());
-    for (idx_t jnode = 0; jnode < nb_glb_idx_gathered; ++jnode) {
-        node_sort.emplace_back(glb_idx_gathered[jnode], jnode);
-    }
-
-    ATLAS_TRACE_SCOPE("sort on rank 0") { std::sort(node_sort.begin(), node_sort.end()); }
-
-    gidx_t gid               = glb_idx_max + 1;
-    const idx_t nb_node_sort = static_cast<idx_t>(node_sort.size());
-    for (idx_t jnode = 0; jnode < nb_node_sort; ++jnode) {
-        if (jnode > 0 && node_sort[jnode].g != node_sort[jnode - 1].g) {
-            ++gid;
-        }
-        int inode               = node_sort[jnode].i;
-        glb_idx_gathered[inode] = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI(SCATTER) {
-        mpi::comm().scatterv(glb_idx_gathered.data(), recvcounts.data(), recvdispls.data(), glb_idx.data(),
-                             static_cast<int>(glb_idx.size()), root);
-    }
+    parallel::renumber_global_index(glb_idx, glb_idx_max);
 
     for (int jnode = 0; jnode < nb_nodes; ++jnode) {
         nodes_glb_idx(points_to_edit[jnode]) = glb_idx[jnode];
@@ -193,9 +138,6 @@ void make_cells_global_index_human_readable(const mesh::actions::BuildHalo& buil
                                             bool do_all) {
     ATLAS_TRACE();
 
-    int nparts = static_cast<idx_t>(mpi::size());
-    idx_t root = 0;
-
     array::ArrayView<gidx_t, 1> cells_glb_idx = array::make_view<gidx_t, 1>(cells.global_index());
     //  ATLAS_DEBUG( "min = " << cells.global_index().metadata().getLong("min") );
     //  ATLAS_DEBUG( "max = " << cells.global_index().metadata().getLong("max") );
@@ -234,48 +176,7 @@ void make_cells_global_index_human_readable(const mesh::actions::BuildHalo& buil
         glb_idx[i] = cells_glb_idx(cells_to_edit[i]);
     }
 
-    // 1) Gather all global indices, together with location
-
-    std::vector<int> recvcounts(mpi::size());
-    std::vector<int> recvdispls(mpi::size());
-
-    ATLAS_TRACE_MPI(GATHER) { mpi::comm().gather(nb_cells, recvcounts, root); }
-    idx_t glb_nb_cells = std::accumulate(recvcounts.begin(), recvcounts.end(), 0);
-
-    recvdispls[0] = 0;
-    for (int jpart = 1; jpart < nparts; ++jpart) {  // start at 1
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-
-    std::vector<gidx_t> glb_idx_gathered(glb_nb_cells);
-    ATLAS_TRACE_MPI(GATHER) {
-        mpi::comm().gatherv(glb_idx.data(), glb_idx.size(), glb_idx_gathered.data(), recvcounts.data(),
-                            recvdispls.data(), root);
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Entity> cell_sort;
-    cell_sort.reserve(glb_nb_cells);
-    for (idx_t jcell = 0; jcell < glb_nb_cells; ++jcell) {
-        cell_sort.emplace_back(glb_idx_gathered[jcell], jcell);
-    }
-
-    ATLAS_TRACE_SCOPE("sort on rank 0") { std::sort(cell_sort.begin(), cell_sort.end()); }
-
-    gidx_t gid = glb_idx_max + 1;
-    for (idx_t jcell = 0; jcell < glb_nb_cells; ++jcell) {
-        if (jcell > 0 && cell_sort[jcell].g != cell_sort[jcell - 1].g) {
-            ++gid;
-        }
-        idx_t icell             = cell_sort[jcell].i;
-        glb_idx_gathered[icell] = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI(SCATTER) {
-        mpi::comm().scatterv(glb_idx_gathered.data(), recvcounts.data(), recvdispls.data(), glb_idx.data(),
-                             static_cast<int>(glb_idx.size()), root);
-    }
+    parallel::renumber_global_index(glb_idx, glb_idx_max);
 
     for (int jcell = 0; jcell < nb_cells; ++jcell) {
         cells_glb_idx(cells_to_edit[jcell]) = glb_idx[jcell];
@@ -340,8 +241,6 @@ void build_lookup_node2elem(const Mesh& mesh, Node2Elem& node2elem) {
 void accumulate_partition_bdry_nodes_old(Mesh& mesh, std::vector<idx_t>& bdry_nodes) {
     ATLAS_TRACE();
 
-    std::set<idx_t> bdry_nodes_set;
-
     std::vector<idx_t> facet_nodes;
     std::vector<idx_t> connectivity_facet_to_elem;
 
@@ -360,15 +259,17 @@ void accumulate_partition_bdry_nodes_old(Mesh& mesh, std::vector<idx_t>& bdry_no
         /*out*/ nb_inner_facets,
         /*out*/ missing_value);
 
+    bdry_nodes.clear();
     for (idx_t jface = 0; jface < nb_facets; ++jface) {
         if (connectivity_facet_to_elem[jface * 2 + 1] == missing_value) {
             for (idx_t jnode = 0; jnode < 2; ++jnode)  // 2 nodes per face
             {
-                bdry_nodes_set.insert(facet_nodes[jface * 2 + jnode]);
+                bdry_nodes.push_back(facet_nodes[jface * 2 + jnode]);
             }
         }
     }
-    bdry_nodes = std::vector<idx_t>(bdry_nodes_set.begin(), bdry_nodes_set.end());
+    std::sort(bdry_nodes.begin(), bdry_nodes.end());
+    bdry_nodes.erase(std::unique(bdry_nodes.begin(), bdry_nodes.end()), bdry_nodes.end());
 }
 
 void accumulate_partition_bdry_nodes(Mesh& mesh, idx_t halo, std::vector<idx_t>& bdry_nodes) {
@@ -432,7 +333,14 @@ private:
     std::vector<std::string> notes;
 };
 
-using Uid2Node = std::unordered_map<uid_t, idx_t>;
+using Uid2Node = util::detail::FlatHashMap<uid_t, idx_t>;
+using UidSet   = util::detail::FlatHashSet<uid_t>;
+
+/// Lookup tables used by BuildHaloHelper, kept alive over all halo levels so that their memory is reused
+struct HaloLookups {
+    Uid2Node uid2node;
+    UidSet new_uid;
+};
 
 
 void build_lookup_uid2node(Mesh& mesh, Uid2Node& uid2node) {
@@ -446,11 +354,12 @@ void build_lookup_uid2node(Mesh& mesh, Uid2Node& uid2node) {
     UniqueLonLat compute_uid(mesh);
 
     uid2node.clear();
+    uid2node.reserve(nb_nodes);
     for (idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
         uid_t uid     = compute_uid(jnode);
-        bool inserted = uid2node.insert(std::make_pair(uid, jnode)).second;
-        if (not inserted) {
-                int other = uid2node[uid];
+        auto inserted = uid2node.insert(uid, jnode);
+        if (not inserted.second) {
+                int other = *inserted.first;
                 std::stringstream msg;
                 msg << std::setprecision(10) << std::fixed << "Node uid: " << uid << "   " << glb_idx(jnode) << " xy("
                     << xy(jnode, XX) << "," << xy(jnode, YY) << ")";
@@ -475,7 +384,7 @@ void build_lookup_uid2node(Mesh& mesh, Uid2Node& uid2node) {
 /// For given nodes, find new connected elements
 void accumulate_elements(const Mesh& mesh, const mpi::BufferView<uid_t>& request_node_uid, const Uid2Node& uid2node,
                          const Node2Elem& node2elem, std::vector<idx_t>& found_elements,
-                         std::set<uid_t>& new_nodes_uid) {
+                         std::vector<uid_t>& new_nodes_uid) {
 
     ATLAS_TRACE();
     const mesh::HybridElements::Connectivity& elem_nodes = mesh.cells().node_connectivity();
@@ -485,45 +394,54 @@ void accumulate_elements(const Mesh& mesh, const mpi::BufferView<uid_t>& request
     const idx_t nb_request_nodes = static_cast<idx_t>(request_node_uid.size());
     const int mpi_rank           = static_cast<int>(mpi::rank());
 
-    std::unordered_set<idx_t> found_elements_set;
-    found_elements_set.reserve(nb_request_nodes*2);
+    found_elements.clear();
+    found_elements.reserve(nb_request_nodes * 2);
 
     for (idx_t jnode = 0; jnode < nb_request_nodes; ++jnode) {
         uid_t uid = request_node_uid(jnode);
 
         idx_t inode = -1;
         // search and get node index for uid
-        auto found = uid2node.find(uid);
-        if (found != uid2node.end()) {
-            inode = found->second;
+        const idx_t* found = uid2node.find(uid);
+        if (found) {
+            inode = *found;
         }
         if (inode != -1 && inode < nb_nodes) {
             for (const idx_t e : node2elem[inode]) {
                 if (elem_part(e) == mpi_rank) {
-                    found_elements_set.insert(e);
+                    found_elements.push_back(e);
                 }
             }
         }
     }
 
-    // found_bdry_elements_set now contains elements for the nodes
-    found_elements = std::vector<idx_t>(found_elements_set.begin(), found_elements_set.end());
+    // Remove elements found for multiple nodes
+    std::sort(found_elements.begin(), found_elements.end());
+    found_elements.erase(std::unique(found_elements.begin(), found_elements.end()), found_elements.end());
 
     UniqueLonLat compute_uid(mesh);
 
-    // Collect all nodes
-    new_nodes_uid.clear();
+    // Collect all nodes, sorted and unique
+    std::vector<uid_t> elem_nodes_uid;
     for (const idx_t e : found_elements) {
         idx_t nb_elem_nodes = elem_nodes.cols(e);
         for (idx_t n = 0; n < nb_elem_nodes; ++n) {
-            new_nodes_uid.insert(compute_uid(elem_nodes(e, n)));
+            elem_nodes_uid.push_back(compute_uid(elem_nodes(e, n)));
         }
     }
+    std::sort(elem_nodes_uid.begin(), elem_nodes_uid.end());
+    elem_nodes_uid.erase(std::unique(elem_nodes_uid.begin(), elem_nodes_uid.end()), elem_nodes_uid.end());
 
     // Remove nodes we already have in the request-buffer
+    std::vector<uid_t> request_uid(nb_request_nodes);
     for (idx_t jnode = 0; jnode < nb_request_nodes; ++jnode) {
-        new_nodes_uid.erase(request_node_uid(jnode));
+        request_uid[jnode] = request_node_uid(jnode);
     }
+    std::sort(request_uid.begin(), request_uid.end());
+
+    new_nodes_uid.clear();
+    std::set_difference(elem_nodes_uid.begin(), elem_nodes_uid.end(), request_uid.begin(), request_uid.end(),
+                        std::back_inserter(new_nodes_uid));
 }
 
 class BuildHaloHelper {
@@ -645,12 +563,13 @@ public:
 
     std::vector<idx_t> bdry_nodes;
     Node2Elem node_to_elem;
-    Uid2Node uid2node;
+    Uid2Node& uid2node;
+    UidSet& new_uid;
     UniqueLonLat compute_uid;
     idx_t halosize;
 
 public:
-    BuildHaloHelper(BuildHalo& builder, Mesh& _mesh):
+    BuildHaloHelper(BuildHalo& builder, Mesh& _mesh, HaloLookups& lookups):
         builder_(builder),
         mesh(_mesh),
         xy(array::make_view<double, 2>(mesh.nodes().xy())),
@@ -666,7 +585,10 @@ public:
         elem_ridx(array::make_indexview<idx_t, 1>(mesh.cells().remote_index())),
         elem_flags(array::make_view<int, 1>(mesh.cells().flags())),
         elem_glb_idx(array::make_view<gidx_t, 1>(mesh.cells().global_index())),
+        uid2node(lookups.uid2node),
+        new_uid(lookups.new_uid),
         compute_uid(mesh) {
+        uid2node.clear();
         halosize = 0;
         mesh.metadata().get("halo", halosize);
         // update();
@@ -705,11 +627,11 @@ public:
         idx_t jnode = 0;
         typename NodeContainer::const_iterator it;
         for (it = nodes_uid.begin(); it != nodes_uid.end(); ++it, ++jnode) {
-            uid_t uid = *it;
-            auto found = uid2node.find(uid);
-            if (found != uid2node.end())  // Point exists inside domain
+            uid_t uid          = *it;
+            const idx_t* found = uid2node.find(uid);
+            if (found)  // Point exists inside domain
             {
-                idx_t node                     = found->second;
+                idx_t node                     = *found;
                 buf.node_glb_idx[p][jnode]     = glb_idx(node);
                 buf.node_part[p][jnode]        = part(node);
                 buf.node_ridx[p][jnode]        = ridx(node);
@@ -773,10 +695,10 @@ public:
         for (it = nodes_uid.begin(); it != nodes_uid.end(); ++it, ++jnode) {
             uid_t uid = *it;
 
-            auto found = uid2node.find(uid);
-            if (found != uid2node.end())  // Point exists inside domain
+            const idx_t* found = uid2node.find(uid);
+            if (found)  // Point exists inside domain
             {
-                int node                       = found->second;
+                int node                       = *found;
                 buf.node_part[p][jnode]        = part(node);
                 buf.node_ridx[p][jnode]        = ridx(node);
                 buf.node_xy[p][jnode * 2 + XX] = xy(node, XX);
@@ -841,7 +763,8 @@ public:
         // Nodes might be duplicated from different Tasks. We need to identify
         // unique entries
         std::vector<uid_t> node_uid(nb_nodes);
-        std::set<uid_t> new_node_uid;
+        UidSet& new_node_uid = new_uid;
+        new_node_uid.clear();
         {
             ATLAS_TRACE("compute node_uid");
             for (int jnode = 0; jnode < nb_nodes; ++jnode) {
@@ -853,7 +776,7 @@ public:
             std::vector<uid_t>::iterator it = std::lower_bound(node_uid.begin(), node_uid.end(), uid);
             bool not_found                  = (it == node_uid.end() || uid < *it);
             if (not_found) {
-                bool inserted = new_node_uid.insert(uid).second;
+                bool inserted = new_node_uid.insert(uid);
                 return not inserted;
             }
             else {
@@ -920,10 +843,10 @@ public:
 
                 // make sure new node was not already there
                 {
-                    uid_t uid                = compute_uid(loc_idx);
-                    auto found = uid2node.find(uid);
-                    if (found != uid2node.end()) {
-                        int other = found->second;
+                    uid_t uid          = compute_uid(loc_idx);
+                    const idx_t* found = uid2node.find(uid);
+                    if (found) {
+                        int other = *found;
                         std::stringstream msg;
                         msg << "New node loc " << loc_idx << " with uid " << uid << ":\n"
                             << glb_idx(loc_idx) << "(" << xy(loc_idx, XX) << "," << xy(loc_idx, YY) << ")\n";
@@ -948,7 +871,8 @@ public:
         int nb_elems = mesh.cells().size();
         //    std::set<uid_t> elem_uid;
         std::vector<uid_t> elem_uid(2 * nb_elems);
-        std::set<uid_t> new_elem_uid;
+        UidSet& new_elem_uid = new_uid;
+        new_elem_uid.clear();
         {
             ATLAS_TRACE("compute elem_uid");
             atlas_omp_parallel_for (int jelem = 0; jelem < nb_elems; ++jelem) {
@@ -961,7 +885,7 @@ public:
             std::vector<uid_t>::iterator it = std::lower_bound(elem_uid.begin(), elem_uid.end(), uid);
             bool not_found                  = (it == elem_uid.end() || uid < *it);
             if (not_found) {
-                bool inserted = new_elem_uid.insert(uid).second;
+                bool inserted = new_elem_uid.insert(uid);
                 return not inserted;
             }
             else {
@@ -1232,7 +1156,7 @@ void increase_halo_interior(BuildHaloHelper& helper) {
         mpi::BufferView<uid_t> recv_bdry_nodes_uid = recv_bdry_nodes_uid_from_parts[jpart];
 
         std::vector<idx_t> found_bdry_elems;
-        std::set<uid_t> found_bdry_nodes_uid;
+        std::vector<uid_t> found_bdry_nodes_uid;
 
         accumulate_elements(helper.mesh, recv_bdry_nodes_uid, helper.uid2node, helper.node_to_elem, found_bdry_elems,
                             found_bdry_nodes_uid);
@@ -1349,7 +1273,7 @@ void increase_halo_periodic(BuildHaloHelper& helper, const PeriodicPoints& perio
         atlas::mpi::BufferView<uid_t> recv_bdry_nodes_uid = recv_bdry_nodes_uid_from_parts[jpart];
 
         std::vector<idx_t> found_bdry_elems;
-        std::set<uid_t> found_bdry_nodes_uid;
+        std::vector<uid_t> found_bdry_nodes_uid;
 
         accumulate_elements(helper.mesh, recv_bdry_nodes_uid, helper.uid2node, helper.node_to_elem, found_bdry_elems,
                             found_bdry_nodes_uid);
@@ -1400,11 +1324,13 @@ void BuildHalo::operator()(int nb_elems) {
 
     ATLAS_TRACE("Increasing mesh halo");
 
+    HaloLookups lookups;
+
     for (int jhalo = halo; jhalo < nb_elems; ++jhalo) {
         Log::debug() << "Increase halo " << jhalo + 1 << std::endl;
         idx_t nb_nodes_before_halo_increase = mesh_.nodes().size();
 
-        BuildHaloHelper helper(*this, mesh_);
+        BuildHaloHelper helper(*this, mesh_, lookups);
 
         ATLAS_TRACE_SCOPE("increase_halo_interior") { increase_halo_interior(helper); }
 
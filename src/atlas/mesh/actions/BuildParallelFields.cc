@@ -14,6 +14,7 @@
 #include <iostream>
 #include <stdexcept>
 
+
 #include "atlas/array.h"
 #include "atlas/array/ArrayView.h"
 #include "atlas/array/IndexView.h"
@@ -23,6 +24,7 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildParallelFields.h"
 #include "atlas/parallel/GatherScatter.h"
+#include "atlas/parallel/GlobalIndexRenumbering.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Exception.h"
@@ -31,6 +33,7 @@
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/PeriodicTransform.h"
 #include "atlas/util/Unique.h"
+#include "atlas/util/detail/FlatHashMap.h"
 
 #define EDGE(jedge)                                                                               \
     "Edge(" << node_gidx(edge_nodes(jedge, 0)) << "[p" << node_part(edge_nodes(jedge, 0)) << "] " \
@@ -76,22 +79,6 @@ Field& build_edges_global_idx(Mesh& mesh);
 
 using uid_t = gidx_t;
 
-namespace {
-
-struct Node {
-    Node(gidx_t gid, idx_t idx) {
-        g = gid;
-        i = idx;
-    }
-    gidx_t g;
-    idx_t i;
-    bool operator<(const Node& other) const { return (g < other.g); }
-};
-
-}  // namespace
-
-//----------------------------------------------------------------------------------------------------------------------
-
 void build_parallel_fields(Mesh& mesh) {
     ATLAS_TRACE();
     build_nodes_parallel_fields(mesh);
@@ -170,10 +157,6 @@ void renumber_nodes_glb_idx(mesh::Nodes& nodes) {
 
     UniqueLonLat compute_uid(nodes);
 
-    // unused // int mypart = mpi::rank();
-    int nparts = mpi::size();
-    idx_t root = 0;
-
     array::ArrayView<gidx_t, 1> glb_idx = array::make_view<gidx_t, 1>(nodes.global_index());
 
     /*
@@ -189,63 +172,12 @@ void renumber_nodes_glb_idx(mesh::Nodes& nodes) {
         }
     }
 
-    // 1) Gather all global indices, together with location
-    array::ArrayT<uid_t> loc_id_arr(nb_nodes);
-    array::ArrayView<uid_t, 1> loc_id = array::make_view<uid_t, 1>(loc_id_arr);
+    // Renumber from 1 to the global number of nodes, following the global order of uid
+    std::vector<gidx_t> loc_id(glb_idx.data(), glb_idx.data() + nb_nodes);
+    parallel::renumber_global_index(loc_id);
 
     for (int jnode = 0; jnode < nb_nodes; ++jnode) {
-        loc_id(jnode) = glb_idx(jnode);
-    }
-
-    std::vector<int> recvcounts(mpi::size());
-    std::vector<int> recvdispls(mpi::size());
-
-    ATLAS_TRACE_MPI(GATHER) { mpi::comm().gather(nb_nodes, recvcounts, root); }
-
-    recvdispls[0] = 0;
-    for (int jpart = 1; jpart < nparts; ++jpart) {  // start at 1
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-    int glb_nb_nodes = std::accumulate(recvcounts.begin(), recvcounts.end(), 0);
-
-    array::ArrayT<uid_t> glb_id_arr(glb_nb_nodes);
-    array::ArrayView<uid_t, 1> glb_id = array::make_view<uid_t, 1>(glb_id_arr);
-
-    ATLAS_TRACE_MPI(GATHER) {
-        mpi::comm().gatherv(loc_id.data(), loc_id.size(), glb_id.data(), recvcounts.data(), recvdispls.data(), root);
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Node> node_sort;
-    node_sort.reserve(glb_nb_nodes);
-    ATLAS_TRACE_SCOPE("sort global indices") {
-        for (idx_t jnode = 0; jnode < glb_id.shape(0); ++jnode) {
-            node_sort.emplace_back(glb_id(jnode), jnode);
-        }
-        std::sort(node_sort.begin(), node_sort.end());
-    }
-
-    // Assume edge gid start
-    uid_t gid                   = 0;
-    const idx_t nb_sorted_nodes = static_cast<idx_t>(node_sort.size());
-    for (idx_t jnode = 0; jnode < nb_sorted_nodes; ++jnode) {
-        if (jnode == 0) {
-            ++gid;
-        }
-        else if (node_sort[jnode].g != node_sort[jnode - 1].g) {
-            ++gid;
-        }
-        idx_t inode   = node_sort[jnode].i;
-        glb_id(inode) = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI(SCATTER) {
-        mpi::comm().scatterv(glb_id.data(), recvcounts.data(), recvdispls.data(), loc_id.data(), loc_id.size(), root);
-    }
-
-    for (int jnode = 0; jnode < nb_nodes; ++jnode) {
-        glb_idx(jnode) = loc_id(jnode);
+        glb_idx(jnode) = loc_id[jnode];
     }
     nodes.global_index().metadata().set("human_readable", true);
 }
@@ -293,7 +225,7 @@ Field& build_nodes_remote_idx(mesh::Nodes& nodes) {
     std::vector<std::vector<uid_t>> send_needed(mpi::size());
     std::vector<std::vector<uid_t>> recv_needed(mpi::size());
     int sendcnt = 0;
-    std::map<uid_t, int> lookup;
+    util::detail::FlatHashMap<uid_t, int> lookup(nb_nodes);
     for (idx_t jnode = 0; jnode < nb_nodes; ++jnode) {
         uid_t uid = compute_uid(jnode);
 
@@ -327,10 +259,11 @@ Field& build_nodes_remote_idx(mesh::Nodes& nodes) {
         const std::vector<uid_t>& recv_node = recv_needed[proc[jpart]];
         const idx_t nb_recv_nodes           = idx_t(recv_node.size()) / varsize;
         for (idx_t jnode = 0; jnode < nb_recv_nodes; ++jnode) {
-            uid_t uid = recv_node[jnode * varsize + 0];
-            int inode = recv_node[jnode * varsize + 1];
+            uid_t uid        = recv_node[jnode * varsize + 0];
+            int inode        = recv_node[jnode * varsize + 1];
+            const int* found = lookup.find(uid);
             send_found[proc[jpart]].push_back(inode);
-            send_found[proc[jpart]].push_back(lookup.count(uid) ? lookup[uid] : -1);
+            send_found[proc[jpart]].push_back(found ? *found : -1);
         }
     }
 
@@ -374,6 +307,78 @@ Field& build_nodes_partition(mesh::Nodes& nodes) {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+namespace {
+
+/// Partitions that have a copy of any node owned by this partition, including this partition itself.
+std::vector<int> partitions_with_owned_nodes(const Mesh& mesh) {
+    ATLAS_TRACE();
+    const auto& comm   = mpi::comm();
+    const int mpi_size = static_cast<int>(comm.size());
+
+    std::vector<int> references(mpi_size, 0);
+    const auto node_part = array::make_view<int, 1>(mesh.nodes().partition());
+    for (idx_t jnode = 0; jnode < node_part.size(); ++jnode) {
+        references[node_part(jnode)] = 1;
+    }
+    references[comm.rank()] = 1;
+
+    std::vector<int> referenced_by(mpi_size);
+    ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(references, referenced_by); }
+
+    std::vector<int> partitions;
+    for (int p = 0; p < mpi_size; ++p) {
+        if (referenced_by[p]) {
+            partitions.push_back(p);
+        }
+    }
+    return partitions;
+}
+
+/// Send boundary edges to every partition that can have them, and return the boundary edges received from
+/// each partition.
+/// A partition that has an edge has copies of both its nodes, and therefore has a copy of a node owned by
+/// the partition of the first edge node. Each boundary edge is sent to that owner, which forwards it to all
+/// partitions with a copy of any of its owned nodes, together with the partition the edge originates from.
+std::vector<std::vector<gidx_t>> exchange_boundary_edges(const Mesh& mesh, const std::vector<gidx_t>& bdry_edges,
+                                                         const std::vector<int>& bdry_edges_owner) {
+    ATLAS_TRACE();
+    const auto& comm   = mpi::comm();
+    const int mpi_size = static_cast<int>(comm.size());
+
+    std::vector<std::vector<gidx_t>> send_to_owner(mpi_size);
+    std::vector<std::vector<gidx_t>> recv_from_origin(mpi_size);
+    for (size_t j = 0; j < bdry_edges.size(); ++j) {
+        send_to_owner[bdry_edges_owner[j]].push_back(bdry_edges[j]);
+    }
+    ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(send_to_owner, recv_from_origin); }
+
+    // Forward as (origin, edge) pairs
+    const std::vector<int> partitions = partitions_with_owned_nodes(mesh);
+    std::vector<std::vector<gidx_t>> send_forward(mpi_size);
+    std::vector<std::vector<gidx_t>> recv_forward(mpi_size);
+    for (int p : partitions) {
+        auto& send = send_forward[p];
+        for (int origin = 0; origin < mpi_size; ++origin) {
+            for (gidx_t gidx : recv_from_origin[origin]) {
+                send.push_back(origin);
+                send.push_back(gidx);
+            }
+        }
+    }
+    ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(send_forward, recv_forward); }
+
+    std::vector<std::vector<gidx_t>> recv_bdry_edges(mpi_size);
+    for (int owner = 0; owner < mpi_size; ++owner) {
+        const auto& recv = recv_forward[owner];
+        for (size_t j = 0; j < recv.size(); j += 2) {
+            recv_bdry_edges[static_cast<size_t>(recv[j])].push_back(recv[j + 1]);
+        }
+    }
+    return recv_bdry_edges;
+}
+
+}  // namespace
+
 Field& build_edges_partition(Mesh& mesh) {
     ATLAS_TRACE();
 
@@ -442,7 +447,7 @@ Field& build_edges_partition(Mesh& mesh) {
 
     std::vector<gidx_t> bdry_edges;
     bdry_edges.reserve(nb_edges);
-    std::map<gidx_t, idx_t> global_to_local;
+    util::detail::FlatHashMap<gidx_t, idx_t> global_to_local(nb_edges);
 
 
     PeriodicTransform transform_periodic_east(-360.);
@@ -581,20 +586,27 @@ Field& build_edges_partition(Mesh& mesh) {
     };
 
     int mpi_size = mpi::size();
-    mpi::Buffer<gidx_t, 1> recv_bdry_edges_from_parts(mpi_size);
     std::vector<std::vector<gidx_t>> send_gidx(mpi_size);
     std::vector<std::vector<int>> send_part(mpi_size);
     std::vector<std::vector<gidx_t>> send_bdry_gidx(mpi_size);
     std::vector<std::vector<int>> send_bdry_elem_part(mpi_size);
     std::vector<std::vector<gidx_t>> send_bdry_elem_gidx(mpi_size);
-    mpi::comm().allGatherv(bdry_edges.begin(), bdry_edges.end(), recv_bdry_edges_from_parts);
+
+    std::vector<int> bdry_edges_owner;
+    bdry_edges_owner.reserve(bdry_edges.size());
+    for (gidx_t gidx : bdry_edges) {
+        bdry_edges_owner.push_back(node_part(edge_nodes(global_to_local[gidx], 0)));
+    }
+    std::vector<std::vector<gidx_t>> recv_bdry_edges = exchange_boundary_edges(mesh, bdry_edges, bdry_edges_owner);
+
     for (int p = 0; p < mpi_size; ++p) {
-        auto view = recv_bdry_edges_from_parts[p];
+        const auto& view = recv_bdry_edges[p];
         for (size_t j = 0; j < view.size(); ++j) {
             gidx_t gidx        = view[j];
             gidx_t master_gidx = std::abs(gidx);
-            if (global_to_local.count(master_gidx)) {
-                idx_t iedge = global_to_local[master_gidx];
+            const idx_t* found = global_to_local.find(master_gidx);
+            if (found) {
+                idx_t iedge = *found;
 #ifdef DEBUGGING_PARFIELDS
                 if (FIND_GIDX(master_gidx))
                     std::cout << "[" << mypart << "] found " << EDGE(iedge) << std::endl;
@@ -792,7 +804,7 @@ Field& build_edges_remote_idx(Mesh& mesh) {
     std::vector<std::vector<uid_t>> send_needed(mpi::size());
     std::vector<std::vector<uid_t>> recv_needed(mpi::size());
     int sendcnt = 0;
-    std::map<uid_t, int> lookup;
+    util::detail::FlatHashMap<uid_t, int> lookup(nb_edges);
 
     PeriodicTransform transform;
 
@@ -863,19 +875,18 @@ Field& build_edges_remote_idx(Mesh& mesh) {
     std::vector<std::vector<int>> send_found(mpi::size());
     std::vector<std::vector<int>> recv_found(mpi::size());
 
-    std::map<uid_t, int>::iterator found;
     for (idx_t jpart = 0; jpart < nparts; ++jpart) {
         const std::vector<uid_t>& recv_edge = recv_needed[jpart];
         const idx_t nb_recv_edges           = idx_t(recv_edge.size()) / varsize;
         // array::ArrayView<uid_t,2> recv_edge( recv_needed[ jpart ].data(),
         //     array::make_shape(recv_needed[ jpart ].size()/varsize,varsize) );
         for (idx_t jedge = 0; jedge < nb_recv_edges; ++jedge) {
-            uid_t recv_uid = recv_edge[jedge * varsize + 0];
-            int recv_idx   = recv_edge[jedge * varsize + 1];
-            found          = lookup.find(recv_uid);
-            if (found != lookup.end()) {
+            uid_t recv_uid   = recv_edge[jedge * varsize + 0];
+            int recv_idx     = recv_edge[jedge * varsize + 1];
+            const int* found = lookup.find(recv_uid);
+            if (found) {
                 send_found[jpart].push_back(recv_idx);
-                send_found[jpart].push_back(found->second);
+                send_found[jpart].push_back(*found);
             }
             else {
                 std::stringstream msg;
@@ -912,11 +923,6 @@ Field& build_edges_remote_idx(Mesh& mesh) {
 Field& build_edges_global_idx(Mesh& mesh) {
     ATLAS_TRACE();
 
-    UniqueLonLat compute_uid(mesh);
-
-    int nparts = mpi::size();
-    idx_t root = 0;
-
     mesh::HybridElements& edges = mesh.edges();
 
     array::make_view<gidx_t, 1>(edges.global_index()).assign(-1);
@@ -948,67 +954,12 @@ Field& build_edges_global_idx(Mesh& mesh) {
         }
     }
 
-    /*
- * REMOTE INDEX BASE = 1
- */
-
-    // 1) Gather all global indices, together with location
-    array::ArrayT<uid_t> loc_edge_id_arr(nb_edges);
-    array::ArrayView<uid_t, 1> loc_edge_id = array::make_view<uid_t, 1>(loc_edge_id_arr);
-
-    for (int jedge = 0; jedge < nb_edges; ++jedge) {
-        loc_edge_id(jedge) = edge_gidx(jedge);
-    }
-
-    std::vector<int> recvcounts(mpi::size());
-    std::vector<int> recvdispls(mpi::size());
-
-    ATLAS_TRACE_MPI(GATHER) { mpi::comm().gather(nb_edges, recvcounts, root); }
-
-    recvdispls[0] = 0;
-    for (int jpart = 1; jpart < nparts; ++jpart)  // start at 1
-    {
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-    int glb_nb_edges = std::accumulate(recvcounts.begin(), recvcounts.end(), 0);
-
-    array::ArrayT<uid_t> glb_edge_id_arr(glb_nb_edges);
-    array::ArrayView<uid_t, 1> glb_edge_id = array::make_view<uid_t, 1>(glb_edge_id_arr);
-
-    ATLAS_TRACE_MPI(GATHER) {
-        mpi::comm().gatherv(loc_edge_id.data(), loc_edge_id.size(), glb_edge_id.data(), recvcounts.data(),
-                            recvdispls.data(), root);
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Node> edge_sort;
-    edge_sort.reserve(glb_nb_edges);
-    for (idx_t jedge = 0; jedge < glb_edge_id.shape(0); ++jedge) {
-        edge_sort.emplace_back(Node(glb_edge_id(jedge), jedge));
-    }
-    std::sort(edge_sort.begin(), edge_sort.end());
-
-    // Assume edge gid start
-    uid_t gid(0);
-    for (size_t jedge = 0; jedge < edge_sort.size(); ++jedge) {
-        if (jedge == 0) {
-            ++gid;
-        }
-        else if (edge_sort[jedge].g != edge_sort[jedge - 1].g) {
-            ++gid;
-        }
-        int iedge          = edge_sort[jedge].i;
-        glb_edge_id(iedge) = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI(SCATTER) {
-        mpi::comm().scatterv(glb_edge_id.data(), recvcounts.data(), recvdispls.data(), loc_edge_id.data(),
-                             loc_edge_id.size(), root);
-    }
+    // Renumber from 1 to the global number of edges, following the global order of uid
+    std::vector<gidx_t> loc_edge_id(edge_gidx.data(), edge_gidx.data() + nb_edges);
+    parallel::renumber_global_index(loc_edge_id);
 
     for (int jedge = 0; jedge < nb_edges; ++jedge) {
-        edge_gidx(jedge) = loc_edge_id(jedge);
+        edge_gidx(jedge) = loc_edge_id[jedge];
     }
 
     return edges.global_index();
@@ -1058,7 +1009,7 @@ Field& build_cells_remote_idx(mesh::Cells& cells, const mesh::Nodes& nodes) {
     std::vector<std::vector<uid_t>> send_needed(mpi::size());
     std::vector<std::vector<uid_t>> recv_needed(mpi::size());
     int sendcnt = 0;
-    std::map<uid_t, int> lookup;
+    util::detail::FlatHashMap<uid_t, int> lookup(nb_cells);
     for (idx_t jcell = 0; jcell < nb_cells; ++jcell) {
         uid_t uid = compute_uid(jcell);
 
@@ -1092,10 +1043,11 @@ Field& build_cells_remote_idx(mesh::Cells& cells, const mesh::Nodes& nodes) {
         const std::vector<uid_t>& recv_cell = recv_needed[proc[jpart]];
         const idx_t nb_recv_cells           = idx_t(recv_cell.size()) / varsize;
         for (idx_t jcell = 0; jcell < nb_recv_cells; ++jcell) {
-            uid_t uid = recv_cell[jcell * varsize + 0];
-            int icell = recv_cell[jcell * varsize + 1];
+            uid_t uid        = recv_cell[jcell * varsize + 0];
+            int icell        = recv_cell[jcell * varsize + 1];
+            const int* found = lookup.find(uid);
             send_found[proc[jpart]].push_back(icell);
-            send_found[proc[jpart]].push_back(lookup.count(uid) ? lookup[uid] : -1);
+            send_found[proc[jpart]].push_back(found ? *found : -1);
         }
     }
 
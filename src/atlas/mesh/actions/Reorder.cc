@@ -8,8 +8,12 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <cstdlib>
+#include <limits>
+#include <ostream>
 #include <utility>
 
 #include "atlas/mesh/actions/Reorder.h"
@@ -24,6 +28,7 @@
 #include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
+#include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
@@ -145,13 +150,23 @@ std::string reorder_field(Field& field, const std::vector<idx_t>& order, idx_t b
 
 // ------------------------------------------------------------------
 
-void update_connectivity(mesh::HybridElements::Connectivity& connectivity, const std::vector<idx_t>& order) {
-    for (idx_t b = 0; b < connectivity.blocks(); ++b) {
-        auto& block = connectivity.block(b);
-        for (idx_t r = 0; r < block.rows(); ++r) {
-            for (idx_t c = 0; c < block.cols(); ++c) {
-                idx_t n = block(r, c);
-                block.set(r, c, order.at(n));
+std::vector<idx_t> inverse_order(const std::vector<idx_t>& order) {
+    std::vector<idx_t> order_inverse(order.size());
+    for (idx_t i = 0; i < static_cast<idx_t>(order.size()); ++i) {
+        order_inverse[order[i]] = i;
+    }
+    return order_inverse;
+}
+
+// ------------------------------------------------------------------
+
+void update_connectivity(mesh::IrregularConnectivityImpl& connectivity, const std::vector<idx_t>& order) {
+    const idx_t missing_value = connectivity.missing_value();
+    for (idx_t r = 0; r < connectivity.rows(); ++r) {
+        for (idx_t c = 0; c < connectivity.cols(r); ++c) {
+            idx_t n = connectivity(r, c);
+            if (n != missing_value) {
+                connectivity.set(r, c, order.at(n));
             }
         }
     }
@@ -179,15 +194,102 @@ void reorder_connectivity(BlockConnectivity& connectivity, const std::vector<idx
 
 // ------------------------------------------------------------------
 
-void ReorderImpl::reorderNodes(Mesh& mesh, const std::vector<idx_t>& order) {
-    std::vector<idx_t> order_inverse(order.size());
-    for (idx_t i = 0; i < static_cast<idx_t>(order.size()); ++i) {
-        order_inverse[order[i]] = i;
+// Reorder rows of an irregular connectivity, e.g. the node-to-edge connectivity
+void reorder_connectivity(mesh::IrregularConnectivityImpl& connectivity, const std::vector<idx_t>& order) {
+    const idx_t rows = connectivity.rows();
+    ATLAS_ASSERT(rows == static_cast<idx_t>(order.size()));
+    std::vector<idx_t> counts(rows);
+    std::vector<idx_t> values;
+    values.reserve(connectivity.size());
+    for (idx_t r = 0; r < rows; ++r) {
+        counts[r] = connectivity.cols(order[r]);
+        for (idx_t c = 0; c < counts[r]; ++c) {
+            values.emplace_back(connectivity(order[r], c));
+        }
+    }
+    connectivity.clear();
+    connectivity.add(rows, counts.data());
+    const idx_t* row_values = values.data();
+    for (idx_t r = 0; r < rows; ++r) {
+        connectivity.set(r, row_values);
+        row_values += counts[r];
+    }
+}
+
+// ------------------------------------------------------------------
+
+// Update remote indices, after each task reordered its entities with given order_inverse (old to new local index).
+// Remote indices of entities owned by other tasks are updated with the order_inverse of the owning task.
+void update_remote_index(Field& remote_index, const Field& partition, const std::vector<idx_t>& order_inverse) {
+    ATLAS_TRACE();
+    const auto& comm   = mpi::comm();
+    const int mpi_size = static_cast<int>(comm.size());
+    const int mpi_rank = static_cast<int>(comm.rank());
+    const idx_t size   = static_cast<idx_t>(order_inverse.size());
+
+    auto ridx = array::make_indexview<idx_t, 1>(remote_index);
+    auto part = array::make_view<int, 1>(partition);
+
+    auto new_index = [&](idx_t r) { return (r >= 0 && r < size) ? order_inverse[r] : r; };
+
+    std::vector<std::vector<idx_t>> send(mpi_size);
+    std::vector<std::vector<idx_t>> recv(mpi_size);
+    std::vector<std::vector<idx_t>> send_entities(mpi_size);
+    for (idx_t j = 0; j < size; ++j) {
+        const int p = part(j);
+        if (p == mpi_rank) {
+            ridx(j) = new_index(ridx(j));
+        }
+        else if (p >= 0 && p < mpi_size) {
+            send[p].emplace_back(ridx(j));
+            send_entities[p].emplace_back(j);
+        }
     }
 
+    if (mpi_size > 1) {
+        ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(send, recv); }
+        for (auto& r : recv) {
+            for (auto& value : r) {
+                value = new_index(value);
+            }
+        }
+        ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(recv, send); }
+        for (int p = 0; p < mpi_size; ++p) {
+            for (size_t k = 0; k < send[p].size(); ++k) {
+                ridx(send_entities[p][k]) = send[p][k];
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------
+
+// Stable reorder, so that nodes of lower halo come first, and within each halo the nodes owned by this task.
+// Partition boundary nodes have halo 0 but are owned by another task. The given order is kept within each group.
+void group_by_halo(Mesh& mesh, std::vector<idx_t>& order) {
+    auto halo          = array::make_view<int, 1>(mesh.nodes().halo());
+    auto part          = array::make_view<int, 1>(mesh.nodes().partition());
+    const int mpi_rank = static_cast<int>(mpi::rank());
+    auto group         = [&](idx_t n) { return std::make_pair(halo(n), part(n) != mpi_rank); };
+    std::stable_sort(order.begin(), order.end(), [&group](idx_t a, idx_t b) { return group(a) < group(b); });
+}
+
+// ------------------------------------------------------------------
+
+void ReorderImpl::reorderNodes(Mesh& mesh, const std::vector<idx_t>& order) {
+    ATLAS_TRACE();
+    std::vector<idx_t> order_inverse = inverse_order(order);
+
     for (idx_t ifield = 0; ifield < mesh.nodes().nb_fields(); ++ifield) {
         reorder_field(mesh.nodes().field(ifield), order);
     }
+    update_remote_index(mesh.nodes().remote_index(), mesh.nodes().partition(), order_inverse);
+
+    for (auto* connectivity : {&mesh.nodes().edge_connectivity(), &mesh.nodes().cell_connectivity()}) {
+        if (connectivity->rows()) {
+            reorder_connectivity(*connectivity, order);
+        }
+    }
 
     if (mesh.cells().size()) {
         update_connectivity(mesh.cells().node_connectivity(), order_inverse);
@@ -199,55 +301,131 @@ void ReorderImpl::reorderNodes(Mesh& mesh, const std::vector<idx_t>& order) {
 
 // ------------------------------------------------------------------
 
-void reorder_elements_using_nodes(Mesh& mesh, Mesh::HybridElements& elements) {
+// Reorder the elements of each element type by halo, then owned by this task first, and then by lowest node
+// local index. Returns the order of all elements, for updating the connectivities referring to the elements.
+std::vector<idx_t> reorder_elements_using_nodes(Mesh::HybridElements& elements) {
+    std::vector<idx_t> elements_order(elements.size());
+    auto halo            = array::make_view<int, 1>(elements.halo());
+    auto part            = array::make_view<int, 1>(elements.partition());
+    const idx_t mpi_rank = static_cast<idx_t>(mpi::rank());
     for (idx_t t = 0; t < elements.nb_types(); ++t) {
         auto& elems        = elements.elements(t);
         auto& connectivity = elems.node_connectivity();
         idx_t nb_nodes     = elems.nb_nodes();
         idx_t nb_elems     = elems.size();
-        std::vector<std::pair<idx_t, idx_t>> node_lowest_index;
-        node_lowest_index.reserve(elems.size());
+        std::vector<std::array<idx_t, 4>> halo_node_lowest_index;
+        halo_node_lowest_index.reserve(elems.size());
         for (idx_t e = 0; e < nb_elems; ++e) {
             idx_t lowest = std::numeric_limits<idx_t>::max();
             for (idx_t n = 0; n < nb_nodes; ++n) {
                 lowest = std::min(lowest, connectivity(e, n));
             }
-            node_lowest_index.emplace_back(lowest, e);
+            const idx_t not_owned = part(elems.begin() + e) != mpi_rank;
+            halo_node_lowest_index.push_back({halo(elems.begin() + e), not_owned, lowest, e});
         }
-        std::sort(node_lowest_index.begin(), node_lowest_index.end());
-        std::vector<idx_t> order;
-        order.reserve(nb_elems);
-        for (const auto& pair : node_lowest_index) {
-            order.emplace_back(pair.second);
+        std::sort(halo_node_lowest_index.begin(), halo_node_lowest_index.end());
+        std::vector<idx_t> order(nb_elems);
+        for (idx_t e = 0; e < nb_elems; ++e) {
+            order[e]                          = halo_node_lowest_index[e][3];
+            elements_order[elems.begin() + e] = elems.begin() + order[e];
         }
-        for (idx_t ifield = 0; ifield < mesh.edges().nb_fields(); ++ifield) {
+        for (idx_t ifield = 0; ifield < elements.nb_fields(); ++ifield) {
             reorder_field(elements.field(ifield), order, elems.begin(), elems.end());
         }
 
-        reorder_connectivity(elems.node_connectivity(), order);
+        for (auto* element_connectivity :
+             {&elements.node_connectivity(), &elements.edge_connectivity(), &elements.cell_connectivity()}) {
+            if (element_connectivity->rows()) {
+                ATLAS_ASSERT(element_connectivity->blocks() == elements.nb_types());
+                reorder_connectivity(element_connectivity->block(t), order);
+            }
+        }
     }
+    return elements_order;
 }
 
 // ------------------------------------------------------------------
 
 void ReorderImpl::reorderCellsUsingNodes(Mesh& mesh) {
-    reorder_elements_using_nodes(mesh, mesh.cells());
+    ATLAS_TRACE();
+    auto& cells                      = mesh.cells();
+    std::vector<idx_t> order_inverse = inverse_order(reorder_elements_using_nodes(cells));
+
+    update_remote_index(cells.remote_index(), cells.partition(), order_inverse);
+    update_connectivity(mesh.nodes().cell_connectivity(), order_inverse);
+    update_connectivity(mesh.edges().cell_connectivity(), order_inverse);
+    update_connectivity(cells.cell_connectivity(), order_inverse);
 }
 
 // ------------------------------------------------------------------
 
 void ReorderImpl::reorderEdgesUsingNodes(Mesh& mesh) {
-    reorder_elements_using_nodes(mesh, mesh.edges());
+    ATLAS_TRACE();
+    auto& edges                      = mesh.edges();
+    std::vector<idx_t> order_inverse = inverse_order(reorder_elements_using_nodes(edges));
+
+    update_remote_index(edges.remote_index(), edges.partition(), order_inverse);
+    update_connectivity(mesh.nodes().edge_connectivity(), order_inverse);
+    update_connectivity(mesh.cells().edge_connectivity(), order_inverse);
+    update_connectivity(edges.edge_connectivity(), order_inverse);
+}
+
+// ------------------------------------------------------------------
+
+LocalityMetrics ReorderImpl::computeLocalityMetrics(const Mesh& mesh) {
+    const auto& elements     = mesh.edges().size() ? mesh.edges() : mesh.cells();
+    const auto& connectivity = elements.node_connectivity();
+    const idx_t nb_elements  = elements.size();
+
+    LocalityMetrics metrics;
+    double sum_span   = 0.;
+    double sum_jump   = 0.;
+    idx_t prev_lowest = 0;
+    for (idx_t e = 0; e < nb_elements; ++e) {
+        idx_t lowest  = std::numeric_limits<idx_t>::max();
+        idx_t highest = 0;
+        for (idx_t n = 0; n < connectivity.cols(e); ++n) {
+            lowest  = std::min(lowest, connectivity(e, n));
+            highest = std::max(highest, connectivity(e, n));
+        }
+        metrics.bandwidth = std::max(metrics.bandwidth, highest - lowest);
+        sum_span += highest - lowest;
+        if (e > 0) {
+            sum_jump += std::abs(lowest - prev_lowest);
+        }
+        prev_lowest = lowest;
+    }
+    if (nb_elements > 0) {
+        metrics.mean_span = sum_span / nb_elements;
+    }
+    if (nb_elements > 1) {
+        metrics.mean_jump = sum_jump / (nb_elements - 1);
+    }
+    return metrics;
+}
+
+// ------------------------------------------------------------------
+
+void LocalityMetrics::print(std::ostream& out) const {
+    out << "bandwidth: " << bandwidth << ", mean span: " << mean_span << ", mean jump: " << mean_jump;
 }
 
 // ------------------------------------------------------------------
 
 void ReorderImpl::operator()(Mesh& mesh) {
     ATLAS_TRACE("ReorderImpl(mesh)");
+    mpi::Scope mpi_scope(mesh.mpi_comm());
 
-    reorderNodes(mesh, computeNodesOrder(mesh));
+    Log::debug() << "Mesh locality before reordering: " << computeLocalityMetrics(mesh) << std::endl;
+
+    std::vector<idx_t> order = computeNodesOrder(mesh);
+    group_by_halo(mesh, order);
+
+    reorderNodes(mesh, order);
     reorderCellsUsingNodes(mesh);
     reorderEdgesUsingNodes(mesh);
+
+    Log::debug() << "Mesh locality after reordering:  " << computeLocalityMetrics(mesh) << std::endl;
 }
 
 // ------------------------------------------------------------------
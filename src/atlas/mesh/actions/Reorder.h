@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <string>
 #include <vector>
 
@@ -27,7 +28,27 @@ namespace actions {
 
 // ------------------------------------------------------------------
 
+/// Measures of memory locality of a mesh, computed from the element-to-node connectivity of the edges,
+/// or of the cells when the mesh has no edges. Smaller values mean that loops over the elements access
+/// the nodes more linearly.
+struct LocalityMetrics {
+    idx_t bandwidth{0};    ///< Largest difference between node indices within an element
+    double mean_span{0.};  ///< Average difference between largest and smallest node index within an element
+    double mean_jump{0.};  ///< Average absolute difference between lowest node index of consecutive elements
+
+    void print(std::ostream&) const;
+    friend std::ostream& operator<<(std::ostream& out, const LocalityMetrics& metrics) {
+        metrics.print(out);
+        return out;
+    }
+};
+
+// ------------------------------------------------------------------
+
 /// Base class for reordering the mesh nodes and elements
+///
+/// Reordering is collective when the mesh is distributed: remote indices are updated with the new
+/// local indices on the owning tasks, so all tasks need to reorder their mesh.
 class ReorderImpl : public util::Object {
 public:
     ReorderImpl() = default;
@@ -35,19 +56,31 @@ public:
 public:  // -- static functions --
     /// Reorder the nodes in the given mesh using a given order
     /// - All fields in mesh.nodes() are reordered.
+    /// - mesh.nodes().edge_connectivity() and mesh.nodes().cell_connectivity() rows are reordered
     /// - mesh.cells().node_connectivity() gets updated
     /// - mesh.edges().node_connectivity() gets updated
+    /// - mesh.nodes().remote_index() gets updated
     static void reorderNodes(Mesh& mesh, const std::vector<idx_t>& order);
 
-    /// Reorder the cells by lowest node local index within each cell
+    /// Reorder the cells by halo, then owned cells first, then by lowest node local index within each cell,
+    /// for each element type.
+    /// All fields and connectivities of the cells, and all connectivities referring to cells, are updated.
     static void reorderCellsUsingNodes(Mesh& mesh);
 
-    /// Reorder the edges by lowest node local index within each edge
+    /// Reorder the edges by halo, then owned edges first, then by lowest node local index within each edge,
+    /// for each element type.
+    /// All fields and connectivities of the edges, and all connectivities referring to edges, are updated.
     static void reorderEdgesUsingNodes(Mesh& mesh);
 
+    /// Compute locality metrics of the given mesh
+    static LocalityMetrics computeLocalityMetrics(const Mesh& mesh);
+
 public:  // -- member functions --
-    /// Reorder the nodes in the given mesh using the order computed with the computeNodesOrder function
+    /// Reorder the nodes in the given mesh using the order computed with the computeNodesOrder function,
+    /// grouped by halo, and within each halo by owned nodes first, so that owned nodes come first and halo
+    /// nodes last.
     /// Then apply reorderCellsUsingNodes and reorderEdgesUsingNodes
+    /// Locality metrics before and after reordering are reported to Log::debug()
     virtual void operator()(Mesh&);
 
     virtual std::vector<idx_t> computeNodesOrder(Mesh&) = 0;
@@ -18,6 +18,7 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/numerics/fvm/Method.h"
 #include "atlas/numerics/fvm/Nabla.h"
+#include "atlas/parallel/HaloExchange.h"
 #include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
@@ -82,6 +83,27 @@ void Nabla::setup() {
     for (idx_t jedge = 0; jedge < c; ++jedge) {
         pole_edges_.push_back(tmp[jedge]);
     }
+
+    // Split edges in those connecting only interior nodes, which can be computed while the
+    // node halo exchange is in flight, and the remaining boundary edges
+    const auto interior_nodes = fvm_->node_columns().halo_exchange().interior_indices();
+    std::vector<char> is_interior_node(fvm_->mesh().nodes().size(), false);
+    for (idx_t jnode : interior_nodes) {
+        if (jnode < static_cast<idx_t>(is_interior_node.size())) {
+            is_interior_node[jnode] = true;
+        }
+    }
+    const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
+    interior_edges_.clear();
+    boundary_edges_.clear();
+    for (idx_t jedge = 0; jedge < nedges; ++jedge) {
+        if (is_interior_node[edge2node(jedge, 0)] && is_interior_node[edge2node(jedge, 1)]) {
+            interior_edges_.push_back(jedge);
+        }
+        else {
+            boundary_edges_.push_back(jedge);
+        }
+    }
 }
 
 void Nabla::gradient(const Field& field, Field& grad_field) const {
@@ -320,6 +342,10 @@ void Nabla::gradient_of_vector(const Field& vector_field, Field& grad_field) con
 // ================================================================================
 
 void Nabla::divergence(const Field& vector_field, Field& div_field) const {
+    divergence(vector_field, div_field, nullptr);
+}
+
+void Nabla::divergence(const Field& vector_field, Field& div_field, parallel::HaloExchangeHandle* halo_in_flight) const {
 
     auto dispatch = [&](auto value) {
         using Value          = std::decay_t<decltype(value)>;
@@ -365,41 +391,51 @@ void Nabla::divergence(const Field& vector_field, Field& div_field) const {
             LONdLON = 0,
             LATdLAT = 1
         };
-        atlas_omp_parallel {
-            atlas_omp_for(idx_t jedge = 0; jedge < nedges; ++jedge) {
-                Value pbc = 1 - is_pole_edge(jedge);
-
-                idx_t ip1 = edge2node(jedge, 0);
-                idx_t ip2 = edge2node(jedge, 1);
-                Value y1 = lonlat_deg(ip1, LAT) * deg2rad;
-                Value y2 = lonlat_deg(ip2, LAT) * deg2rad;
-
-                Value cosy1, cosy2;
-                if (metric_approach_ == 0) {
-                    cosy1 = std::cos(y1) * pbc;
-                    cosy2 = std::cos(y2) * pbc;
-                }
-                else {
-                    cosy1 = cosy2 = std::cos(0.5 * (y1 + y2)) * pbc;
-                }
+        auto compute_edge = [&](idx_t jedge) {
+            Value pbc = 1 - is_pole_edge(jedge);
+
+            idx_t ip1 = edge2node(jedge, 0);
+            idx_t ip2 = edge2node(jedge, 1);
+            Value y1 = lonlat_deg(ip1, LAT) * deg2rad;
+            Value y2 = lonlat_deg(ip2, LAT) * deg2rad;
+
+            Value cosy1, cosy2;
+            if (metric_approach_ == 0) {
+                cosy1 = std::cos(y1) * pbc;
+                cosy2 = std::cos(y2) * pbc;
+            }
+            else {
+                cosy1 = cosy2 = std::cos(0.5 * (y1 + y2)) * pbc;
+            }
 
-                Value S[2] = {static_cast<Value>(dual_normals(jedge, LON)) * deg2rad, static_cast<Value>(dual_normals(jedge, LAT)) * deg2rad};
-                Value avg[2];
+            Value S[2] = {static_cast<Value>(dual_normals(jedge, LON)) * deg2rad, static_cast<Value>(dual_normals(jedge, LAT)) * deg2rad};
+            Value avg[2];
 
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    Value u1 = vector(ip1, jlev, LON);
-                    Value u2 = vector(ip2, jlev, LON);
-                    Value v1 = vector(ip1, jlev, LAT) * cosy1;
-                    Value v2 = vector(ip2, jlev, LAT) * cosy2;
+            for (idx_t jlev = 0; jlev < nlev; ++jlev) {
+                Value u1 = vector(ip1, jlev, LON);
+                Value u2 = vector(ip2, jlev, LON);
+                Value v1 = vector(ip1, jlev, LAT) * cosy1;
+                Value v2 = vector(ip2, jlev, LAT) * cosy2;
 
-                    avg[LON] = (u1 + u2) * 0.5;
-                    avg[LAT] = (v1 + v2) * 0.5;
+                avg[LON] = (u1 + u2) * 0.5;
+                avg[LAT] = (v1 + v2) * 0.5;
 
-                    avgS(jedge, jlev, LONdLON) = avg[LON] * S[LON];
-                    avgS(jedge, jlev, LATdLAT) = avg[LAT] * S[LAT];
-                }
+                avgS(jedge, jlev, LONdLON) = avg[LON] * S[LON];
+                avgS(jedge, jlev, LATdLAT) = avg[LAT] * S[LAT];
             }
+        };
 
+        if (halo_in_flight) {
+            // Edges connecting only interior nodes do not need halo values, and overlap the communication
+            atlas_omp_parallel_for(size_t j = 0; j < interior_edges_.size(); ++j) { compute_edge(interior_edges_[j]); }
+            fvm_->node_columns().haloExchangeEnd(*halo_in_flight);
+            atlas_omp_parallel_for(size_t j = 0; j < boundary_edges_.size(); ++j) { compute_edge(boundary_edges_[j]); }
+        }
+        else {
+            atlas_omp_parallel_for(idx_t jedge = 0; jedge < nedges; ++jedge) { compute_edge(jedge); }
+        }
+
+        atlas_omp_parallel {
             atlas_omp_for(idx_t jnode = 0; jnode < nnodes; ++jnode) {
                 for (idx_t jlev = 0; jlev < nlev; ++jlev) {
                     div(jnode, jlev) = 0.;
@@ -562,9 +598,12 @@ void Nabla::laplacian(const Field& scalar, Field& lapl) const {
                                                 option::variables(2) | option::datatype(scalar.datatype())));
     gradient(scalar, grad);
     if (fvm_->node_columns().halo().size() < 2) {
-        fvm_->node_columns().haloExchange(grad);
+        auto halo_in_flight = fvm_->node_columns().haloExchangeBegin(grad);
+        divergence(grad, lapl, &halo_in_flight);
+    }
+    else {
+        divergence(grad, lapl);
     }
-    divergence(grad, lapl);
 }
 
 const FunctionSpace& Nabla::functionspace() const {
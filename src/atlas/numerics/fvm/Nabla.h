@@ -25,6 +25,9 @@ class Method;
 
 namespace atlas {
 class Field;
+namespace parallel {
+class HaloExchangeHandle;
+}
 }
 
 namespace atlas {
@@ -50,9 +53,15 @@ private:
     void gradient_of_scalar(const Field& scalar, Field& grad) const;
     void gradient_of_vector(const Field& vector, Field& grad) const;
 
+    /// Divergence, overlapping the computation on interior edges with a halo exchange of the
+    /// vector field in flight, which is completed before the boundary edges are computed.
+    void divergence(const Field& vector, Field& div, parallel::HaloExchangeHandle* halo_in_flight) const;
+
 private:
     fvm::Method const* fvm_;
     std::vector<idx_t> pole_edges_;
+    std::vector<idx_t> interior_edges_;
+    std::vector<idx_t> boundary_edges_;
     int metric_approach_{0};
 };
 #endif
@@ -0,0 +1,152 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/parallel/GlobalIndexRenumbering.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "atlas/parallel/mpi/Buffer.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/sort.h"
+#include "atlas/runtime/Trace.h"
+
+namespace atlas {
+namespace parallel {
+
+namespace {
+
+// Number of samples per task used to select the splitters.
+// More samples give a better balanced partition, at the cost of a larger allGatherv.
+constexpr gidx_t oversampling = 32;
+
+/// Select (mpi_size-1) splitters from a regular sample of the sorted distinct local values of all tasks.
+/// Each task contributes a number of samples proportional to its number of values, so that the
+/// partitions are balanced even when the values are very unevenly distributed over the tasks.
+std::vector<gidx_t> select_splitters(const std::vector<gidx_t>& sorted, gidx_t nb_global) {
+    const auto& comm     = mpi::comm();
+    const idx_t mpi_size = static_cast<idx_t>(comm.size());
+
+    const gidx_t nb_local   = static_cast<gidx_t>(sorted.size());
+    const gidx_t nb_samples = oversampling * mpi_size;
+
+    // rounded up, so that every task with values contributes at least one sample
+    const gidx_t nb_local_samples = std::min(nb_local, (nb_samples * nb_local + nb_global - 1) / nb_global);
+
+    std::vector<gidx_t> local_samples(nb_local_samples);
+    for (gidx_t j = 0; j < nb_local_samples; ++j) {
+        local_samples[j] = sorted[((2 * j + 1) * nb_local) / (2 * nb_local_samples)];
+    }
+
+    mpi::Buffer<gidx_t, 1> samples(mpi_size);
+    ATLAS_TRACE_MPI(ALLGATHER) { comm.allGatherv(local_samples.begin(), local_samples.end(), samples); }
+
+    std::vector<gidx_t>& all_samples = samples.buffer;
+    std::sort(all_samples.begin(), all_samples.end());
+
+    const size_t nb_all_samples = all_samples.size();
+    std::vector<gidx_t> splitters(mpi_size - 1);
+    for (idx_t p = 0; p < mpi_size - 1; ++p) {
+        splitters[p] = all_samples[std::min(nb_all_samples - 1, ((p + 1) * nb_all_samples) / mpi_size)];
+    }
+    return splitters;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void renumber_global_index(std::vector<gidx_t>& global_index, gidx_t base) {
+    ATLAS_TRACE();
+
+    const auto& comm     = mpi::comm();
+    const idx_t mpi_size = static_cast<idx_t>(comm.size());
+
+    // 1) Sorted distinct local values
+    std::vector<gidx_t> local(global_index);
+    ATLAS_TRACE_SCOPE("sort local values") {
+        omp::sort(local.begin(), local.end());
+        local.erase(std::unique(local.begin(), local.end()), local.end());
+    }
+
+    // New index for each value in local
+    std::vector<gidx_t> renumbered(local.size());
+
+    if (mpi_size == 1) {
+        std::iota(renumbered.begin(), renumbered.end(), base + 1);
+    }
+    else {
+        gidx_t nb_global;
+        ATLAS_TRACE_MPI(ALLREDUCE) { comm.allReduce(gidx_t(local.size()), nb_global, eckit::mpi::sum()); }
+        if (nb_global == 0) {
+            return;
+        }
+
+        // 2) Partition the distinct values by value, so that equal values from different tasks meet
+        //    on the same task, and send each partition to the task that owns it
+        std::vector<gidx_t> splitters = select_splitters(local, nb_global);
+
+        std::vector<std::vector<gidx_t>> send(mpi_size);
+        std::vector<std::vector<gidx_t>> recv(mpi_size);
+        auto first = local.begin();
+        for (idx_t p = 0; p < mpi_size; ++p) {
+            auto last = (p < mpi_size - 1) ? std::upper_bound(first, local.end(), splitters[p]) : local.end();
+            send[p].assign(first, last);
+            first = last;
+        }
+
+        ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(send, recv); }
+
+        // 3) Sort the distinct values of own partition. As partitions are ordered by task, the
+        //    offset of the own partition is the number of distinct values owned by lower tasks
+        std::vector<gidx_t> owned;
+        owned.reserve(std::accumulate(recv.begin(), recv.end(), size_t(0),
+                                      [](size_t n, const std::vector<gidx_t>& r) { return n + r.size(); }));
+        for (const auto& r : recv) {
+            owned.insert(owned.end(), r.begin(), r.end());
+        }
+        ATLAS_TRACE_SCOPE("sort owned values") {
+            omp::sort(owned.begin(), owned.end());
+            owned.erase(std::unique(owned.begin(), owned.end()), owned.end());
+        }
+
+        std::vector<gidx_t> nb_owned(mpi_size);
+        ATLAS_TRACE_MPI(ALLGATHER) { comm.allGather(gidx_t(owned.size()), nb_owned.begin(), nb_owned.end()); }
+        const gidx_t offset =
+            base + 1 + std::accumulate(nb_owned.begin(), nb_owned.begin() + comm.rank(), gidx_t(0));
+
+        // 4) Return the new index of each received value to the task that sent it
+        for (auto& r : recv) {
+            for (auto& value : r) {
+                value = offset + (std::lower_bound(owned.begin(), owned.end(), value) - owned.begin());
+            }
+        }
+
+        ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(recv, send); }
+
+        auto renumbered_it = renumbered.begin();
+        for (const auto& s : send) {
+            renumbered_it = std::copy(s.begin(), s.end(), renumbered_it);
+        }
+    }
+
+    // 5) Replace each local value by the new index
+    const idx_t size = static_cast<idx_t>(global_index.size());
+    atlas_omp_parallel_for(idx_t j = 0; j < size; ++j) {
+        auto it         = std::lower_bound(local.begin(), local.end(), global_index[j]);
+        global_index[j] = renumbered[it - local.begin()];
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace parallel
+}  // namespace atlas
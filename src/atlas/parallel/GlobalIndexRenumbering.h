@@ -0,0 +1,36 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "atlas/library/config.h"
+
+namespace atlas {
+namespace parallel {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// @brief Renumber global indices contiguously, following their global sorted order
+///
+/// Collective over mpi::comm(). On return, each value v in global_index of any task is replaced by
+///     base + 1 + (number of distinct values smaller than v, over all tasks)
+/// so that equal values on different tasks receive the same new index.
+///
+/// This uses a distributed sample sort: the distinct values are partitioned by value over all tasks,
+/// each task numbers its own partition, and the new indices are returned to the requesting tasks.
+/// The global list of values is therefore never held by a single task.
+void renumber_global_index(std::vector<gidx_t>& global_index, gidx_t base = 0);
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace parallel
+}  // namespace atlas
@@ -12,14 +12,17 @@
 /// @author Willem Deconinck
 /// @date   Nov 2013
 
+#include <climits>
 #include <memory>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
 #include "atlas/array/Array.h"
 #include "atlas/parallel/HaloExchange.h"
 #include "atlas/parallel/mpi/Statistics.h"
+#include "atlas/util/Allocate.h"
 #include "atlas/util/vector.h"
 
 namespace atlas {
@@ -48,8 +51,94 @@ struct IsGhostPoint {
     const idx_t* ridx_;
     idx_t base_;
 };
+
+// MPI counts and displacements are int. Sizes are accumulated as size_t, and checked before conversion,
+// so that large (aggregated) messages fail loudly instead of overflowing.
+int to_mpi_count(size_t count) {
+    ATLAS_ASSERT(count <= static_cast<size_t>(INT_MAX), "Halo exchange message size exceeds MPI count limit");
+    return static_cast<int>(count);
+}
+
+std::vector<int> to_mpi_counts(const std::vector<size_t>& counts) {
+    std::vector<int> mpi_counts(counts.size());
+    for (size_t j = 0; j < counts.size(); ++j) {
+        mpi_counts[j] = to_mpi_count(counts[j]);
+    }
+    return mpi_counts;
+}
 }  // namespace
 
+HaloExchangePlan::HaloExchangePlan(std::vector<int>&& _send_counts, std::vector<int>&& _send_displs,
+                                   std::vector<int>&& _recv_counts, std::vector<int>&& _recv_displs,
+                                   size_t element_size, bool on_device):
+    send_counts(std::move(_send_counts)),
+    send_displs(std::move(_send_displs)),
+    recv_counts(std::move(_recv_counts)),
+    recv_displs(std::move(_recv_displs)),
+    send_req(send_counts.size()),
+    recv_req(recv_counts.size()),
+    on_device_(on_device) {
+    send_size_  = to_mpi_count(std::accumulate(send_counts.begin(), send_counts.end(), size_t(0)));
+    recv_size_  = to_mpi_count(std::accumulate(recv_counts.begin(), recv_counts.end(), size_t(0)));
+    send_bytes_ = size_t(send_size_) * element_size;
+    recv_bytes_ = size_t(recv_size_) * element_size;
+
+    if (on_device_) {
+        util::allocate_devicemem(send_buffer_, send_bytes_);
+        util::allocate_devicemem(recv_buffer_, recv_bytes_);
+    }
+    else {
+        util::allocate_pinnedmem(send_buffer_, send_bytes_);
+        util::allocate_pinnedmem(recv_buffer_, recv_bytes_);
+    }
+}
+
+HaloExchangePlan::~HaloExchangePlan() {
+    if (on_device_) {
+        util::delete_devicemem(send_buffer_, send_bytes_);
+        util::delete_devicemem(recv_buffer_, recv_bytes_);
+    }
+    else {
+        util::delete_pinnedmem(send_buffer_, send_bytes_);
+        util::delete_pinnedmem(recv_buffer_, recv_bytes_);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+HaloExchangeHandle::HaloExchangeHandle(HaloExchangeHandle&& other):
+    exchange_(std::exchange(other.exchange_, nullptr)),
+    arrays_(std::move(other.arrays_)),
+    plan_(std::exchange(other.plan_, nullptr)),
+    owned_plan_(std::move(other.owned_plan_)),
+    on_completion_(std::move(other.on_completion_)) {}
+
+HaloExchangeHandle& HaloExchangeHandle::operator=(HaloExchangeHandle&& other) {
+    if (this != &other) {
+        if (active()) {
+            exchange_->exchange_end(*this);
+        }
+        exchange_      = std::exchange(other.exchange_, nullptr);
+        arrays_        = std::move(other.arrays_);
+        plan_          = std::exchange(other.plan_, nullptr);
+        owned_plan_    = std::move(other.owned_plan_);
+        on_completion_ = std::move(other.on_completion_);
+    }
+    return *this;
+}
+
+HaloExchangeHandle::~HaloExchangeHandle() {
+    wait();
+}
+
+void HaloExchangeHandle::wait() {
+    if (active()) {
+        exchange_->exchange_end(*this);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 HaloExchange::HaloExchange() :
     HaloExchange("") {
 }
@@ -75,6 +164,15 @@ void HaloExchange::setup(const std::string& mpi_comm, const int part[], const id
 
 void HaloExchange::setup(const std::string& mpi_comm, const int part[], const idx_t remote_idx[], const int base, idx_t parsize, idx_t halo_begin) {
     ATLAS_TRACE("HaloExchange::setup");
+    // Exchanges in flight refer to the plans and index maps which are redefined here
+    ATLAS_ASSERT(nb_exchanges_in_flight_ == 0,
+                 "HaloExchange::setup() called while an exchange is in flight; call exchange_end() first");
+    {
+        // Plans depend on the communication pattern, which is redefined here
+        std::lock_guard<std::mutex> guard(plans_mutex_);
+        plans_.clear();
+        multi_plans_.clear();
+    }
     comm_ = &mpi::comm(mpi_comm);
     myproc = comm().rank();
     nproc  = comm().size();
@@ -169,10 +267,342 @@ void HaloExchange::setup(const std::string& mpi_comm, const int part[], const id
     backdoor.parsize = parsize_;
 }
 
-void HaloExchange::wait_for_send(std::vector<int>& send_counts_init, std::vector<eckit::mpi::Request>& send_req) const {
+HaloExchangePlan& HaloExchange::plan(array::DataType::kind_t kind, size_t datatype_size, idx_t var_size,
+                                     bool on_device) const {
+    std::lock_guard<std::mutex> guard(plans_mutex_);
+    auto& p = plans_[PlanKey{kind, var_size, on_device}];
+    if (not p) {
+        ATLAS_TRACE("HaloExchange::plan");
+        std::vector<size_t> send_counts(nproc), send_displs(nproc), recv_counts(nproc), recv_displs(nproc);
+        for (int jproc = 0; jproc < nproc; ++jproc) {
+            send_counts[jproc] = size_t(sendcounts_[jproc]) * var_size;
+            recv_counts[jproc] = size_t(recvcounts_[jproc]) * var_size;
+            send_displs[jproc] = size_t(senddispls_[jproc]) * var_size;
+            recv_displs[jproc] = size_t(recvdispls_[jproc]) * var_size;
+        }
+        p = std::make_unique<HaloExchangePlan>(to_mpi_counts(send_counts), to_mpi_counts(send_displs),
+                                               to_mpi_counts(recv_counts), to_mpi_counts(recv_displs), datatype_size,
+                                               on_device);
+    }
+    return *p;
+}
+
+namespace {
+
+// Segments of different arrays within one aggregated message are aligned to this many bytes,
+// so that each segment can be accessed as an array of its own datatype.
+constexpr size_t segment_alignment = 8;
+
+size_t aligned_segment_size(size_t bytes) {
+    return (bytes + segment_alignment - 1) / segment_alignment * segment_alignment;
+}
+
+idx_t var_size_of(const array::Array& arr) {
+    idx_t var_size = 1;
+    for (idx_t j = 1; j < arr.rank(); ++j) {
+        var_size *= arr.shape(j);
+    }
+    return var_size;
+}
+
+}  // namespace
+
+std::unique_ptr<HaloExchangePlan> HaloExchange::create_plan(const std::vector<array::Array*>& arrays) const {
+    ATLAS_TRACE("HaloExchange::plan");
+    std::vector<size_t> send_counts(nproc, 0), send_displs(nproc, 0), recv_counts(nproc, 0), recv_displs(nproc, 0);
+    for (int jproc = 0; jproc < nproc; ++jproc) {
+        for (const auto* arr : arrays) {
+            const size_t bytes_per_point = size_t(var_size_of(*arr)) * arr->datatype().size();
+            send_counts[jproc] += aligned_segment_size(size_t(sendcounts_[jproc]) * bytes_per_point);
+            recv_counts[jproc] += aligned_segment_size(size_t(recvcounts_[jproc]) * bytes_per_point);
+        }
+    }
+    for (int jproc = 1; jproc < nproc; ++jproc) {
+        send_displs[jproc] = send_displs[jproc - 1] + send_counts[jproc - 1];
+        recv_displs[jproc] = recv_displs[jproc - 1] + recv_counts[jproc - 1];
+    }
+    // Total sizes are also checked by the plan, as the last displacement plus count may overflow
+    return std::make_unique<HaloExchangePlan>(to_mpi_counts(send_counts), to_mpi_counts(send_displs),
+                                              to_mpi_counts(recv_counts), to_mpi_counts(recv_displs), sizeof(char),
+                                              false);
+}
+
+HaloExchangePlan& HaloExchange::plan(const std::vector<array::Array*>& arrays) const {
+    MultiPlanKey key;
+    key.reserve(arrays.size());
+    for (const auto* arr : arrays) {
+        key.emplace_back(arr->datatype().kind(), var_size_of(*arr));
+    }
+
+    std::lock_guard<std::mutex> guard(plans_mutex_);
+    auto& p = multi_plans_[key];
+    if (not p) {
+        p = create_plan(arrays);
+    }
+    return *p;
+}
+
+size_t HaloExchange::nb_plans() const {
+    std::lock_guard<std::mutex> guard(plans_mutex_);
+    return plans_.size() + multi_plans_.size();
+}
+
+namespace {
+
+template <typename DATA_TYPE, int RANK>
+void pack_points(array::Array& arr, const int map[], int count, char* buffer) {
+    auto view      = array::make_host_view<DATA_TYPE, RANK>(arr);
+    DATA_TYPE* buf = reinterpret_cast<DATA_TYPE*>(buffer);
+    idx_t ibuf     = 0;
+    for (int n = 0; n < count; ++n) {
+        halo_packer_impl<0, RANK, 0>::apply(ibuf, map[n], view, buf);
+    }
+}
+
+template <typename DATA_TYPE, int RANK>
+void unpack_points(const char* buffer, const int map[], int count, array::Array& arr) {
+    auto view            = array::make_host_view<DATA_TYPE, RANK>(arr);
+    const DATA_TYPE* buf = reinterpret_cast<const DATA_TYPE*>(buffer);
+    idx_t ibuf           = 0;
+    for (int n = 0; n < count; ++n) {
+        halo_unpacker_impl<0, RANK, 0>::apply(ibuf, map[n], buf, view);
+    }
+}
+
+struct PointPacker {
+    using pack_t   = void (*)(array::Array&, const int[], int, char*);
+    using unpack_t = void (*)(const char*, const int[], int, array::Array&);
+    pack_t pack;
+    unpack_t unpack;
+    size_t bytes_per_point;
+};
+
+template <typename DATA_TYPE>
+PointPacker make_point_packer(const array::Array& arr) {
+    const size_t bytes_per_point = var_size_of(arr) * sizeof(DATA_TYPE);
+    switch (arr.rank()) {
+        case 1:
+            return {pack_points<DATA_TYPE, 1>, unpack_points<DATA_TYPE, 1>, bytes_per_point};
+        case 2:
+            return {pack_points<DATA_TYPE, 2>, unpack_points<DATA_TYPE, 2>, bytes_per_point};
+        case 3:
+            return {pack_points<DATA_TYPE, 3>, unpack_points<DATA_TYPE, 3>, bytes_per_point};
+        case 4:
+            return {pack_points<DATA_TYPE, 4>, unpack_points<DATA_TYPE, 4>, bytes_per_point};
+        default:
+            throw_NotImplemented("Rank not supported in halo exchange", Here());
+    }
+}
+
+PointPacker make_point_packer(const array::Array& arr) {
+    switch (arr.datatype().kind()) {
+        case array::DataType::kind<int>():
+            return make_point_packer<int>(arr);
+        case array::DataType::kind<long>():
+            return make_point_packer<long>(arr);
+        case array::DataType::kind<float>():
+            return make_point_packer<float>(arr);
+        case array::DataType::kind<double>():
+            return make_point_packer<double>(arr);
+        default:
+            throw_Exception("datatype not supported", Here());
+    }
+}
+
+template <typename DATA_TYPE>
+void dispatch_execute(const HaloExchange& halo_exchange, array::Array& arr, bool on_device) {
+    switch (arr.rank()) {
+        case 1:
+            halo_exchange.execute<DATA_TYPE, 1>(arr, on_device);
+            break;
+        case 2:
+            halo_exchange.execute<DATA_TYPE, 2>(arr, on_device);
+            break;
+        case 3:
+            halo_exchange.execute<DATA_TYPE, 3>(arr, on_device);
+            break;
+        case 4:
+            halo_exchange.execute<DATA_TYPE, 4>(arr, on_device);
+            break;
+        default:
+            throw_NotImplemented("Rank not supported in halo exchange", Here());
+    }
+}
+
+}  // namespace
+
+void HaloExchange::execute(const std::vector<array::Array*>& arrays, bool on_device) const {
+    if (!is_setup_) {
+        throw_Exception("HaloExchange was not setup", Here());
+    }
+    if (arrays.empty()) {
+        return;
+    }
+
+    if (on_device || arrays.size() == 1) {
+        // Device packing kernels operate on one typed array at a time
+        for (auto* arr : arrays) {
+            switch (arr->datatype().kind()) {
+                case array::DataType::kind<int>():
+                    dispatch_execute<int>(*this, *arr, on_device);
+                    break;
+                case array::DataType::kind<long>():
+                    dispatch_execute<long>(*this, *arr, on_device);
+                    break;
+                case array::DataType::kind<float>():
+                    dispatch_execute<float>(*this, *arr, on_device);
+                    break;
+                case array::DataType::kind<double>():
+                    dispatch_execute<double>(*this, *arr, on_device);
+                    break;
+                default:
+                    throw_Exception("datatype not supported", Here());
+            }
+        }
+        return;
+    }
+
+    ATLAS_TRACE("HaloExchange", {"halo-exchange"});
+    HaloExchangeHandle handle = exchange_begin(arrays, on_device);
+    exchange_end(handle);
+}
+
+void HaloExchange::pack_arrays(const std::vector<array::Array*>& arrays, HaloExchangePlan& p) const {
+    ATLAS_TRACE();
+    std::vector<PointPacker> packers;
+    packers.reserve(arrays.size());
+    for (const auto* arr : arrays) {
+        packers.emplace_back(make_point_packer(*arr));
+    }
+    char* send_buffer = p.send_buffer<char>();
+
+    // Per partition one segment per array
+    atlas_omp_parallel_for(int jproc = 0; jproc < nproc; ++jproc) {
+        char* buffer = send_buffer + p.send_displs[jproc];
+        for (size_t f = 0; f < arrays.size(); ++f) {
+            packers[f].pack(*arrays[f], sendmap_.data() + senddispls_[jproc], sendcounts_[jproc], buffer);
+            buffer += aligned_segment_size(sendcounts_[jproc] * packers[f].bytes_per_point);
+        }
+    }
+}
+
+void HaloExchange::unpack_arrays(const HaloExchangePlan& p, const std::vector<array::Array*>& arrays) const {
+    ATLAS_TRACE();
+    std::vector<PointPacker> packers;
+    packers.reserve(arrays.size());
+    for (const auto* arr : arrays) {
+        packers.emplace_back(make_point_packer(*arr));
+    }
+    const char* recv_buffer = p.recv_buffer<char>();
+
+    atlas_omp_parallel_for(int jproc = 0; jproc < nproc; ++jproc) {
+        const char* buffer = recv_buffer + p.recv_displs[jproc];
+        for (size_t f = 0; f < arrays.size(); ++f) {
+            packers[f].unpack(buffer, recvmap_.data() + recvdispls_[jproc], recvcounts_[jproc], *arrays[f]);
+            buffer += aligned_segment_size(recvcounts_[jproc] * packers[f].bytes_per_point);
+        }
+    }
+}
+
+HaloExchangeHandle HaloExchange::exchange_begin(const std::vector<array::Array*>& arrays, bool on_device) const {
+    if (!is_setup_) {
+        throw_Exception("HaloExchange was not setup", Here());
+    }
+
+    HaloExchangeHandle handle;
+    handle.exchange_ = this;
+    handle.arrays_   = arrays;
+
+    if (on_device || arrays.empty()) {
+        // Device exchanges are not split; the handle only carries completion actions
+        execute(arrays, on_device);
+        return handle;
+    }
+
+    ATLAS_TRACE("HaloExchange::exchange_begin", {"halo-exchange"});
+
+    HaloExchangePlan* p = &plan(arrays);
+    if (p->in_flight_) {
+        // Same signature already in flight: use a private plan so that its buffers are not overwritten
+        handle.owned_plan_ = create_plan(arrays);
+        p                  = handle.owned_plan_.get();
+    }
+    p->in_flight_ = true;
+    handle.plan_  = p;
+    ++nb_exchanges_in_flight_;
+
+    int tag(1);
+    ireceive<char>(tag, p->recv_displs, p->recv_counts, p->recv_req, p->recv_buffer<char>());
+
+    pack_arrays(arrays, *p);
+
+    ATLAS_TRACE_MPI(ISEND) {
+        char* send_buffer = p->send_buffer<char>();
+        for (int jproc = 0; jproc < nproc; ++jproc) {
+            if (p->send_counts[jproc] > 0) {
+                p->send_req[jproc] =
+                    comm().iSend(send_buffer + p->send_displs[jproc], p->send_counts[jproc], jproc, tag);
+            }
+        }
+    }
+    return handle;
+}
+
+void HaloExchange::exchange_end(HaloExchangeHandle& handle) const {
+    if (not handle.active()) {
+        return;
+    }
+    ATLAS_ASSERT(handle.exchange_ == this);
+
+    if (handle.plan_) {
+        ATLAS_TRACE("HaloExchange::exchange_end", {"halo-exchange"});
+        HaloExchangePlan& p = *handle.plan_;
+
+        ATLAS_TRACE_MPI(WAIT, "mpi-wait receive") {
+            for (int jproc = 0; jproc < nproc; ++jproc) {
+                if (p.recv_counts[jproc] > 0) {
+                    comm().wait(p.recv_req[jproc]);
+                }
+            }
+        }
+
+        unpack_arrays(p, handle.arrays_);
+
+        wait_for_send(p.send_counts, p.send_req);
+
+        p.in_flight_ = false;
+        handle.plan_ = nullptr;
+        handle.owned_plan_.reset();
+        --nb_exchanges_in_flight_;
+    }
+
+    handle.exchange_ = nullptr;
+    for (auto& action : handle.on_completion_) {
+        action();
+    }
+    handle.on_completion_.clear();
+    handle.arrays_.clear();
+}
+
+std::vector<idx_t> HaloExchange::interior_indices() const {
+    std::vector<char> is_halo(parsize_, false);
+    for (int j = 0; j < recvcnt_; ++j) {
+        is_halo[recvmap_[j]] = true;
+    }
+    std::vector<idx_t> interior;
+    interior.reserve(parsize_ - recvcnt_);
+    for (idx_t j = 0; j < parsize_; ++j) {
+        if (not is_halo[j]) {
+            interior.emplace_back(j);
+        }
+    }
+    return interior;
+}
+
+void HaloExchange::wait_for_send(const std::vector<int>& send_counts, std::vector<eckit::mpi::Request>& send_req) const {
     ATLAS_TRACE_MPI(WAIT, "mpi-wait send") {
         for (int jproc = 0; jproc < nproc; ++jproc) {
-            if (send_counts_init[jproc] > 0) {
+            if (send_counts[jproc] > 0) {
                 comm().wait(send_req[jproc]);
             }
         }
@@ -14,8 +14,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "atlas/parallel/HaloAdjointExchangeImpl.h"
@@ -26,6 +34,7 @@
 #include "atlas/array/ArrayView.h"
 #include "atlas/array/ArrayViewDefs.h"
 #include "atlas/array/ArrayViewUtil.h"
+#include "atlas/array/DataType.h"
 #include "atlas/array/SVector.h"
 #include "atlas/array_fwd.h"
 #include "atlas/library/config.h"
@@ -40,6 +49,104 @@
 namespace atlas {
 namespace parallel {
 
+//----------------------------------------------------------------------------------------------------------------------
+
+/// @brief Persistent communication plan of a HaloExchange
+///
+/// A plan holds the per-partition counts and displacements, the MPI request handles and the
+/// send/receive buffers needed to exchange fields with a given signature (datatype and number of
+/// variables per parallel index, or a combination thereof for aggregated exchanges).
+/// Plans are created by HaloExchange on first use and reused for every following exchange with the
+/// same signature, so that no allocations happen in the exchange itself.
+/// Host buffers are pinned when atlas is built with GPU support.
+class HaloExchangePlan {
+public:
+    /// Counts and displacements are given in number of elements of size element_size
+    HaloExchangePlan(std::vector<int>&& send_counts, std::vector<int>&& send_displs, std::vector<int>&& recv_counts,
+                     std::vector<int>&& recv_displs, size_t element_size, bool on_device);
+
+    HaloExchangePlan(const HaloExchangePlan&) = delete;
+    HaloExchangePlan& operator=(const HaloExchangePlan&) = delete;
+
+    ~HaloExchangePlan();
+
+    bool on_device() const { return on_device_; }
+
+    /// Buffer holding values of owned points requested by other partitions
+    template <typename DATA_TYPE>
+    DATA_TYPE* send_buffer() const {
+        return reinterpret_cast<DATA_TYPE*>(send_buffer_);
+    }
+
+    /// Buffer holding values of halo points received from other partitions
+    template <typename DATA_TYPE>
+    DATA_TYPE* recv_buffer() const {
+        return reinterpret_cast<DATA_TYPE*>(recv_buffer_);
+    }
+
+    /// Number of elements in send buffer
+    int send_size() const { return send_size_; }
+
+    /// Number of elements in receive buffer
+    int recv_size() const { return recv_size_; }
+
+    const std::vector<int> send_counts;
+    const std::vector<int> send_displs;
+    const std::vector<int> recv_counts;
+    const std::vector<int> recv_displs;
+
+    std::vector<eckit::mpi::Request> send_req;
+    std::vector<eckit::mpi::Request> recv_req;
+
+private:
+    bool on_device_;
+    int send_size_;
+    int recv_size_;
+    size_t send_bytes_;
+    size_t recv_bytes_;
+    std::byte* send_buffer_{nullptr};
+    std::byte* recv_buffer_{nullptr};
+
+    friend class HaloExchange;
+    bool in_flight_{false};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class HaloExchange;
+
+/// @brief Handle to a halo exchange in flight, as returned by HaloExchange::exchange_begin
+///
+/// The exchange is completed with HaloExchange::exchange_end, or at the latest when the handle
+/// goes out of scope. Until then, the halo values of the exchanged arrays are undefined, and
+/// owned values must not be modified.
+class HaloExchangeHandle {
+public:
+    HaloExchangeHandle() = default;
+    HaloExchangeHandle(HaloExchangeHandle&&);
+    HaloExchangeHandle& operator=(HaloExchangeHandle&&);
+    ~HaloExchangeHandle();
+
+    /// True as long as the exchange has not been completed
+    bool active() const { return exchange_ != nullptr; }
+
+    /// Complete the exchange, equivalent to HaloExchange::exchange_end
+    void wait();
+
+    /// Register an action to run once the exchange has completed, e.g. to fix up halo values
+    void on_completion(std::function<void()>&& action) { on_completion_.emplace_back(std::move(action)); }
+
+private:
+    friend class HaloExchange;
+    const HaloExchange* exchange_{nullptr};
+    std::vector<array::Array*> arrays_;
+    HaloExchangePlan* plan_{nullptr};
+    std::unique_ptr<HaloExchangePlan> owned_plan_;
+    std::vector<std::function<void()>> on_completion_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 class HaloExchange : public util::Object {
 public:
     HaloExchange();
@@ -62,35 +169,70 @@ public:  // methods
     template <typename DATA_TYPE, int RANK, typename ParallelDim = array::FirstDim>
     void execute_adjoint(array::Array& field, bool on_device = false) const;
 
-private:  // methods
-    idx_t index(idx_t i, idx_t j, idx_t k, idx_t ni, idx_t nj, idx_t /*nk*/) const { return (i + ni * (j + nj * k)); }
+    /// @brief Exchange halos of multiple arrays at once
+    ///
+    /// The values of all arrays are packed into a single message per neighbouring partition, so that
+    /// the exchange costs one message latency regardless of the number of arrays.
+    /// Arrays may differ in datatype (int, long, float, double) and rank (1 to 4), but must all have
+    /// the parallel index as first dimension.
+    void execute(const std::vector<array::Array*>& arrays, bool on_device = false) const;
+
+    /// @brief Start the exchange of halos of multiple arrays, without waiting for completion
+    ///
+    /// Receives are posted and owned values are packed and sent. Computations that do not depend on
+    /// the halo (see interior_indices()) may be scheduled before calling exchange_end().
+    /// On device, the exchange is performed before returning.
+    HaloExchangeHandle exchange_begin(const std::vector<array::Array*>& arrays, bool on_device = false) const;
+
+    HaloExchangeHandle exchange_begin(array::Array& array, bool on_device = false) const {
+        return exchange_begin(std::vector<array::Array*>{&array}, on_device);
+    }
 
-    idx_t index(idx_t i, idx_t j, idx_t ni, idx_t /*nj*/) const { return (i + ni * j); }
+    /// @brief Wait for completion of an exchange started with exchange_begin() and unpack the halos
+    void exchange_end(HaloExchangeHandle&) const;
 
+    /// @brief Local indices whose values are not modified by the halo exchange
+    ///
+    /// Values at these indices are available while an exchange is in flight.
+    std::vector<idx_t> interior_indices() const;
+
+    /// @brief Access the persistent plan for exchanging fields with given datatype and variables per point
+    ///
+    /// The plan is created on first access and kept alive for the lifetime of this HaloExchange.
     template <typename DATA_TYPE>
-    void counts_displs_setup(const idx_t var_size, std::vector<int>& send_counts_init,
-                             std::vector<int>& recv_counts_init, std::vector<int>& send_counts,
-                             std::vector<int>& recv_counts, std::vector<int>& send_displs,
-                             std::vector<int>& recv_displs) const;
+    HaloExchangePlan& plan(idx_t var_size, bool on_device = false) const {
+        return plan(array::DataType::kind<DATA_TYPE>(), sizeof(DATA_TYPE), var_size, on_device);
+    }
 
+    /// @brief Number of persistent plans created so far
+    size_t nb_plans() const;
 
-    template <typename DATA_TYPE>
-    void ireceive(int tag, std::vector<int>& recv_displs, std::vector<int>& recv_counts,
-                  std::vector<eckit::mpi::Request>& recv_req, DATA_TYPE* recv_buffer) const;
+private:  // methods
+    HaloExchangePlan& plan(array::DataType::kind_t, size_t datatype_size, idx_t var_size, bool on_device) const;
 
-    template <typename DATA_TYPE>
-    void isend_and_wait_for_receive(int tag, std::vector<int>& recv_counts_init,
-                                    std::vector<eckit::mpi::Request>& recv_req, std::vector<int>& send_displs,
-                                    std::vector<int>& send_counts, std::vector<eckit::mpi::Request>& send_req,
-                                    DATA_TYPE* send_buffer) const;
+    HaloExchangePlan& plan(const std::vector<array::Array*>& arrays) const;
+
+    std::unique_ptr<HaloExchangePlan> create_plan(const std::vector<array::Array*>& arrays) const;
+
+    void pack_arrays(const std::vector<array::Array*>& arrays, HaloExchangePlan&) const;
+
+    void unpack_arrays(const HaloExchangePlan&, const std::vector<array::Array*>& arrays) const;
+
+    idx_t index(idx_t i, idx_t j, idx_t k, idx_t ni, idx_t nj, idx_t /*nk*/) const { return (i + ni * (j + nj * k)); }
 
-    void wait_for_send(std::vector<int>& send_counts, std::vector<eckit::mpi::Request>& send_req) const;
+    idx_t index(idx_t i, idx_t j, idx_t ni, idx_t /*nj*/) const { return (i + ni * j); }
 
     template <typename DATA_TYPE>
-    DATA_TYPE* allocate_buffer(const int buffer_size, const bool on_device) const;
+    void ireceive(int tag, const std::vector<int>& recv_displs, const std::vector<int>& recv_counts,
+                  std::vector<eckit::mpi::Request>& recv_req, DATA_TYPE* recv_buffer) const;
 
     template <typename DATA_TYPE>
-    void deallocate_buffer(DATA_TYPE* buffer, const int buffer_size, const bool on_device) const;
+    void isend_and_wait_for_receive(int tag, const std::vector<int>& recv_counts,
+                                    std::vector<eckit::mpi::Request>& recv_req, const std::vector<int>& send_displs,
+                                    const std::vector<int>& send_counts, std::vector<eckit::mpi::Request>& send_req,
+                                    DATA_TYPE* send_buffer) const;
+
+    void wait_for_send(const std::vector<int>& send_counts, std::vector<eckit::mpi::Request>& send_req) const;
 
     template <int ParallelDim, typename DATA_TYPE, int RANK>
     void pack_send_buffer(const array::ArrayView<DATA_TYPE, RANK>& hfield,
@@ -142,6 +284,14 @@ private:  // data
     int myproc;
     const mpi::Comm* comm_;
 
+    using PlanKey = std::tuple<array::DataType::kind_t, idx_t, bool>;
+    mutable std::map<PlanKey, std::unique_ptr<HaloExchangePlan>> plans_;
+
+    using MultiPlanKey = std::vector<std::pair<array::DataType::kind_t, idx_t>>;
+    mutable std::map<MultiPlanKey, std::unique_ptr<HaloExchangePlan>> multi_plans_;
+    mutable std::mutex plans_mutex_;
+    mutable std::atomic<int> nb_exchanges_in_flight_{0};  // split-phase exchanges not yet completed
+
 public:
     struct Backdoor {
         int parsize;
@@ -163,43 +313,33 @@ void HaloExchange::execute(array::Array& field, bool on_device) const {
     idx_t var_size            = array::get_var_size<parallelDim>(field_hv);
 
     int tag(1);
-    std::size_t nproc_loc(static_cast<std::size_t>(nproc));
-    std::vector<int> inner_counts(nproc_loc), halo_counts(nproc_loc);
-    std::vector<int> inner_counts_init(nproc_loc), halo_counts_init(nproc_loc);
-    std::vector<int> inner_displs(nproc_loc), halo_displs(nproc_loc);
-    std::vector<eckit::mpi::Request> inner_req(nproc_loc), halo_req(nproc_loc);
+    HaloExchangePlan& p = plan<DATA_TYPE>(var_size, on_device);
 
-    int inner_size          = sendcnt_ * var_size;
-    int halo_size           = recvcnt_ * var_size;
-    DATA_TYPE* inner_buffer = allocate_buffer<DATA_TYPE>(inner_size, on_device);
-    DATA_TYPE* halo_buffer  = allocate_buffer<DATA_TYPE>(halo_size, on_device);
+    int inner_size          = p.send_size();
+    int halo_size           = p.recv_size();
+    DATA_TYPE* inner_buffer = p.send_buffer<DATA_TYPE>();
+    DATA_TYPE* halo_buffer  = p.recv_buffer<DATA_TYPE>();
 
 #if ATLAS_HAVE_GPU
     if (on_device) {
-        ATLAS_ASSERT( is_device_accessible(inner_buffer) );
-        ATLAS_ASSERT( is_device_accessible(halo_buffer) );
+        ATLAS_ASSERT( inner_size == 0 || is_device_accessible(inner_buffer) );
+        ATLAS_ASSERT( halo_size == 0 || is_device_accessible(halo_buffer) );
         ATLAS_ASSERT( is_device_accessible(field_dv.data()) );
     }
 #endif
 
-    counts_displs_setup<DATA_TYPE>(var_size, inner_counts_init, halo_counts_init, inner_counts, halo_counts,
-                                   inner_displs, halo_displs);
-
-    ireceive<DATA_TYPE>(tag, halo_displs, halo_counts, halo_req, halo_buffer);
+    ireceive<DATA_TYPE>(tag, p.recv_displs, p.recv_counts, p.recv_req, halo_buffer);
 
     /// Pack
     pack_send_buffer<parallelDim>(field_hv, field_dv, inner_buffer, inner_size, on_device);
 
-    isend_and_wait_for_receive<DATA_TYPE>(tag, halo_counts_init, halo_req, inner_displs, inner_counts, inner_req,
+    isend_and_wait_for_receive<DATA_TYPE>(tag, p.recv_counts, p.recv_req, p.send_displs, p.send_counts, p.send_req,
                                           inner_buffer);
 
     /// Unpack
     unpack_recv_buffer<parallelDim>(halo_buffer, halo_size, field_hv, field_dv, on_device);
 
-    wait_for_send(inner_counts_init, inner_req);
-
-    deallocate_buffer<DATA_TYPE>(inner_buffer, inner_size, on_device);
-    deallocate_buffer<DATA_TYPE>(halo_buffer, halo_size, on_device);
+    wait_for_send(p.send_counts, p.send_req);
 }
 
 template <typename DATA_TYPE, int RANK, typename ParallelDim>
@@ -218,84 +358,35 @@ void HaloExchange::execute_adjoint(array::Array& field, bool on_device) const {
     idx_t var_size            = array::get_var_size<parallelDim>(field_hv);
 
     int tag(1);
-    std::size_t nproc_loc(static_cast<std::size_t>(nproc));
-    std::vector<int> halo_counts(nproc_loc), inner_counts(nproc_loc);
-    std::vector<int> halo_counts_init(nproc_loc), inner_counts_init(nproc_loc);
-    std::vector<int> halo_displs(nproc_loc), inner_displs(nproc_loc);
-    std::vector<eckit::mpi::Request> halo_req(nproc_loc), inner_req(nproc_loc);
-
-    int halo_size           = sendcnt_ * var_size;
-    int inner_size          = recvcnt_ * var_size;
-    DATA_TYPE* halo_buffer  = allocate_buffer<DATA_TYPE>(halo_size, on_device);
-    DATA_TYPE* inner_buffer = allocate_buffer<DATA_TYPE>(inner_size, on_device);
+    HaloExchangePlan& p = plan<DATA_TYPE>(var_size, on_device);
 
-    counts_displs_setup<DATA_TYPE>(var_size, halo_counts_init, inner_counts_init, halo_counts, inner_counts,
-                                   halo_displs, inner_displs);
+    // The adjoint exchange reverses the roles of the plan's buffers: contributions accumulated in
+    // the halo are sent back, and received into the buffer of owned points.
+    int halo_size           = p.send_size();
+    int inner_size          = p.recv_size();
+    DATA_TYPE* halo_buffer  = p.send_buffer<DATA_TYPE>();
+    DATA_TYPE* inner_buffer = p.recv_buffer<DATA_TYPE>();
 
-    ireceive<DATA_TYPE>(tag, halo_displs, halo_counts, halo_req, halo_buffer);
+    ireceive<DATA_TYPE>(tag, p.send_displs, p.send_counts, p.send_req, halo_buffer);
 
     /// Pack
     pack_recv_adjoint_buffer<parallelDim>(field_hv, field_dv, inner_buffer, inner_size, on_device);
 
     /// Send
-    isend_and_wait_for_receive<DATA_TYPE>(tag, halo_counts_init, halo_req, inner_displs, inner_counts, inner_req,
+    isend_and_wait_for_receive<DATA_TYPE>(tag, p.send_counts, p.send_req, p.recv_displs, p.recv_counts, p.recv_req,
                                           inner_buffer);
 
     /// Unpack
     unpack_send_adjoint_buffer<parallelDim>(halo_buffer, halo_size, field_hv, field_dv, on_device);
 
     /// Wait for sending to finish
-    wait_for_send(inner_counts_init, inner_req);
+    wait_for_send(p.recv_counts, p.recv_req);
 
     zero_halos<parallelDim>(field_hv, field_dv, halo_buffer, halo_size, on_device);
-
-    deallocate_buffer<DATA_TYPE>(halo_buffer, halo_size, on_device);
-    deallocate_buffer<DATA_TYPE>(inner_buffer, inner_size, on_device);
 }
 
 template <typename DATA_TYPE>
-DATA_TYPE* HaloExchange::allocate_buffer(const int buffer_size, const bool on_device) const {
-    DATA_TYPE* buffer{nullptr};
-
-    if (on_device) {
-        util::allocate_devicemem(buffer, buffer_size);
-    }
-    else {
-        util::allocate_hostmem(buffer, buffer_size);
-    }
-
-    return buffer;
-}
-
-
-template <typename DATA_TYPE>
-void HaloExchange::deallocate_buffer(DATA_TYPE* buffer, const int buffer_size, const bool on_device) const {
-    if (on_device) {
-        util::delete_devicemem(buffer, buffer_size);
-    }
-    else {
-        util::delete_hostmem(buffer, buffer_size);
-    }
-}
-
-
-template <typename DATA_TYPE>
-void HaloExchange::counts_displs_setup(const idx_t var_size, std::vector<int>& send_counts_init,
-                                       std::vector<int>& recv_counts_init, std::vector<int>& send_counts,
-                                       std::vector<int>& recv_counts, std::vector<int>& send_displs,
-                                       std::vector<int>& recv_displs) const {
-    for (size_t jproc = 0; jproc < static_cast<size_t>(nproc); ++jproc) {
-        send_counts_init[jproc] = sendcounts_[jproc];
-        recv_counts_init[jproc] = recvcounts_[jproc];
-        send_counts[jproc]      = sendcounts_[jproc] * var_size;
-        recv_counts[jproc]      = recvcounts_[jproc] * var_size;
-        send_displs[jproc]      = senddispls_[jproc] * var_size;
-        recv_displs[jproc]      = recvdispls_[jproc] * var_size;
-    }
-}
-
-template <typename DATA_TYPE>
-void HaloExchange::ireceive(int tag, std::vector<int>& recv_displs, std::vector<int>& recv_counts,
+void HaloExchange::ireceive(int tag, const std::vector<int>& recv_displs, const std::vector<int>& recv_counts,
                             std::vector<eckit::mpi::Request>& recv_req, DATA_TYPE* recv_buffer) const {
     ATLAS_TRACE_MPI(IRECEIVE) {
         /// Let MPI know what we like to receive
@@ -309,9 +400,10 @@ void HaloExchange::ireceive(int tag, std::vector<int>& recv_displs, std::vector<
 }
 
 template <typename DATA_TYPE>
-void HaloExchange::isend_and_wait_for_receive(int tag, std::vector<int>& recv_counts_init,
-                                              std::vector<eckit::mpi::Request>& recv_req, std::vector<int>& send_displs,
-                                              std::vector<int>& send_counts, std::vector<eckit::mpi::Request>& send_req,
+void HaloExchange::isend_and_wait_for_receive(int tag, const std::vector<int>& recv_counts,
+                                              std::vector<eckit::mpi::Request>& recv_req,
+                                              const std::vector<int>& send_displs, const std::vector<int>& send_counts,
+                                              std::vector<eckit::mpi::Request>& send_req,
                                               DATA_TYPE* send_buffer) const {
     /// Send
     ATLAS_TRACE_MPI(ISEND) {
@@ -325,7 +417,7 @@ void HaloExchange::isend_and_wait_for_receive(int tag, std::vector<int>& recv_co
     /// Wait for receiving to finish
     ATLAS_TRACE_MPI(WAIT, "mpi-wait receive") {
         for (size_t jproc = 0; jproc < static_cast<size_t>(nproc); ++jproc) {
-            if (recv_counts_init[jproc] > 0) {
+            if (recv_counts[jproc] > 0) {
                 comm().wait(recv_req[jproc]);
             }
         }
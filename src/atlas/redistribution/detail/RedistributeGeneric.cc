@@ -5,7 +5,10 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <algorithm>
 #include <numeric>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "atlas/field/Field.h"
@@ -30,7 +33,7 @@ using mesh::Nodes;
 // Helper type definitions and functions for redistribution.
 namespace {
 
-// Define index-UID struct. (Needed to overload "<").
+// Define index-UID struct.
 struct IdxUid : public std::pair<idx_t, uidx_t> {
     using std::pair<idx_t, uidx_t>::pair;
 };
@@ -128,92 +131,150 @@ std::vector<IdxUid> getUidVec(const FunctionSpace& functionspace) {
     return uidVec;
 }
 
-// Copy UID index
-std::vector<idx_t> getUidIdx(const std::vector<IdxUid>& uidVec) {
-    auto idxVec = std::vector<idx_t>{};
-    idxVec.reserve(uidVec.size());
-    std::transform(uidVec.begin(), uidVec.end(), std::back_inserter(idxVec),
-                   [](const IdxUid& uid) { return uid.first; });
-    return idxVec;
+// Home PE of a UID in the distributed UID directory.
+int getHomePe(uidx_t uid, size_t mpi_size) {
+    using unsigned_uidx_t = std::make_unsigned_t<uidx_t>;
+    return static_cast<int>(static_cast<unsigned_uidx_t>(uid) % static_cast<unsigned_uidx_t>(mpi_size));
 }
 
-// Copy UID value
-std::vector<uidx_t> getUidVal(const std::vector<IdxUid>& uidVec) {
-    auto valVec = std::vector<uidx_t>{};
-    valVec.reserve(uidVec.size());
-    std::transform(uidVec.begin(), uidVec.end(), std::back_inserter(valVec),
-                   [](const IdxUid& uid) { return uid.second; });
-    return valVec;
-}
+// Exchange per-PE buckets with all other PEs. Only the bucket contents and one count per PE are
+// communicated, so memory scales with the local rather than the global number of elements.
+// Returns receive buffer, and sets the number of values received from each PE.
+template <typename Value>
+std::vector<Value> exchangeBuckets(const mpi::Comm& comm, const std::vector<std::vector<Value>>& sendBuckets,
+                                   std::vector<int>& recvCounts) {
+    const auto mpi_size = comm.size();
 
-// Communicate UID values, return receive buffer and displacements.
-std::pair<std::vector<uidx_t>, std::vector<int>> communicateUid(const std::string& mpi_comm, const std::vector<uidx_t>& sendBuffer) {
-    auto& comm = mpi::comm(mpi_comm);
-    auto counts = std::vector<int>(comm.size());
-    comm.allGather(static_cast<int>(sendBuffer.size()), counts.begin(), counts.end());
+    auto sendCounts = std::vector<int>(mpi_size);
+    for (size_t i = 0; i < mpi_size; ++i) {
+        sendCounts[i] = static_cast<int>(sendBuckets[i].size());
+    }
+    recvCounts.resize(mpi_size);
+    comm.allToAll(sendCounts, recvCounts);
+
+    auto sendDisps = std::vector<int>(mpi_size, 0);
+    auto recvDisps = std::vector<int>(mpi_size, 0);
+    for (size_t i = 1; i < mpi_size; ++i) {
+        sendDisps[i] = sendDisps[i - 1] + sendCounts[i - 1];
+        recvDisps[i] = recvDisps[i - 1] + recvCounts[i - 1];
+    }
 
-    auto disps = std::vector<int>{};
-    disps.reserve(comm.size() + 1);
-    disps.push_back(0);
-    std::partial_sum(counts.begin(), counts.end(), std::back_inserter(disps));
+    auto sendBuffer = std::vector<Value>{};
+    sendBuffer.reserve(static_cast<size_t>(sendDisps.back() + sendCounts.back()));
+    for (const auto& bucket : sendBuckets) {
+        sendBuffer.insert(sendBuffer.end(), bucket.begin(), bucket.end());
+    }
+    auto recvBuffer = std::vector<Value>(static_cast<size_t>(recvDisps.back() + recvCounts.back()));
 
+    comm.allToAllv(sendBuffer.data(), sendCounts.data(), sendDisps.data(), recvBuffer.data(), recvCounts.data(),
+                   recvDisps.data());
+    return recvBuffer;
+}
 
-    auto recvBuffer = std::vector<uidx_t>(static_cast<size_t>(disps.back()));
+// Send local UIDs to their home PE. Returns received UIDs paired with the PE they came from.
+std::vector<std::pair<uidx_t, int>> registerUids(const mpi::Comm& comm, const std::vector<IdxUid>& localUids) {
+    const auto mpi_size = comm.size();
 
-    comm.allGatherv(sendBuffer.begin(), sendBuffer.end(), recvBuffer.begin(), counts.data(), disps.data());
+    auto sendBuckets = std::vector<std::vector<uidx_t>>(mpi_size);
+    for (const auto& idxUid : localUids) {
+        sendBuckets[getHomePe(idxUid.second, mpi_size)].push_back(idxUid.second);
+    }
 
-    return std::make_pair(recvBuffer, disps);
+    auto recvCounts = std::vector<int>{};
+    const auto recvUids = exchangeBuckets(comm, sendBuckets, recvCounts);
+
+    auto directory = std::vector<std::pair<uidx_t, int>>{};
+    directory.reserve(recvUids.size());
+    size_t i = 0;
+    for (size_t pe = 0; pe < mpi_size; ++pe) {
+        for (int j = 0; j < recvCounts[pe]; ++j) {
+            directory.emplace_back(recvUids[i++], static_cast<int>(pe));
+        }
+    }
+    std::sort(directory.begin(), directory.end());
+    return directory;
 }
 
-// Need to overload "<" operator for comparison of asymmetric types in
-// std::set_intersection.
-bool operator<(const IdxUid& lhs, const uidx_t& rhs) {
-    return lhs.second < rhs;
-}
-bool operator<(const uidx_t& lhs, const IdxUid& rhs) {
-    return lhs < rhs.second;
-}
+// Given source and target UIDs owned locally, find for each the PE owning the same UID in the
+// other functionspace, using a distributed directory of UIDs.
+std::pair<std::vector<std::vector<uidx_t>>, std::vector<std::vector<uidx_t>>> matchUids(
+    const mpi::Comm& comm, const std::vector<IdxUid>& sourceUids, const std::vector<IdxUid>& targetUids) {
+    const auto mpi_size = comm.size();
+
+    // Directory entries for the UIDs this PE is home of.
+    const auto sourceDirectory = registerUids(comm, sourceUids);
+    const auto targetDirectory = registerUids(comm, targetUids);
+
+    // Resolve matches. Notify source owner of the target PE, and target owner of the source PE.
+    auto notifySourceUid = std::vector<std::vector<uidx_t>>(mpi_size);
+    auto notifySourcePe  = std::vector<std::vector<int>>(mpi_size);
+    auto notifyTargetUid = std::vector<std::vector<uidx_t>>(mpi_size);
+    auto notifyTargetPe  = std::vector<std::vector<int>>(mpi_size);
+    auto sourceIt        = sourceDirectory.begin();
+    for (const auto& target : targetDirectory) {
+        sourceIt = std::lower_bound(sourceIt, sourceDirectory.end(), target,
+                                    [](const std::pair<uidx_t, int>& a, const std::pair<uidx_t, int>& b) {
+                                        return a.first < b.first;
+                                    });
+        if (sourceIt == sourceDirectory.end() || sourceIt->first != target.first) {
+            continue;
+        }
+        const int sourcePe = sourceIt->second;
+        const int targetPe = target.second;
+        notifySourceUid[sourcePe].push_back(target.first);
+        notifySourcePe[sourcePe].push_back(targetPe);
+        notifyTargetUid[targetPe].push_back(target.first);
+        notifyTargetPe[targetPe].push_back(sourcePe);
+    }
 
-// Find the intersection between local and global UIDs, then return local
-// indices of incections and PE dispacements in vector.
-std::pair<std::vector<idx_t>, std::vector<int>> getUidIntersection(const std::string& mpi_comm,
-                                                                   const std::vector<IdxUid>& localUids,
-                                                                   const std::vector<uidx_t>& globalUids,
-                                                                   const std::vector<int>& globalDisps) {
-    auto uidIntersection = std::vector<IdxUid>{};
-    uidIntersection.reserve(localUids.size());
+    auto recvCounts = std::vector<int>{};
 
-    auto& comm = mpi::comm(mpi_comm);
-    auto mpi_size = comm.size();
+    auto bucketByPe = [&](const std::vector<uidx_t>& uids, const std::vector<int>& pes) {
+        auto buckets = std::vector<std::vector<uidx_t>>(mpi_size);
+        for (size_t i = 0; i < uids.size(); ++i) {
+            buckets[pes[i]].push_back(uids[i]);
+        }
+        // Both sides of a pair order the shared UIDs by value.
+        for (auto& bucket : buckets) {
+            std::sort(bucket.begin(), bucket.end());
+        }
+        return buckets;
+    };
 
-    auto disps = std::vector<int>{};
-    disps.reserve(mpi_size + 1);
-    disps.push_back(0);
+    const auto sendToUids = exchangeBuckets(comm, notifySourceUid, recvCounts);
+    const auto sendToPes  = exchangeBuckets(comm, notifySourcePe, recvCounts);
+    const auto recvFromUids = exchangeBuckets(comm, notifyTargetUid, recvCounts);
+    const auto recvFromPes  = exchangeBuckets(comm, notifyTargetPe, recvCounts);
 
-    // Loop over all PE and find UID intersection.
-    for (size_t i = 0; i < mpi_size; ++i) {
-        // Get displaced iterators.
-        auto globalUidsBegin = globalUids.begin() + globalDisps[i];
-        auto globalUidsEnd   = globalUids.begin() + globalDisps[i + 1];
+    return std::make_pair(bucketByPe(sendToUids, sendToPes), bucketByPe(recvFromUids, recvFromPes));
+}
 
-        // Get intersection.
-        std::set_intersection(localUids.begin(), localUids.end(), globalUidsBegin, globalUidsEnd,
-                              std::back_inserter(uidIntersection));
+// Convert per-PE buckets of UIDs to local indices and PE displacements.
+std::pair<std::vector<idx_t>, std::vector<int>> getLocalIdx(const std::vector<IdxUid>& localUids,
+                                                            const std::vector<std::vector<uidx_t>>& uidBuckets) {
+    auto localIdx = std::vector<idx_t>{};
+    localIdx.reserve(localUids.size());
+
+    auto disps = std::vector<int>{};
+    disps.reserve(uidBuckets.size() + 1);
+    disps.push_back(0);
 
-        // Set intersection displacement.
-        disps.push_back(static_cast<int>(uidIntersection.size()));
+    for (const auto& bucket : uidBuckets) {
+        for (const uidx_t uid : bucket) {
+            auto it = std::lower_bound(localUids.begin(), localUids.end(), uid,
+                                       [](const IdxUid& a, const uidx_t& b) { return a.second < b; });
+            ATLAS_ASSERT(it != localUids.end() && it->second == uid);
+            localIdx.push_back(it->first);
+        }
+        disps.push_back(static_cast<int>(localIdx.size()));
     }
 
-    // Check that the set of all intersections matches UIDs on local PE.
+    // Check that the set of all matches covers the UIDs on local PE.
     if (ATLAS_BUILD_TYPE_DEBUG) {
-        auto tempUids = uidIntersection;
-        std::sort(tempUids.begin(), tempUids.end(),
-                  [](const IdxUid& a, const IdxUid& b) { return a.second < b.second; });
-        ATLAS_ASSERT(tempUids == localUids, "Set of all UID intersections does not match local UIDs.");
+        ATLAS_ASSERT(localIdx.size() == localUids.size(), "Set of all UID intersections does not match local UIDs.");
     }
 
-    // Return local indices of intersection and displacements.
-    return make_pair(getUidIdx(uidIntersection), disps);
+    return std::make_pair(localIdx, disps);
 }
 
 
@@ -268,17 +329,16 @@ void RedistributeGeneric::do_setup() {
     const auto sourceUidVec = getUidVec(source());
     const auto targetUidVec = getUidVec(target());
 
-    // Communicate UID vectors to all PEs.
-    auto sourceGlobalUids                         = std::vector<uidx_t>{};
-    auto sourceGlobalDisps                        = std::vector<int>{};
-    std::tie(sourceGlobalUids, sourceGlobalDisps) = communicateUid(mpi_comm_, getUidVal(sourceUidVec));
-    auto targetGlobalUids                         = std::vector<uidx_t>{};
-    auto targetGlobalDisps                        = std::vector<int>{};
-    std::tie(targetGlobalUids, targetGlobalDisps) = communicateUid(mpi_comm_, getUidVal(targetUidVec));
-
-    // Get intersection of local UIDs and Global UIDs.
-    std::tie(sourceLocalIdx_, sourceDisps_) = getUidIntersection(mpi_comm_, sourceUidVec, targetGlobalUids, targetGlobalDisps);
-    std::tie(targetLocalIdx_, targetDisps_) = getUidIntersection(mpi_comm_, targetUidVec, sourceGlobalUids, sourceGlobalDisps);
+    // Match UIDs between source and target through a distributed directory, communicating only
+    // with the PEs that are home of, or share, locally owned UIDs.
+    const auto& comm = mpi::comm(mpi_comm_);
+    auto sendToUids   = std::vector<std::vector<uidx_t>>{};
+    auto recvFromUids = std::vector<std::vector<uidx_t>>{};
+    std::tie(sendToUids, recvFromUids) = matchUids(comm, sourceUidVec, targetUidVec);
+
+    // Get local indices and displacements per PE.
+    std::tie(sourceLocalIdx_, sourceDisps_) = getLocalIdx(sourceUidVec, sendToUids);
+    std::tie(targetLocalIdx_, targetDisps_) = getLocalIdx(targetUidVec, recvFromUids);
 }
 
 void RedistributeGeneric::execute(const Field& sourceField, Field& targetField) const {
@@ -17,6 +17,7 @@
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/trans/Trans.h"
+#include "atlas_io/detail/MappedFile.h"
 
 namespace atlas {
 namespace trans {
@@ -30,6 +31,22 @@ TransCacheFileEntry::TransCacheFileEntry(const eckit::PathName& path): buffer_(p
     dh->close();
 }
 
+TransCacheMappedEntry::TransCacheMappedEntry(const eckit::PathName& path) {
+    ATLAS_TRACE();
+    Log::debug() << "Mapping cache from file " << path << std::endl;
+    file_.reset(new io::MappedFile(path.asString()));
+}
+
+TransCacheMappedEntry::~TransCacheMappedEntry() = default;
+
+size_t TransCacheMappedEntry::size() const {
+    return file_->size();
+}
+
+const void* TransCacheMappedEntry::data() const {
+    return file_->data();
+}
+
 TransCacheMemoryEntry::TransCacheMemoryEntry(const void* data, size_t size): data_(data), size_(size) {
     ATLAS_ASSERT(data_);
     ATLAS_ASSERT(size_);
@@ -47,6 +64,9 @@ LegendreFFTCache::LegendreFFTCache(const eckit::PathName& legendre_path, const e
 LegendreCache::LegendreCache(const eckit::PathName& path):
     Cache(std::shared_ptr<TransCacheEntry>(new TransCacheFileEntry(path))) {}
 
+MappedLegendreCache::MappedLegendreCache(const eckit::PathName& path):
+    Cache(std::shared_ptr<TransCacheEntry>(new TransCacheMappedEntry(path))) {}
+
 LegendreCache::LegendreCache(size_t size): Cache(std::make_shared<TransCacheOwnedMemoryEntry>(size)) {}
 
 LegendreCache::LegendreCache(const void* address, size_t size):
@@ -26,6 +26,9 @@ class FieldSet;
 class FunctionSpace;
 class Grid;
 class Domain;
+namespace io {
+class MappedFile;
+}  // namespace io
 namespace trans {
 class TransImpl;
 class Trans;
@@ -68,6 +71,22 @@ public:
 
 //-----------------------------------------------------------------------------
 
+/// Cache file mapped into memory, so that all processes on a node share the same physical pages through the page
+/// cache. Only the pages which are accessed are read from the file. The cache is never written to through the
+/// (copy-on-write) mapping, so that its pages are never copied.
+class TransCacheMappedEntry final : public TransCacheEntry {
+private:
+    std::unique_ptr<io::MappedFile> file_;
+
+public:
+    TransCacheMappedEntry(const eckit::PathName& path);
+    virtual ~TransCacheMappedEntry() override;
+    virtual size_t size() const override;
+    virtual const void* data() const override;
+};
+
+//-----------------------------------------------------------------------------
+
 class TransCacheMemoryEntry final : public TransCacheEntry {
 public:
     TransCacheMemoryEntry(const void* data, size_t size);
@@ -129,6 +148,14 @@ public:
     LegendreCache(const eckit::PathName& path);
 };
 
+/// Legendre cache file mapped into memory instead of being read into a private buffer, see TransCacheMappedEntry.
+/// A cache written by TransLocal starts with a header which is validated against the transform,
+/// so that a cache of another grid, truncation or precision is rejected before its body is accessed.
+class MappedLegendreCache : public Cache {
+public:
+    MappedLegendreCache(const eckit::PathName& path);
+};
+
 class LegendreFFTCache : public Cache {
 public:
     LegendreFFTCache(const void* legendre_address, size_t legendre_size, const void* fft_address, size_t fft_size);
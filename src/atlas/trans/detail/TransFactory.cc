@@ -25,6 +25,7 @@
 #include "atlas/trans/Trans.h"
 
 #include "atlas/trans/local/TransLocal.h"
+#include "atlas/trans/local/TransLocalStructuredColumns.h"
 #if ATLAS_HAVE_TRANS
 #include "atlas/trans/ifs/TransIFS.h"
 #include "atlas/trans/ifs/TransIFSNodeColumns.h"
@@ -40,6 +41,7 @@ void force_link() {
     static struct Link {
         Link() {
             TransBuilderGrid<TransLocal>();
+            TransBuilderFunctionSpace<TransLocalStructuredColumns>();
 #if ATLAS_HAVE_TRANS
             TransBuilderGrid<TransIFS>();
             TransBuilderFunctionSpace<TransIFSStructuredColumns>();
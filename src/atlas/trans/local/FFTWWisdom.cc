@@ -0,0 +1,181 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/trans/local/FFTWWisdom.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#include "eckit/config/LibResource.h"
+#include "eckit/filesystem/PathExpander.h"
+#include "eckit/filesystem/PathName.h"
+
+#include "atlas/library/Library.h"
+#include "atlas/library/defines.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/trans/Cache.h"
+
+#if ATLAS_HAVE_FFTW
+#include "fftw3.h"
+#endif
+
+namespace atlas {
+namespace trans {
+
+namespace {
+
+std::string single_precision_path(const std::string& path) {
+    return path + ".single";
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+void write_file(const std::string& path, const std::string& content) {
+    // Write to a temporary file first, so that concurrent readers never see a partial file
+    std::string tmp = path + ".tmp." + std::to_string(::getpid());
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (not file) {
+            throw_Exception("Cannot open FFTW wisdom file " + tmp + " for writing", Here());
+        }
+        file << content;
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw_Exception("Cannot rename FFTW wisdom file " + tmp + " to " + path, Here());
+    }
+}
+
+#if ATLAS_HAVE_FFTW
+bool import_wisdom(const std::string& wisdom, bool single_precision) {
+    if (single_precision) {
+#if ATLAS_HAVE_FFTW_SINGLE
+        return fftwf_import_wisdom_from_string(wisdom.c_str());
+#else
+        return true;  // not used without single precision FFTW library
+#endif
+    }
+    return fftw_import_wisdom_from_string(wisdom.c_str());
+}
+
+std::string export_wisdom(bool single_precision) {
+    char* wisdom = nullptr;
+    if (single_precision) {
+#if ATLAS_HAVE_FFTW_SINGLE
+        wisdom = fftwf_export_wisdom_to_string();
+#endif
+    }
+    else {
+        wisdom = fftw_export_wisdom_to_string();
+    }
+    std::string str(wisdom ? wisdom : "");
+    std::free(wisdom);
+    return str;
+}
+#endif
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+FFTWWisdom& FFTWWisdom::instance() {
+    static FFTWWisdom wisdom;
+    return wisdom;
+}
+
+FFTWWisdom::FFTWWisdom() {
+    path_ = eckit::PathExpander::expand(
+        eckit::LibResource<std::string, Library>("atlas-fftw-wisdom;$ATLAS_FFTW_WISDOM", ""));
+}
+
+std::unique_lock<std::mutex> FFTWWisdom::lock() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (not loaded_) {
+        loaded_ = true;
+        if (not path_.empty()) {
+            load_files(path_);
+        }
+    }
+    return lock;
+}
+
+void FFTWWisdom::import(const TransCacheEntry& entry, bool single_precision) {
+    if (not entry) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+#if ATLAS_HAVE_FFTW
+    std::string wisdom(static_cast<const char*>(entry.data()), entry.size());
+    if (not import_wisdom(wisdom, single_precision)) {
+        Log::warning() << "Could not import FFTW wisdom from cache" << std::endl;
+    }
+#endif
+}
+
+void FFTWWisdom::load(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    load_files(path);
+}
+
+void FFTWWisdom::save() {
+    if (modified_ && not path_.empty()) {
+        if (mpi::comm().rank() == 0) {
+            save(path_);
+        }
+        modified_ = false;
+    }
+}
+
+void FFTWWisdom::save(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    save_files(path);
+}
+
+void FFTWWisdom::load_files(const std::string& path) {
+#if ATLAS_HAVE_FFTW
+    for (bool single_precision : {false, true}) {
+        std::string file = single_precision ? single_precision_path(path) : path;
+        if (eckit::PathName(file).exists()) {
+            Log::debug() << "Loading FFTW wisdom from " << file << std::endl;
+            if (not import_wisdom(read_file(file), single_precision)) {
+                Log::warning() << "Could not import FFTW wisdom from " << file << std::endl;
+            }
+        }
+    }
+#endif
+}
+
+void FFTWWisdom::save_files(const std::string& path) const {
+#if ATLAS_HAVE_FFTW
+    for (bool single_precision : {false, true}) {
+        std::string wisdom = export_wisdom(single_precision);
+        if (not wisdom.empty()) {
+            std::string file = single_precision ? single_precision_path(path) : path;
+            Log::debug() << "Saving FFTW wisdom to " << file << std::endl;
+            write_file(file, wisdom);
+        }
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace trans
+}  // namespace atlas
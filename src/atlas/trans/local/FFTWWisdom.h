@@ -0,0 +1,79 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+namespace atlas {
+namespace trans {
+
+class TransCacheEntry;
+
+//-----------------------------------------------------------------------------
+
+/// @class FFTWWisdom
+///
+/// Process-wide registry of FFTW wisdom, shared by all TransLocal instances.
+///
+/// FFTW plans created with a planning effort other than "estimate" are expensive to create. The wisdom
+/// gathered while planning is kept by FFTW for the whole process, so that any later plan of compatible
+/// size is created instantly. This registry additionally persists the wisdom across processes:
+/// - it is loaded once, before the first plan is created, from the file given by the resource
+///   "atlas-fftw-wisdom" or environment variable ATLAS_FFTW_WISDOM (if the file exists),
+/// - it can be imported from any TransCacheEntry, e.g. a TransCacheMemoryEntry,
+/// - when new wisdom was gathered, it is saved back to the same file by atlas::finalise() on MPI rank 0.
+///
+/// Double precision wisdom is stored in the given file, single precision wisdom in the same file with
+/// suffix ".single".
+class FFTWWisdom {
+public:
+    static FFTWWisdom& instance();
+
+    /// Lock to hold while creating plans, as the FFTW planner is not thread-safe.
+    /// The wisdom file is loaded when the lock is taken for the first time.
+    std::unique_lock<std::mutex> lock();
+
+    /// Import wisdom in given precision, as exported by FFTW or by write_fft
+    void import(const TransCacheEntry&, bool single_precision = false);
+
+    /// Notify that plans were created with more planning effort than "estimate", which gathered new wisdom
+    void planned() { modified_ = true; }
+
+    /// Path of the wisdom file, empty when not configured
+    const std::string& path() const { return path_; }
+
+    /// Save the wisdom in both precisions to the configured path, if new wisdom was gathered
+    void save();
+
+    /// Save the wisdom in both precisions to given path
+    void save(const std::string& path) const;
+
+    /// Load the wisdom in both precisions from given path, if the files exist
+    void load(const std::string& path);
+
+private:
+    FFTWWisdom();
+    void load_files(const std::string& path);
+    void save_files(const std::string& path) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::string path_;
+    bool loaded_{false};
+    std::atomic<bool> modified_{false};
+};
+
+//-----------------------------------------------------------------------------
+
+}  // namespace trans
+}  // namespace atlas
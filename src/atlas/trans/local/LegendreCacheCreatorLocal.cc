@@ -57,6 +57,11 @@ std::string hash(const eckit::Configuration& config) {
 
     // Add options and other unique keys
     h << "flt" << config.getBool("flt", false);
+    // The Legendre cache is stored in the precision of the transform
+    // (only added for single precision, to keep the identifiers of existing double precision caches)
+    if (config.getString("precision", "double") == "single") {
+        h << "precision" << "single";
+    }
 
     return truncate(h.digest());
 }
@@ -146,7 +151,8 @@ Cache LegendreCacheCreatorLocal::create() const {
 }
 
 size_t LegendreCacheCreatorLocal::estimate() const {
-    return size_t(truncation_ * truncation_ * truncation_) / 2 * sizeof(double);
+    const size_t value_size = config_.getString("precision", "double") == "single" ? sizeof(float) : sizeof(double);
+    return size_t(truncation_ * truncation_ * truncation_) / 2 * value_size;
 }
 
 
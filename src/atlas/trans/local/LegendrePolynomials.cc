@@ -35,6 +35,9 @@ void compute_zfn(const int trc, double zfn[]) {
         }
         iodd                = jn % 2;
         zfn[idxzfn(jn, jn)] = zfnn;
+        if (iodd) {
+            zfn[idxzfn(jn, 0)] = 0.;
+        }
         for (int jgl = 2; jgl <= jn - iodd; jgl += 2) {
             double zfjn = ((jgl - 1.) * (2. * jn - jgl + 2.));  // new factor numerator
             double zfjd = (jgl * (2. * jn - jgl + 1.));         // new factor denominator
@@ -48,7 +51,7 @@ void compute_zfn(const int trc, double zfn[]) {
 void compute_legendre_polynomials_lat(const int trc,     // truncation (in)
                                       const double lat,  // latitude in radians (in)
                                       double legpol[],   // legendre polynomials
-                                      double zfn[]) {
+                                      const double zfn[]) {
     auto idxmn  = [&](int jm, int jn) { return (2 * trc + 3 - jm) * jm / 2 + jn - jm; };
     auto idxzfn = [&](int jn, int jk) { return jk + (trc + 1) * jn; };
     {  //ATLAS_TRACE( "compute Legendre polynomials" );
@@ -99,10 +102,9 @@ void compute_legendre_polynomials_lat(const int trc,     // truncation (in)
 
         // odd N
         for (int jn = 1; jn <= trc; jn += 2) {
-            zfn[idxzfn(jn, 0)] = 0.;
-            double zdlk        = 0.;
-            double zdlldn      = 0.0;
-            double zdsq        = 1. / std::sqrt(jn * (jn + 1.));
+            double zdlk   = 0.;
+            double zdlldn = 0.0;
+            double zdsq   = 1. / std::sqrt(jn * (jn + 1.));
             // represented by only even k
             for (int jk = 1; jk <= jn; jk += 2) {
                 // normalised ordinary Legendre polynomial == \overbar{P_n}^0
@@ -151,12 +153,14 @@ void compute_legendre_polynomials_lat(const int trc,     // truncation (in)
 }
 
 
-void compute_legendre_polynomials(
+namespace {
+template <typename Value>
+void compute_legendre_polynomials_impl(
     const int truncation,     // truncation (in)
     const int nlats,          // number of latitudes
     const double lats[],      // latitudes in radians (in)
-    double leg_sym[],         // values of associated Legendre functions, symmetric part
-    double leg_asym[],        // values of associated Legendre functions, asymmetric part
+    Value leg_sym[],          // values of associated Legendre functions, symmetric part
+    Value leg_asym[],         // values of associated Legendre functions, asymmetric part
     size_t leg_start_sym[],   // start indices for different zonal wave numbers, symmetric part
     size_t leg_start_asym[])  // start indices for different zonal wave numbers, asymmetric part
 {
@@ -194,17 +198,28 @@ void compute_legendre_polynomials(
                     size_t jn = size_t(ljn);
                     if ((jn - jm) % 2 == 0) {
                         size_t is   = leg_start_sym[jm] + is1 * jlat + is2++;
-                        leg_sym[is] = legpol[idxmn(jm, jn)];
+                        leg_sym[is] = static_cast<Value>(legpol[idxmn(jm, jn)]);
                     }
                     else {
                         size_t ia    = leg_start_asym[jm] + ia1 * jlat + ia2++;
-                        leg_asym[ia] = legpol[idxmn(jm, jn)];
+                        leg_asym[ia] = static_cast<Value>(legpol[idxmn(jm, jn)]);
                     }
                 }
             }
         }
     }
 }
+}  // namespace
+
+void compute_legendre_polynomials(const int trc, const int nlats, const double lats[], double legendre_sym[],
+                                  double legendre_asym[], size_t leg_start_sym[], size_t leg_start_asym[]) {
+    compute_legendre_polynomials_impl(trc, nlats, lats, legendre_sym, legendre_asym, leg_start_sym, leg_start_asym);
+}
+
+void compute_legendre_polynomials(const int trc, const int nlats, const double lats[], float legendre_sym[],
+                                  float legendre_asym[], size_t leg_start_sym[], size_t leg_start_asym[]) {
+    compute_legendre_polynomials_impl(trc, nlats, lats, legendre_sym, legendre_asym, leg_start_sym, leg_start_asym);
+}
 
 void compute_legendre_polynomials_all(const int truncation,  // truncation (in)
                                       const int nlats,       // number of latitudes
@@ -34,10 +34,10 @@ namespace trans {
 //
 void compute_zfn(const int trc, double zfn[]);
 
-void compute_legendre_polynomials_lat(const int trc,     // truncation (in)
-                                      const double lat,  // latitude in radians (in)
-                                      double legpol[],   // legendre polynomials
-                                      double zfn[]);
+void compute_legendre_polynomials_lat(const int trc,        // truncation (in)
+                                      const double lat,     // latitude in radians (in)
+                                      double legpol[],      // legendre polynomials
+                                      const double zfn[]);  // coefficients computed by compute_zfn (in)
 
 void compute_legendre_polynomials(
     const int trc,             // truncation (in)
@@ -48,6 +48,10 @@ void compute_legendre_polynomials(
     size_t leg_start_sym[],    // start indices for different zonal wave numbers, symmetric part
     size_t leg_start_asym[]);  // start indices for different zonal wave numbers, asymmetric part
 
+// Single precision storage; the polynomials are still computed in double precision
+void compute_legendre_polynomials(const int trc, const int nlats, const double lats[], float legendre_sym[],
+                                  float legendre_asym[], size_t leg_start_sym[], size_t leg_start_asym[]);
+
 void compute_legendre_polynomials_all(const int trc,        // truncation (in)
                                       const int nlats,      // number of latitudes
                                       const double lats[],  // latitudes in radians (in)
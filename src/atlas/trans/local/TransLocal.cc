@@ -10,9 +10,16 @@
 
 #include "atlas/trans/local/TransLocal.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <type_traits>
 
 #include "atlas/linalg/dense.h"
 #include "eckit/config/YAMLConfiguration.h"
@@ -22,20 +29,27 @@
 #include "eckit/log/Bytes.h"
 #include "eckit/log/JSON.h"
 #include "eckit/types/FloatCompare.h"
+#include "eckit/utils/MD5.h"
 
 #include "atlas/array.h"
 #include "atlas/field.h"
+#include "atlas/grid/Distribution.h"
 #include "atlas/grid/Iterator.h"
 #include "atlas/grid/StructuredGrid.h"
 #include "atlas/option.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/trans/Trans.h"
 #include "atlas/trans/VorDivToUV.h"
 #include "atlas/trans/detail/TransFactory.h"
+#include "atlas/trans/local/FFTWWisdom.h"
 #include "atlas/trans/local/LegendrePolynomials.h"
+#include "atlas/trans/local/TransLocalDistribution.h"
 #include "atlas/util/Constants.h"
+#include "atlas/util/Earth.h"
+#include "atlas/util/GaussianLatitudes.h"
 
 #include "atlas/library/defines.h"
 #if ATLAS_HAVE_FFTW
@@ -83,6 +97,10 @@ public:
 
     bool export_legendre() const { return config_.getBool("export_legendre", false); }
 
+    bool legendre_on_the_fly() const { return config_.getBool("legendre_on_the_fly", false); }
+
+    int legendre_block_size() const { return config_.getInt("legendre_block_size", 16); }
+
     int warning() const { return config_.getInt("warning", 1); }
 
     int fft() const {
@@ -97,6 +115,29 @@ public:
 
     std::string matrix_multiply() const { return config_.getString("matrix_multiply", ""); }
 
+#if ATLAS_HAVE_FFTW
+    unsigned fftw_planning() const {
+        static const std::map<std::string, unsigned> string_to_planning = {
+            {"estimate", FFTW_ESTIMATE}, {"measure", FFTW_MEASURE}, {"patient", FFTW_PATIENT}};
+        std::string planning = config_.getString("fftw_planning", "estimate");
+        if (string_to_planning.find(planning) == string_to_planning.end()) {
+            throw_Exception("TransLocal: unsupported fftw_planning \"" + planning +
+                                "\", expected \"estimate\", \"measure\" or \"patient\"",
+                            Here());
+        }
+        return string_to_planning.at(planning);
+    }
+#endif
+
+    bool single_precision() const {
+        std::string precision = config_.getString("precision", "double");
+        if (precision != "double" && precision != "single") {
+            throw_Exception("TransLocal: unsupported precision \"" + precision + "\", expected \"double\" or \"single\"",
+                            Here());
+        }
+        return precision == "single";
+    }
+
 
 private:
     const eckit::Configuration& config_;
@@ -156,6 +197,86 @@ struct WriteCache {
     size_t pos;
 };
 
+// Header of a Legendre cache, followed by the polynomials at offset legendre_cache_data_offset.
+// It identifies the polynomials, so that a cache computed for another truncation, other latitudes or in another
+// precision is rejected by reading the header only. Caches without header are accepted, and only checked by size.
+struct LegendreCacheHeader {
+    char magic[8];
+    std::uint32_t version;     // layout of the polynomials
+    std::uint32_t value_size;  // precision of the polynomials
+    std::int32_t truncation;
+    std::int32_t nlats;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+    char latitudes[32];  // MD5 digest of the latitudes
+};
+
+constexpr char legendre_cache_magic[8]         = {'A', 'T', 'L', 'A', 'S', 'L', 'G', '\0'};
+constexpr std::uint32_t legendre_cache_version = 1;
+constexpr size_t legendre_cache_data_offset    = 128;
+static_assert(sizeof(LegendreCacheHeader) <= legendre_cache_data_offset, "Legendre cache header too large");
+
+std::string legendre_latitudes_digest(const std::vector<double>& lats) {
+    eckit::MD5 h;
+    for (double lat : lats) {
+        h.add(std::lround(lat * 1.e12));
+    }
+    return h.digest();
+}
+
+// Header padded to legendre_cache_data_offset bytes
+std::vector<char> legendre_cache_header(int truncation, const std::vector<double>& lats, size_t value_size,
+                                        size_t data_size) {
+    LegendreCacheHeader header;
+    std::memset(&header, 0, sizeof(LegendreCacheHeader));
+    std::memcpy(header.magic, legendre_cache_magic, sizeof(legendre_cache_magic));
+    header.version     = legendre_cache_version;
+    header.value_size  = static_cast<std::uint32_t>(value_size);
+    header.truncation  = truncation;
+    header.nlats       = static_cast<std::int32_t>(lats.size());
+    header.data_offset = legendre_cache_data_offset;
+    header.data_size   = data_size;
+    std::string digest = legendre_latitudes_digest(lats);
+    std::memcpy(header.latitudes, digest.data(), std::min(digest.size(), sizeof(header.latitudes)));
+
+    std::vector<char> bytes(legendre_cache_data_offset, 0);
+    std::memcpy(bytes.data(), &header, sizeof(LegendreCacheHeader));
+    return bytes;
+}
+
+// Offset of the polynomials in the cache: 0 without header, otherwise after the header, which must match
+size_t validate_legendre_cache(const void* cache, size_t cache_size, int truncation, const std::vector<double>& lats,
+                               size_t value_size, size_t data_size) {
+    if (cache_size < sizeof(LegendreCacheHeader) ||
+        std::memcmp(cache, legendre_cache_magic, sizeof(legendre_cache_magic)) != 0) {
+        return 0;
+    }
+    LegendreCacheHeader header;
+    std::memcpy(&header, cache, sizeof(LegendreCacheHeader));
+    auto reject = [](const std::string& reason) {
+        throw_Exception("Legendre cache does not match the transform: " + reason, Here());
+    };
+    if (header.version != legendre_cache_version) {
+        reject("unsupported layout version " + std::to_string(header.version));
+    }
+    if (header.value_size != value_size) {
+        reject(std::string("polynomials are in ") + (header.value_size == sizeof(float) ? "single" : "double") +
+               " precision");
+    }
+    if (header.truncation != truncation) {
+        reject("truncation " + std::to_string(header.truncation) + " instead of " + std::to_string(truncation));
+    }
+    if (header.nlats != static_cast<std::int32_t>(lats.size()) ||
+        std::string(header.latitudes, sizeof(header.latitudes)) != legendre_latitudes_digest(lats)) {
+        reject("computed for other latitudes");
+    }
+    if (header.data_offset != legendre_cache_data_offset || header.data_size != data_size ||
+        header.data_offset + header.data_size != cache_size) {
+        reject("inconsistent size");
+    }
+    return header.data_offset;
+}
+
 }  // namespace
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -186,27 +307,31 @@ size_t num_n(const int truncation, const int m, const bool symmetric) {
 }
 
 
-void alloc_aligned(double*& ptr, size_t n) {
+template <typename Value>
+void alloc_aligned(Value*& ptr, size_t n) {
     const size_t alignment = 64 * sizeof(double);
-    size_t bytes           = sizeof(double) * n;
+    size_t bytes           = sizeof(Value) * n;
     int err                = posix_memalign((void**)&ptr, alignment, bytes);
     if (err) {
         throw_AllocationFailed(bytes, Here());
     }
 }
 
-void free_aligned(double*& ptr) {
+template <typename Value>
+void free_aligned(Value*& ptr) {
     free(ptr);
     ptr = nullptr;
 }
 
-void alloc_aligned(double*& ptr, size_t n, const char* msg) {
+template <typename Value>
+void alloc_aligned(Value*& ptr, size_t n, const char* msg) {
     ATLAS_ASSERT(msg);
-    Log::debug() << "TransLocal: allocating '" << msg << "': " << eckit::Bytes(sizeof(double) * n) << std::endl;
+    Log::debug() << "TransLocal: allocating '" << msg << "': " << eckit::Bytes(sizeof(Value) * n) << std::endl;
     alloc_aligned(ptr, n);
 }
 
-void free_aligned(double*& ptr, const char* msg) {
+template <typename Value>
+void free_aligned(Value*& ptr, const char* msg) {
     ATLAS_ASSERT(msg);
     Log::debug() << "TransLocal: deallocating '" << msg << "'" << std::endl;
     free_aligned(ptr);
@@ -245,6 +370,19 @@ bool using_eckit_default_backend(const std::string& linalg_backend_) {
     return false;
 };
 
+// Dense matrix type for the matrix multiplications in given precision
+template <typename Value>
+struct DenseMatrix;
+template <>
+struct DenseMatrix<double> {
+    using type = linalg::Matrix;
+};
+template <>
+struct DenseMatrix<float> {
+    using type = linalg::MatrixFloat;
+};
+template <typename Value>
+using dense_matrix_t = typename DenseMatrix<Value>::type;
 
 }  // namespace
 
@@ -279,11 +417,161 @@ int fourier_truncation(const int truncation,   // truncation
 }
 
 namespace detail {
-struct FFTW_Data {
 #if ATLAS_HAVE_FFTW
-    fftw_complex* in;
-    double* out;
+// Buffer size rounded up, so that the buffers of all threads keep the alignment of the buffer the plans were created with
+inline size_t fftw_aligned_size(size_t size) {
+    constexpr size_t alignment = 16;
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+// Latitudes of a reduced grid with the same number of longitudes, transformed together by one batched plan
+struct FFTW_LatitudeBatch {
+    int nlons;
+    std::vector<int> jlats;
+};
+
+// Maximum number of latitudes in one batch, so that there are enough batches to balance over threads
+constexpr size_t fftw_max_batch_size = 32;
+
+// Latitudes in [jlat_begin, jlat_end) grouped by their number of longitudes nlons(jlat), in batches of at most
+// fftw_max_batch_size latitudes
+template <typename NLons>
+std::vector<FFTW_LatitudeBatch> fftw_latitude_batches(int jlat_begin, int jlat_end, const NLons& nlons,
+                                                      size_t& max_batch_size) {
+    std::map<int, std::vector<int>> jlats_by_nlons;
+    for (int jlat = jlat_begin; jlat < jlat_end; jlat++) {
+        jlats_by_nlons[nlons(jlat)].emplace_back(jlat);
+    }
+    std::vector<FFTW_LatitudeBatch> batches;
+    max_batch_size = 0;
+    for (const auto& [n, jlats] : jlats_by_nlons) {
+        for (size_t jb = 0; jb < jlats.size(); jb += fftw_max_batch_size) {
+            size_t jb_end = std::min(jb + fftw_max_batch_size, jlats.size());
+            batches.push_back({n, std::vector<int>(jlats.begin() + jb, jlats.begin() + jb_end)});
+            max_batch_size = std::max(max_batch_size, jb_end - jb);
+        }
+    }
+    return batches;
+}
+
+template <typename Value>
+struct FFTW_Plans;
+
+template <>
+struct FFTW_Plans<double> {
+    static constexpr bool single_precision = false;
+    fftw_complex* in{nullptr};
+    double* out{nullptr};
+    size_t stride_complex{0};  // size of the input buffer of one thread
+    size_t stride_real{0};     // size of the output buffer of one thread
     std::vector<fftw_plan> plans;
+
+    void allocate(size_t nb_complex, size_t nb_real, size_t nb_threads = 1) {
+        stride_complex = fftw_aligned_size(nb_complex);
+        stride_real    = fftw_aligned_size(nb_real);
+        in             = fftw_alloc_complex(nb_threads * stride_complex);
+        out            = fftw_alloc_real(nb_threads * stride_real);
+    }
+    void export_wisdom(FILE* file) { fftw_export_wisdom_to_file(file); }
+    fftw_plan plan_many(int n, int howmany, int idist, int odist, unsigned flags) {
+        return fftw_plan_many_dft_c2r(1, &n, howmany, in, nullptr, 1, idist, out, nullptr, 1, odist, flags);
+    }
+    fftw_plan plan(int n, unsigned flags) { return fftw_plan_dft_c2r_1d(n, in, out, flags); }
+    void execute(size_t jplan, size_t thread = 0) {
+        fftw_execute_dft_c2r(plans[jplan], in + thread * stride_complex, out + thread * stride_real);
+    }
+    // Real-to-complex plans of the direct transform, from the real buffer to the complex buffer
+    fftw_plan plan_many_r2c(int n, int howmany, int idist, int odist, unsigned flags) {
+        return fftw_plan_many_dft_r2c(1, &n, howmany, out, nullptr, 1, idist, in, nullptr, 1, odist, flags);
+    }
+    void execute_r2c(size_t jplan, size_t thread = 0) {
+        fftw_execute_dft_r2c(plans[jplan], out + thread * stride_real, in + thread * stride_complex);
+    }
+
+    ~FFTW_Plans() {
+        for (auto& plan : plans) {
+            fftw_destroy_plan(plan);
+        }
+        fftw_free(in);
+        fftw_free(out);
+    }
+};
+
+#if ATLAS_HAVE_FFTW_SINGLE
+template <>
+struct FFTW_Plans<float> {
+    static constexpr bool single_precision = true;
+    fftwf_complex* in{nullptr};
+    float* out{nullptr};
+    size_t stride_complex{0};  // size of the input buffer of one thread
+    size_t stride_real{0};     // size of the output buffer of one thread
+    std::vector<fftwf_plan> plans;
+
+    void allocate(size_t nb_complex, size_t nb_real, size_t nb_threads = 1) {
+        stride_complex = fftw_aligned_size(nb_complex);
+        stride_real    = fftw_aligned_size(nb_real);
+        in             = fftwf_alloc_complex(nb_threads * stride_complex);
+        out            = fftwf_alloc_real(nb_threads * stride_real);
+    }
+    void export_wisdom(FILE* file) { fftwf_export_wisdom_to_file(file); }
+    fftwf_plan plan_many(int n, int howmany, int idist, int odist, unsigned flags) {
+        return fftwf_plan_many_dft_c2r(1, &n, howmany, in, nullptr, 1, idist, out, nullptr, 1, odist, flags);
+    }
+    fftwf_plan plan(int n, unsigned flags) { return fftwf_plan_dft_c2r_1d(n, in, out, flags); }
+    void execute(size_t jplan, size_t thread = 0) {
+        fftwf_execute_dft_c2r(plans[jplan], in + thread * stride_complex, out + thread * stride_real);
+    }
+
+    ~FFTW_Plans() {
+        for (auto& plan : plans) {
+            fftwf_destroy_plan(plan);
+        }
+        fftwf_free(in);
+        fftwf_free(out);
+    }
+};
+
+// Precision of the FFTs for a transform in given precision
+template <typename Value>
+using fftw_value_t = Value;
+#else
+// Without single precision FFTW library, FFTs of single precision transforms are computed in double precision
+template <typename Value>
+using fftw_value_t = double;
+#endif
+#endif
+
+struct FFTW_Data {
+#if ATLAS_HAVE_FFTW
+    // Reduced grids: one plan per batch of latitudes, executed by up to nb_threads threads
+    std::vector<FFTW_LatitudeBatch> batches;
+    int nb_threads{1};
+
+    // Only the plans in the precision of the transform are used
+    FFTW_Plans<double> double_precision;
+
+    // Direct transform: real-to-complex plans per batch of latitudes, created by the first direct transform with
+    // the planning effort of the inverse plans, and executed by up to direct_nb_threads threads
+    std::vector<FFTW_LatitudeBatch> direct_batches;
+    FFTW_Plans<double> direct;
+    int direct_nb_threads{1};
+    unsigned planning{FFTW_ESTIMATE};
+    std::once_flag direct_plans_created;
+#if ATLAS_HAVE_FFTW_SINGLE
+    FFTW_Plans<float> single_precision;
+#endif
+
+    template <typename Value>
+    FFTW_Plans<fftw_value_t<Value>>& plans() {
+        if constexpr (std::is_same_v<fftw_value_t<Value>, double>) {
+            return double_precision;
+        }
+#if ATLAS_HAVE_FFTW_SINGLE
+        else {
+            return single_precision;
+        }
+#endif
+    }
 #endif
 };
 }  // namespace detail
@@ -293,6 +581,33 @@ struct FFTW_Data {
 // Class TransLocal
 // --------------------------------------------------------------------------------------------------------------------
 
+template <>
+double* TransLocal::legendre_sym<double>() const {
+    return legendre_sym_;
+}
+template <>
+float* TransLocal::legendre_sym<float>() const {
+    return legendre_sym_f_;
+}
+template <>
+double* TransLocal::legendre_asym<double>() const {
+    return legendre_asym_;
+}
+template <>
+float* TransLocal::legendre_asym<float>() const {
+    return legendre_asym_f_;
+}
+template <>
+double* TransLocal::fourier<double>() const {
+    return fourier_;
+}
+template <>
+float* TransLocal::fourier<float>() const {
+    return fourier_f_;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
 bool TransLocal::warning(const eckit::Configuration& config) const {
     int warning = warning_;
     config.get("warning", warning);
@@ -300,8 +615,11 @@ bool TransLocal::warning(const eckit::Configuration& config) const {
 }
 
 TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domain, const long truncation,
-                       const eckit::Configuration& config):
+                       const std::vector<gidx_t>* gridpoints, const eckit::Configuration& config):
     grid_(grid, domain),
+    single_precision_(TransParameters{config}.single_precision()),
+    legendre_on_the_fly_(TransParameters{config}.legendre_on_the_fly() && not cache.legendre()),
+    legendre_block_size_(TransParameters{config}.legendre_block_size()),
     truncation_(static_cast<int>(truncation)),
     precompute_(config.getBool("precompute", true)),
     cache_(cache),
@@ -315,7 +633,11 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
     ATLAS_TRACE("TransLocal constructor");
 
     if (mpi::size() > 1) {
-        ATLAS_THROW_EXCEPTION("TransLocal is not implemented for more than 1 MPI task.");
+        if (not(StructuredGrid(grid_) && not grid_.projection() && grid_.domain().global())) {
+            ATLAS_THROW_EXCEPTION(
+                "TransLocal is only implemented for global structured grids with more than 1 MPI task.");
+        }
+        partitioner_ = config.getString("partitioner", "equal_regions");
     }
 
     double fft_threshold = 0.0;  // fraction of latitudes of the full grid down to which FFT is used.
@@ -340,6 +662,16 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
         nlats    = g.ny();
         nlonsMax = g.nxmax();
 
+        jlatBegin_ = 0;
+        jlatEnd_   = nlats;
+        if (mpi::size() > 1) {
+            distribution_.reset(new detail::TransLocalDistribution(g, truncation_));
+            jlatBegin_ = distribution_->jlat_begin();
+            jlatEnd_   = distribution_->jlat_end();
+            Log::debug() << "TransLocal distributed over " << distribution_->nb_parts() << " MPI tasks" << std::endl;
+        }
+        setup_gridpoints(gridpoints);
+
         // check location of domain relative to the equator:
         for (idx_t j = 0; j < nlats; ++j) {
             // assumptions: latitudes in g.y(j) are monotone and decreasing
@@ -551,7 +883,8 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
         else {
             Log::debug() << detect_linalg_backend(linalg_backend_) << '\n';
         }
-        Log::debug() << " - legendre_cache: " << std::boolalpha << bool(legendre_cache_) << std::endl;
+        Log::debug() << " - legendre_cache: " << std::boolalpha << bool(legendre_cache_) << '\n';
+        Log::debug() << " - legendre_on_the_fly: " << std::boolalpha << legendre_on_the_fly_ << std::endl;
 
 
         // precomputations for Legendre polynomials:
@@ -570,88 +903,121 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
                 legendre_asym_begin_[jm + 1] = size_asym;
             }
 
-            if (legendre_cache_) {
-                ReadCache legendre(legendre_cache_);
-                legendre_sym_  = legendre.read<double>(size_sym);
-                legendre_asym_ = legendre.read<double>(size_asym);
-                ATLAS_ASSERT(legendre.pos == legendre_cachesize_);
-                // TODO: check this is all aligned...
-            }
-            else {
-                if (TransParameters(config).export_legendre()) {
-                    ATLAS_ASSERT(not cache_.legendre());
-
-                    size_t bytes = sizeof(double) * (size_sym + size_asym);
-                    Log::debug() << "TransLocal: allocating LegendreCache: " << eckit::Bytes(bytes) << std::endl;
-                    export_legendre_ = LegendreCache(bytes);
-
-                    legendre_cachesize_ = export_legendre_.legendre().size();
-                    legendre_cache_     = export_legendre_.legendre().data();
+            // The Legendre coefficients, and hence the cache, are stored in the precision of the transform
+            auto precompute_legendre = [&](auto*& legendre_sym, auto*& legendre_asym) {
+                using Value            = std::remove_reference_t<decltype(*legendre_sym)>;
+                const size_t data_size = sizeof(Value) * (size_sym + size_asym);
+                if (legendre_cache_) {
                     ReadCache legendre(legendre_cache_);
-                    legendre_sym_  = legendre.read<double>(size_sym);
-                    legendre_asym_ = legendre.read<double>(size_asym);
+                    legendre.pos  = validate_legendre_cache(legendre_cache_, legendre_cachesize_, truncation_, lats,
+                                                            sizeof(Value), data_size);
+                    legendre_sym  = legendre.read<Value>(size_sym);
+                    legendre_asym = legendre.read<Value>(size_asym);
+                    ATLAS_ASSERT(legendre.pos == legendre_cachesize_,
+                                 "Legendre cache does not match the grid, truncation or precision");
+                    // TODO: check this is all aligned...
                 }
                 else {
-                    alloc_aligned(legendre_sym_, size_sym, "Legendre coeffs symmetric");
-                    alloc_aligned(legendre_asym_, size_asym, "Legendre coeffs asymmetric");
-                }
+                    if (TransParameters(config).export_legendre()) {
+                        ATLAS_ASSERT(not cache_.legendre());
+
+                        size_t bytes = legendre_cache_data_offset + data_size;
+                        Log::debug() << "TransLocal: allocating LegendreCache: " << eckit::Bytes(bytes) << std::endl;
+                        export_legendre_ = LegendreCache(bytes);
+
+                        legendre_cachesize_ = export_legendre_.legendre().size();
+                        legendre_cache_     = export_legendre_.legendre().data();
+
+                        auto header = legendre_cache_header(truncation_, lats, sizeof(Value), data_size);
+                        std::memcpy(const_cast<void*>(legendre_cache_), header.data(), header.size());
+                        ReadCache legendre(legendre_cache_);
+                        legendre.pos  = header.size();
+                        legendre_sym  = legendre.read<Value>(size_sym);
+                        legendre_asym = legendre.read<Value>(size_asym);
+                    }
+                    else {
+                        alloc_aligned(legendre_sym, size_sym, "Legendre coeffs symmetric");
+                        alloc_aligned(legendre_asym, size_asym, "Legendre coeffs asymmetric");
+                    }
 
-                ATLAS_TRACE_SCOPE("Legendre precomputations (structured)") {
-                    compute_legendre_polynomials(truncation_ + 1, nlatsLeg_, lats.data(), legendre_sym_, legendre_asym_,
-                                                 legendre_sym_begin_.data(), legendre_asym_begin_.data());
-                }
-                std::string file_path = TransParameters(config).write_legendre();
-                if (file_path.size()) {
-                    ATLAS_TRACE("Write LegendreCache to file");
-                    Log::debug() << "Writing Legendre cache file ..." << std::endl;
-                    Log::debug() << "    path: " << file_path << std::endl;
-                    WriteCache legendre(file_path);
-                    legendre.write(legendre_sym_, size_sym);
-                    legendre.write(legendre_asym_, size_asym);
-                    Log::debug() << "    size: " << eckit::Bytes(legendre.pos) << std::endl;
+                    ATLAS_TRACE_SCOPE("Legendre precomputations (structured)") {
+                        compute_legendre_polynomials(truncation_ + 1, nlatsLeg_, lats.data(), legendre_sym,
+                                                     legendre_asym, legendre_sym_begin_.data(),
+                                                     legendre_asym_begin_.data());
+                    }
+                    std::string file_path = TransParameters(config).write_legendre();
+                    if (file_path.size()) {
+                        ATLAS_TRACE("Write LegendreCache to file");
+                        Log::debug() << "Writing Legendre cache file ..." << std::endl;
+                        Log::debug() << "    path: " << file_path << std::endl;
+                        WriteCache legendre(file_path);
+                        auto header = legendre_cache_header(truncation_, lats, sizeof(Value), data_size);
+                        legendre.write(header.data(), header.size());
+                        legendre.write(legendre_sym, size_sym);
+                        legendre.write(legendre_asym, size_asym);
+                        Log::debug() << "    size: " << eckit::Bytes(legendre.pos) << std::endl;
+                    }
                 }
+            };
+            if (legendre_on_the_fly_) {
+                // Only what is needed to compute the polynomials of any latitude in invtrans_legendre
+                ATLAS_ASSERT(legendre_block_size_ > 0);
+                ATLAS_ASSERT(not TransParameters(config).export_legendre() &&
+                                 TransParameters(config).write_legendre().empty(),
+                             "Legendre polynomials computed on the fly cannot be exported or written to file");
+                legendre_lats_ = lats;
+                legendre_zfn_.resize(size_t(truncation_ + 2) * size_t(truncation_ + 2));
+                compute_zfn(truncation_ + 1, legendre_zfn_.data());
+            }
+            else if (single_precision_) {
+                precompute_legendre(legendre_sym_f_, legendre_asym_f_);
+            }
+            else {
+                precompute_legendre(legendre_sym_, legendre_asym_);
             }
         }
 
         // precomputations for Fourier transformations:
         if (useFFT_) {
 #if ATLAS_HAVE_FFTW && !TRANSLOCAL_DGEMM2
-            {
+            auto precompute_fftw = [&](auto& fftw) {
                 ATLAS_TRACE("Fourier precomputations (FFTW)");
                 int num_complex = (nlonsMaxGlobal_ / 2) + 1;
-                fftw_->in       = fftw_alloc_complex(nlats * num_complex);
-                fftw_->out      = fftw_alloc_real(nlats * nlonsMaxGlobal_);
 
+                // Plans are created with the process-wide wisdom, which is loaded from file on first use
+                auto& wisdom = FFTWWisdom::instance();
                 if (fft_cache_) {
                     Log::debug() << "Import FFTW wisdom from cache" << std::endl;
-                    fftw_import_wisdom_from_string(static_cast<const char*>(fft_cache_));
+                    wisdom.import(cache_.fft(), fftw.single_precision);
                 }
-                //                std::string wisdomString( "" );
-                //                std::ifstream read( "wisdom.bin" );
-                //                if ( read.is_open() ) {
-                //                    std::getline( read, wisdomString );
-                //                    while ( read ) {
-                //                        std::string line;
-                //                        std::getline( read, line );
-                //                        wisdomString += line;
-                //                    }
-                //                }
-                //                read.close();
-                //                if ( wisdomString.length() > 0 ) { fftw_import_wisdom_from_string( &wisdomString[0u] ); }
+                const unsigned planning = TransParameters(config).fftw_planning();
+                auto lock               = wisdom.lock();
                 if (RegularGrid(gridGlobal_)) {
-                    fftw_->plans.resize(1);
-                    fftw_->plans[0] =
-                        fftw_plan_many_dft_c2r(1, &nlonsMaxGlobal_, nlats, fftw_->in, nullptr, 1, num_complex,
-                                               fftw_->out, nullptr, 1, nlonsMaxGlobal_, FFTW_ESTIMATE);
+                    fftw.allocate(nlats * num_complex, nlats * nlonsMaxGlobal_);
+                    fftw.plans.resize(1);
+                    fftw.plans[0] =
+                        fftw.plan_many(nlonsMaxGlobal_, jlatEnd_ - jlatBegin_, num_complex, nlonsMaxGlobal_, planning);
                 }
                 else {
-                    fftw_->plans.resize(nlatsLegDomain_);
-                    for (int j = 0; j < nlatsLegDomain_; j++) {
-                        int nlonsGlobalj = gs_global.nx(jlatMinLeg_ + j);
-                        //ASSERT( nlonsGlobalj > 0 && nlonsGlobalj <= nlonsMaxGlobal_ );
-                        fftw_->plans[j] = fftw_plan_dft_c2r_1d(nlonsGlobalj, fftw_->in, fftw_->out, FFTW_ESTIMATE);
+                    // Group latitudes by number of longitudes, so that each group is transformed with a batched
+                    // plan. Batches are executed in parallel, each thread with its own buffers.
+                    size_t max_batch_size = 0;
+                    auto& batches         = fftw_->batches;
+                    batches               = detail::fftw_latitude_batches(
+                        jlatBegin_, jlatEnd_, [&](int jlat) { return nlonsGlobal_[jlat]; }, max_batch_size);
+                    fftw_->nb_threads = atlas_omp_get_max_threads();
+                    fftw.allocate(max_batch_size * num_complex, max_batch_size * nlonsMaxGlobal_, fftw_->nb_threads);
+                    fftw.plans.resize(batches.size());
+                    for (size_t jbatch = 0; jbatch < batches.size(); ++jbatch) {
+                        const int nlons = batches[jbatch].nlons;
+                        fftw.plans[jbatch] =
+                            fftw.plan_many(nlons, batches[jbatch].jlats.size(), nlons / 2 + 1, nlons, planning);
                     }
                 }
+                if (planning != FFTW_ESTIMATE) {
+                    wisdom.planned();
+                }
+                fftw_->planning       = planning;
                 std::string file_path = TransParameters(config).write_fft();
                 if (file_path.size()) {
                     Log::debug() << "Write FFTW wisdom to file " << file_path << std::endl;
@@ -661,7 +1027,7 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
                     //write << FFTW_Wisdom();
 
                     FILE* file_fftw = fopen(file_path.c_str(), "wb");
-                    fftw_export_wisdom_to_file(file_fftw);
+                    fftw.export_wisdom(file_fftw);
                     fclose(file_fftw);
                 }
                 //                std::string newWisdom( fftw_export_wisdom_to_string() );
@@ -670,6 +1036,12 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
                 //                    write << newWisdom;
                 //                    write.close();
                 //                }
+            };
+            if (single_precision_) {
+                precompute_fftw(fftw_->plans<float>());
+            }
+            else {
+                precompute_fftw(fftw_->plans<double>());
             }
             // other FFT implementations should be added with #elif statements
 #else
@@ -688,44 +1060,56 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
                 << "WARNING: Spectral transform results may contain aliasing errors. This will be addressed soon."
                 << std::endl;
 
-            alloc_aligned(fourier_, 2 * (truncation_ + 1) * nlonsMax, "Fourier coeffs");
+            auto precompute_fourier = [&](auto*& fourier) {
+                alloc_aligned(fourier, 2 * (truncation_ + 1) * nlonsMax, "Fourier coeffs");
 #if !TRANSLOCAL_DGEMM2
-            {
-                ATLAS_TRACE("Fourier precomputations (NoFFT)");
-                int idx = 0;
-                for (int jm = 0; jm < truncation_ + 1; jm++) {
-                    double factor = 1.;
-                    if (jm > 0) {
-                        factor = 2.;
-                    }
-                    for (int jlon = 0; jlon < nlonsMax; jlon++) {
-                        fourier_[idx++] = +std::cos(jm * lons[jlon]) * factor;  // real part
-                    }
-                    for (int jlon = 0; jlon < nlonsMax; jlon++) {
-                        fourier_[idx++] = -std::sin(jm * lons[jlon]) * factor;  // imaginary part
-                    }
-                }
-            }
-#else
-            {
-                ATLAS_TRACE("precomp Fourier");
-                int idx = 0;
-                for (int jlon = 0; jlon < nlonsMax; jlon++) {
-                    double factor = 1.;
+                {
+                    ATLAS_TRACE("Fourier precomputations (NoFFT)");
+                    int idx = 0;
                     for (int jm = 0; jm < truncation_ + 1; jm++) {
+                        double factor = 1.;
                         if (jm > 0) {
                             factor = 2.;
                         }
-                        fourier_[idx++] = +std::cos(jm * lons[jlon]) * factor;  // real part
-                        fourier_[idx++] = -std::sin(jm * lons[jlon]) * factor;  // imaginary part
+                        for (int jlon = 0; jlon < nlonsMax; jlon++) {
+                            fourier[idx++] = +std::cos(jm * lons[jlon]) * factor;  // real part
+                        }
+                        for (int jlon = 0; jlon < nlonsMax; jlon++) {
+                            fourier[idx++] = -std::sin(jm * lons[jlon]) * factor;  // imaginary part
+                        }
+                    }
+                }
+#else
+                {
+                    ATLAS_TRACE("precomp Fourier");
+                    int idx = 0;
+                    for (int jlon = 0; jlon < nlonsMax; jlon++) {
+                        double factor = 1.;
+                        for (int jm = 0; jm < truncation_ + 1; jm++) {
+                            if (jm > 0) {
+                                factor = 2.;
+                            }
+                            fourier[idx++] = +std::cos(jm * lons[jlon]) * factor;  // real part
+                            fourier[idx++] = -std::sin(jm * lons[jlon]) * factor;  // imaginary part
+                        }
                     }
                 }
-            }
 #endif
+            };
+            if (single_precision_) {
+                precompute_fourier(fourier_f_);
+            }
+            else {
+                precompute_fourier(fourier_);
+            }
         }
     }
     else {
         // unstructured grid
+        if (single_precision_) {
+            throw_NotImplemented(
+                "Single precision TransLocal is only implemented for structured grids without projection", Here());
+        }
         if (unstruct_precomp_) {
             ATLAS_TRACE("Legendre precomputations (unstructured)");
 
@@ -758,6 +1142,14 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domai
 
 // --------------------------------------------------------------------------------------------------------------------
 
+TransLocal::TransLocal(const Cache& cache, const Grid& grid, const Domain& domain, const long truncation,
+                       const eckit::Configuration& config):
+    TransLocal(cache, grid, domain, truncation, nullptr, config) {}
+
+TransLocal::TransLocal(const Cache& cache, const Grid& grid, const long truncation,
+                       const std::vector<gidx_t>& gridpoints, const eckit::Configuration& config):
+    TransLocal(cache, grid, grid.domain(), truncation, &gridpoints, config) {}
+
 TransLocal::TransLocal(const Grid& grid, const long truncation, const eckit::Configuration& config):
     TransLocal(Cache(), grid, grid.domain(), truncation, config) {}
 
@@ -772,21 +1164,24 @@ TransLocal::TransLocal(const Cache& cache, const Grid& grid, const long truncati
 
 TransLocal::~TransLocal() {
     if (StructuredGrid(grid_) && not grid_.projection()) {
-        if (not legendre_cache_) {
-            free_aligned(legendre_sym_, "symmetric");
-            free_aligned(legendre_asym_, "asymmetric");
-        }
-        if (useFFT_) {
-#if ATLAS_HAVE_FFTW && !TRANSLOCAL_DGEMM2
-            for (idx_t j = 0, size = static_cast<idx_t>(fftw_->plans.size()); j < size; j++) {
-                fftw_destroy_plan(fftw_->plans[j]);
+        if (not legendre_cache_ && not legendre_on_the_fly_) {
+            if (single_precision_) {
+                free_aligned(legendre_sym_f_, "symmetric");
+                free_aligned(legendre_asym_f_, "asymmetric");
+            }
+            else {
+                free_aligned(legendre_sym_, "symmetric");
+                free_aligned(legendre_asym_, "asymmetric");
             }
-            fftw_free(fftw_->in);
-            fftw_free(fftw_->out);
-#endif
         }
-        else {
-            free_aligned(fourier_, "Fourier coeffs.");
+        // FFTW plans and buffers are released by detail::FFTW_Data
+        if (not useFFT_) {
+            if (single_precision_) {
+                free_aligned(fourier_f_, "Fourier coeffs.");
+            }
+            else {
+                free_aligned(fourier_, "Fourier coeffs.");
+            }
         }
     }
     else {
@@ -798,6 +1193,39 @@ TransLocal::~TransLocal() {
 
 // --------------------------------------------------------------------------------------------------------------------
 
+void TransLocal::setup_gridpoints(const std::vector<gidx_t>* gridpoints) {
+    if (not distribution_) {
+        ATLAS_ASSERT(gridpoints == nullptr || gridpoints->size() == size_t(grid_.size()),
+                     "All grid points are required without MPI distribution");
+        return;
+    }
+    if (gridpoints) {
+        distribution_->setup_gridpoints(*gridpoints);
+        return;
+    }
+    // Grid points were not given with a function space: distribute them with the configured partitioner
+    grid::Distribution gp_distribution(grid_, util::Config("type", partitioner_));
+    const int part = distribution_->part();
+    std::vector<gidx_t> points;
+    for (gidx_t n = 0, size = grid_.size(); n < size; ++n) {
+        if (gp_distribution.partition(n) == part) {
+            points.emplace_back(n);
+        }
+    }
+    distribution_->setup_gridpoints(points);
+}
+
+const detail::TransLocalDistribution& TransLocal::distribution() const {
+    ATLAS_ASSERT(distribution_);
+    return *distribution_;
+}
+
+idx_t TransLocal::nb_gridpoints() const {
+    return distribution_ ? distribution().nb_gridpoints() : grid_.size();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
 const functionspace::Spectral& TransLocal::spectral() const {
     if (not spectral_) {
         spectral_ = functionspace::Spectral(Trans(this));
@@ -815,11 +1243,11 @@ void TransLocal::invtrans(const Field& spfield, Field& gpfield, const eckit::Con
     const auto scalar_spectra = array::make_view<double, 1>(spfield);
     auto gp_fields            = array::make_view<double, 1>(gpfield);
 
-    if (gp_fields.shape(0) < grid().size()) {
+    if (gp_fields.shape(0) < nb_gridpoints()) {
         // Hopefully the halo (if present) is appended
         ATLAS_DEBUG_VAR(gp_fields.shape(0));
-        ATLAS_DEBUG_VAR(grid().size());
-        ATLAS_ASSERT(gp_fields.shape(0) < grid().size());
+        ATLAS_DEBUG_VAR(nb_gridpoints());
+        ATLAS_ASSERT(gp_fields.shape(0) < nb_gridpoints());
     }
 
     invtrans(nb_scalar_fields, scalar_spectra.data(), gp_fields.data(), config);
@@ -837,24 +1265,56 @@ void TransLocal::invtrans(const FieldSet& spfields, FieldSet& gpfields, const ec
 
 // --------------------------------------------------------------------------------------------------------------------
 
-void TransLocal::invtrans_grad(const Field& /*spfield*/, Field& /*gradfield*/, const eckit::Configuration&) const {
-    ATLAS_NOTIMPLEMENTED;
+void gp_transpose(const int nb_size, const int nb_fields, const double gp_tmp[], double gp_fields[]) {
+    for (int jgp = 0; jgp < nb_size; jgp++) {
+        for (int jfld = 0; jfld < nb_fields; jfld++) {
+            gp_fields[jfld * nb_size + jgp] = gp_tmp[jgp * nb_fields + jfld];
+        }
+    }
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
-void TransLocal::invtrans_grad(const FieldSet& /*spfields*/, FieldSet& /*gradfields*/,
-                               const eckit::Configuration&) const {
-    ATLAS_NOTIMPLEMENTED;
+void TransLocal::invtrans_grad(const Field& spfield, Field& gradfield, const eckit::Configuration& config) const {
+    // The gradient of a scalar s is the wind of zero vorticity and divergence D = laplacian(s),
+    // with laplacian(s)_n = -n(n+1)/a^2 s_n. The wind components are the eastward and northward derivatives.
+    ATLAS_ASSERT(spfield.rank() == 1, "Only rank-1 fields supported at the moment");
+    const auto scalar_spectra = array::make_view<double, 1>(spfield);
+    auto gp_fields            = array::make_view<double, 2>(gradfield);
+
+    const double ra2 = 1. / (util::Earth::radius() * util::Earth::radius());
+    std::vector<double> vorticity_spectra(scalar_spectra.size(), 0.);
+    std::vector<double> divergence_spectra(scalar_spectra.size());
+    ATLAS_ASSERT(divergence_spectra.size() == 2 * legendre_size(truncation_));
+    for (int jm = 0, idx = 0; jm <= truncation_; jm++) {
+        for (int jn = jm; jn <= truncation_; jn++) {
+            for (int imag = 0; imag < 2; imag++, idx++) {
+                divergence_spectra[idx] = -jn * (jn + 1.) * ra2 * scalar_spectra(idx);
+            }
+        }
+    }
+
+    const idx_t nb_gp = nb_gridpoints();
+    if (gp_fields.shape(1) == nb_gp && gp_fields.shape(0) == 2) {
+        invtrans(1, vorticity_spectra.data(), divergence_spectra.data(), gp_fields.data(), config);
+    }
+    else if (gp_fields.shape(0) == nb_gp && gp_fields.shape(1) == 2) {
+        std::vector<double> gp_tmp(2 * nb_gp);
+        invtrans(1, vorticity_spectra.data(), divergence_spectra.data(), gp_tmp.data(), config);
+        gp_transpose(2, nb_gp, gp_tmp.data(), gp_fields.data());
+    }
+    else {
+        ATLAS_NOTIMPLEMENTED;
+    }
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
-void gp_transpose(const int nb_size, const int nb_fields, const double gp_tmp[], double gp_fields[]) {
-    for (int jgp = 0; jgp < nb_size; jgp++) {
-        for (int jfld = 0; jfld < nb_fields; jfld++) {
-            gp_fields[jfld * nb_size + jgp] = gp_tmp[jgp * nb_fields + jfld];
-        }
+void TransLocal::invtrans_grad(const FieldSet& spfields, FieldSet& gradfields,
+                               const eckit::Configuration& config) const {
+    ATLAS_ASSERT(spfields.size() == gradfields.size());
+    for (idx_t f = 0; f < spfields.size(); ++f) {
+        invtrans_grad(spfields[f], gradfields[f], config);
     }
 }
 
@@ -870,14 +1330,15 @@ void TransLocal::invtrans_vordiv2wind(const Field& spvor, const Field& spdiv, Fi
     const auto divergence_spectra = array::make_view<double, 1>(spdiv);
     auto gp_fields                = array::make_view<double, 2>(gpwind);
 
-    if (gp_fields.shape(1) == grid().size() && gp_fields.shape(0) == 2) {
+    const idx_t nb_gp = nb_gridpoints();
+    if (gp_fields.shape(1) == nb_gp && gp_fields.shape(0) == 2) {
         invtrans(nb_vordiv_fields, vorticity_spectra.data(), divergence_spectra.data(), gp_fields.data(), config);
     }
-    else if (gp_fields.shape(0) == grid().size() && gp_fields.shape(1) == 2) {
+    else if (gp_fields.shape(0) == nb_gp && gp_fields.shape(1) == 2) {
         array::ArrayT<double> gpwind_t(gp_fields.shape(1), gp_fields.shape(0));
         auto gp_fields_t = array::make_view<double, 2>(gpwind_t);
         invtrans(nb_vordiv_fields, vorticity_spectra.data(), divergence_spectra.data(), gp_fields_t.data(), config);
-        gp_transpose(grid().size(), 2, gp_fields_t.data(), gp_fields.data());
+        gp_transpose(nb_gp, 2, gp_fields_t.data(), gp_fields.data());
     }
     else {
         ATLAS_NOTIMPLEMENTED;
@@ -924,161 +1385,292 @@ void TransLocal::invtrans(const int nb_scalar_fields, const double scalar_spectr
 
 // --------------------------------------------------------------------------------------------------------------------
 
+template <typename Value>
 void TransLocal::invtrans_legendre(const int truncation, const int nlats, const int nb_fields,
-                                   const int /*nb_vordiv_fields*/, const double scalar_spectra[], double scl_fourier[],
+                                   const int /*nb_vordiv_fields*/, const double scalar_spectra[], Value scl_fourier[],
                                    const eckit::Configuration&) const {
+    using Matrix = dense_matrix_t<Value>;
     // Legendre transform:
     {
         Log::debug() << "TransLocal::invtrans_legendre: Legendre GEMM with \"" << detect_linalg_backend(linalg_backend_)
                      << "\" using " << nlatsLegReduced_ - nlat0_[0] << " latitudes out of " << nlatsGlobal_ / 2
-                     << std::endl;
+                     << (legendre_on_the_fly_ ? " (Legendre polynomials computed on the fly)" : "") << std::endl;
         linalg::dense::Backend linalg_backend{linalg_backend_};
         ATLAS_TRACE("Inverse Legendre Transform (GEMM)");
-        for (int jm = 0; jm <= truncation_; jm++) {
-            size_t size_sym  = num_n(truncation_ + 1, jm, true);
-            size_t size_asym = num_n(truncation_ + 1, jm, false);
+
+        auto owns_zonal_wavenumber = [&](int jm) {
+            return not distribution_ || distribution_->owns_zonal_wavenumber(jm);
+        };
+
+        // split the spectral coefficients of zonal wavenumber jm into the parts multiplied by symmetric and by
+        // antisymmetric polynomials
+        auto split = [&](int jm, Value scalar_sym[], Value scalar_asym[]) {
+            const size_t size_sym  = num_n(truncation_ + 1, jm, true);
+            const size_t size_asym = num_n(truncation_ + 1, jm, false);
+            const int n_imag       = (jm ? 2 : 1);
+            idx_t idx = 0, is = 0, ia = 0, ioff = (2 * truncation + 3 - jm) * jm / 2 * nb_fields * 2;
+            // the choice between the following two code lines determines whether
+            // total wavenumbers are summed in an ascending or descending order.
+            // The trans library in IFS uses descending order because it should
+            // be more accurate (higher wavenumbers have smaller contributions).
+            // This also needs to be changed when splitting the spectral data in
+            // compute_legendre_polynomials!
+            //for ( int jn = jm; jn <= truncation_ + 1; jn++ ) {
+            for (int jn = truncation_ + 1; jn >= jm; jn--) {
+                for (int imag = 0; imag < n_imag; imag++) {
+                    for (int jfld = 0; jfld < nb_fields; jfld++) {
+                        idx = jfld + nb_fields * (imag + 2 * (jn - jm));
+                        if (jn <= truncation && jm < truncation) {
+                            if ((jn - jm) % 2 == 0) {
+                                scalar_sym[is++] = static_cast<Value>(scalar_spectra[idx + ioff]);
+                            }
+                            else {
+                                scalar_asym[ia++] = static_cast<Value>(scalar_spectra[idx + ioff]);
+                            }
+                        }
+                        else {
+                            if ((jn - jm) % 2 == 0) {
+                                scalar_sym[is++] = 0.;
+                            }
+                            else {
+                                scalar_asym[ia++] = 0.;
+                            }
+                        }
+                    }
+                }
+            }
+            ATLAS_ASSERT(size_t(ia) == n_imag * nb_fields * size_asym && size_t(is) == n_imag * nb_fields * size_sym);
+        };
+
+        // merge the symmetric and antisymmetric parts into the Fourier coefficients of both hemispheres
+        auto merge = [&](int jm, const Value scl_fourier_sym[], const Value scl_fourier_asym[]) {
             const int n_imag = (jm ? 2 : 1);
-            int size_fourier = nb_fields * n_imag * (nlatsLegReduced_ - nlat0_[jm]);
-            if (size_fourier > 0) {
-                auto posFourier = [&](int jfld, int imag, int jlat, int jm, int nlatsH) {
-                    return jfld + nb_fields * (imag + n_imag * (nlatsLegReduced_ - nlat0_[jm] - nlatsH + jlat));
-                };
-                // THESE ARE REALLOCATED FOR EACH jm ???
-                // THEY COULD ALLOCATED ONCE BEFORE jm LOOP WITH A MAXIMUM SIZE?
-                double* scalar_sym;
-                double* scalar_asym;
-                double* scl_fourier_sym;
-                double* scl_fourier_asym;
-                alloc_aligned(scalar_sym, n_imag * nb_fields * size_sym);
-                alloc_aligned(scalar_asym, n_imag * nb_fields * size_asym);
-                alloc_aligned(scl_fourier_sym, size_fourier);
-                alloc_aligned(scl_fourier_asym, size_fourier);
+            auto posFourier  = [&](int jfld, int imag, int jlat, int nlatsH) {
+                return jfld + nb_fields * (imag + n_imag * (nlatsLegReduced_ - nlat0_[jm] - nlatsH + jlat));
+            };
+            // northern hemisphere:
+            for (int jlat = 0; jlat < nlatsNH_; jlat++) {
+                if (nlatsLegReduced_ - nlat0_[jm] - nlatsNH_ + jlat >= 0) {
+                    for (int imag = 0; imag < n_imag; imag++) {
+                        for (int jfld = 0; jfld < nb_fields; jfld++) {
+                            int idx = posFourier(jfld, imag, jlat, nlatsNH_);
+                            scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)] =
+                                scl_fourier_sym[idx] + scl_fourier_asym[idx];
+                        }
+                    }
+                }
+                else {
+                    for (int imag = 0; imag < n_imag; imag++) {
+                        for (int jfld = 0; jfld < nb_fields; jfld++) {
+                            scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)] = 0.;
+                        }
+                    }
+                }
+            }
+            // southern hemisphere:
+            for (int jlat = 0; jlat < nlatsSH_; jlat++) {
+                int jslat = nlats - jlat - 1;
+                if (nlatsLegReduced_ - nlat0_[jm] - nlatsSH_ + jlat >= 0) {
+                    for (int imag = 0; imag < n_imag; imag++) {
+                        for (int jfld = 0; jfld < nb_fields; jfld++) {
+                            int idx = posFourier(jfld, imag, jlat, nlatsSH_);
+                            scl_fourier[posMethod(jfld, imag, jslat, jm, nb_fields, nlats)] =
+                                scl_fourier_sym[idx] - scl_fourier_asym[idx];
+                        }
+                    }
+                }
+                else {
+                    for (int imag = 0; imag < n_imag; imag++) {
+                        for (int jfld = 0; jfld < nb_fields; jfld++) {
+                            scl_fourier[posMethod(jfld, imag, jslat, jm, nb_fields, nlats)] = 0.;
+                        }
+                    }
+                }
+            }
+        };
+
+        auto zero = [&](int jm) {
+            const int n_imag = (jm ? 2 : 1);
+            for (int jlat = 0; jlat < nlats; jlat++) {
+                for (int imag = 0; imag < n_imag; imag++) {
+                    for (int jfld = 0; jfld < nb_fields; jfld++) {
+                        scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)] = 0.;
+                    }
+                }
+            }
+        };
+
+        if (legendre_on_the_fly_) {
+            // The polynomials are computed for one block of latitudes at a time, for all zonal wavenumbers, in the
+            // layout of the precomputed polynomials. The matrix multiplications then fill the block's columns of the
+            // Fourier coefficients of all zonal wavenumbers.
+            const int trc = truncation_ + 1;
+            std::vector<char> active(truncation_ + 1);
+            std::vector<size_t> scalar_sym_begin(truncation_ + 2, 0);
+            std::vector<size_t> scalar_asym_begin(truncation_ + 2, 0);
+            std::vector<size_t> fourier_begin(truncation_ + 2, 0);
+            std::vector<size_t> block_sym_begin(truncation_ + 2, 0);
+            std::vector<size_t> block_asym_begin(truncation_ + 2, 0);
+            for (int jm = 0; jm <= truncation_; jm++) {
+                const size_t n_imag    = (jm ? 2 : 1);
+                const size_t size_sym  = num_n(trc, jm, true);
+                const size_t size_asym = num_n(trc, jm, false);
+                active[jm]             = owns_zonal_wavenumber(jm) && nb_fields > 0 && nlatsLegReduced_ > nlat0_[jm];
+                if (active[jm]) {
+                    scalar_sym_begin[jm + 1]  = scalar_sym_begin[jm] + n_imag * nb_fields * size_sym;
+                    scalar_asym_begin[jm + 1] = scalar_asym_begin[jm] + n_imag * nb_fields * size_asym;
+                    fourier_begin[jm + 1]     = fourier_begin[jm] + n_imag * nb_fields * (nlatsLegReduced_ - nlat0_[jm]);
+                }
+                else {
+                    scalar_sym_begin[jm + 1]  = scalar_sym_begin[jm];
+                    scalar_asym_begin[jm + 1] = scalar_asym_begin[jm];
+                    fourier_begin[jm + 1]     = fourier_begin[jm];
+                }
+                block_sym_begin[jm + 1]  = block_sym_begin[jm] + size_sym * legendre_block_size_;
+                block_asym_begin[jm + 1] = block_asym_begin[jm] + size_asym * legendre_block_size_;
+            }
+
+            Value* scalar_sym;
+            Value* scalar_asym;
+            Value* scl_fourier_sym;
+            Value* scl_fourier_asym;
+            Value* block_sym;
+            Value* block_asym;
+            alloc_aligned(scalar_sym, scalar_sym_begin.back());
+            alloc_aligned(scalar_asym, scalar_asym_begin.back());
+            alloc_aligned(scl_fourier_sym, fourier_begin.back());
+            alloc_aligned(scl_fourier_asym, fourier_begin.back());
+            alloc_aligned(block_sym, block_sym_begin.back());
+            alloc_aligned(block_asym, block_asym_begin.back());
+
+            for (int jm = 0; jm <= truncation_; jm++) {
+                if (active[jm]) {
+                    split(jm, scalar_sym + scalar_sym_begin[jm], scalar_asym + scalar_asym_begin[jm]);
+                }
+            }
+
+            const int jlat_min = *std::min_element(nlat0_.begin(), nlat0_.end());
+            for (int jblock = jlat_min; jblock < nlatsLegReduced_; jblock += legendre_block_size_) {
+                const int jblock_end = std::min(jblock + legendre_block_size_, int(nlatsLegReduced_));
                 {
-                    //ATLAS_TRACE( "Legendre split" );
-                    idx_t idx = 0, is = 0, ia = 0, ioff = (2 * truncation + 3 - jm) * jm / 2 * nb_fields * 2;
-                    // the choice between the following two code lines determines whether
-                    // total wavenumbers are summed in an ascending or descending order.
-                    // The trans library in IFS uses descending order because it should
-                    // be more accurate (higher wavenumbers have smaller contributions).
-                    // This also needs to be changed when splitting the spectral data in
-                    // compute_legendre_polynomials!
-                    //for ( int jn = jm; jn <= truncation_ + 1; jn++ ) {
-                    for (int jn = truncation_ + 1; jn >= jm; jn--) {
-                        for (int imag = 0; imag < n_imag; imag++) {
-                            for (int jfld = 0; jfld < nb_fields; jfld++) {
-                                idx = jfld + nb_fields * (imag + 2 * (jn - jm));
-                                if (jn <= truncation && jm < truncation) {
-                                    if ((jn - jm) % 2 == 0) {
-                                        scalar_sym[is++] = scalar_spectra[idx + ioff];
-                                    }
-                                    else {
-                                        scalar_asym[ia++] = scalar_spectra[idx + ioff];
-                                    }
-                                }
-                                else {
+                    ATLAS_TRACE("Legendre polynomials");
+                    atlas_omp_parallel {
+                        const size_t legendre_size = size_t(trc + 2) * (trc + 1) / 2;
+                        std::vector<double> legpol(legendre_size);
+                        atlas_omp_for(int jlat = jblock; jlat < jblock_end; jlat++) {
+                            compute_legendre_polynomials_lat(trc, legendre_lats_[jlat], legpol.data(),
+                                                             legendre_zfn_.data());
+                            const size_t jcol = jlat - jblock;
+                            for (int jm = 0; jm <= truncation_; jm++) {
+                                const size_t size_sym  = num_n(trc, jm, true);
+                                const size_t size_asym = num_n(trc, jm, false);
+                                Value* sym             = block_sym + block_sym_begin[jm] + jcol * size_sym;
+                                Value* asym            = block_asym + block_asym_begin[jm] + jcol * size_asym;
+                                // descending order of total wavenumbers, as in compute_legendre_polynomials
+                                size_t idx = (2 * trc + 3 - jm) * jm / 2 + trc - jm;
+                                for (int jn = trc; jn >= jm; jn--, idx--) {
                                     if ((jn - jm) % 2 == 0) {
-                                        scalar_sym[is++] = 0.;
+                                        *sym++ = static_cast<Value>(legpol[idx]);
                                     }
                                     else {
-                                        scalar_asym[ia++] = 0.;
+                                        *asym++ = static_cast<Value>(legpol[idx]);
                                     }
                                 }
                             }
                         }
                     }
-                    ATLAS_ASSERT(size_t(ia) == n_imag * nb_fields * size_asym &&
-                                 size_t(is) == n_imag * nb_fields * size_sym);
                 }
-                if (nlatsLegReduced_ - nlat0_[jm] > 0) {
-                    ATLAS_TRACE("matrix_multiply (" + std::string(linalg_backend) + ")");
+                ATLAS_TRACE("matrix_multiply (" + std::string(linalg_backend) + ")");
+                atlas_omp_parallel_for(int jm = 0; jm <= truncation_; jm++) {
+                    const int jlat_begin = std::max(jblock, int(nlat0_[jm]));
+                    if (not active[jm] || jlat_begin >= jblock_end) {
+                        continue;
+                    }
+                    const int n_imag       = (jm ? 2 : 1);
+                    const size_t size_sym  = num_n(trc, jm, true);
+                    const size_t size_asym = num_n(trc, jm, false);
+                    const int ncols        = jblock_end - jlat_begin;
+                    const size_t col_block = jlat_begin - jblock;
+                    const size_t col       = jlat_begin - nlat0_[jm];
                     {
-                        linalg::Matrix A(scalar_sym, nb_fields * n_imag, size_sym);
-                        linalg::Matrix B(legendre_sym_ + legendre_sym_begin_[jm] + nlat0_[jm] * size_sym, size_sym,
-                                         nlatsLegReduced_ - nlat0_[jm]);
-                        linalg::Matrix C(scl_fourier_sym, nb_fields * n_imag, nlatsLegReduced_ - nlat0_[jm]);
+                        Matrix A(scalar_sym + scalar_sym_begin[jm], nb_fields * n_imag, size_sym);
+                        Matrix B(block_sym + block_sym_begin[jm] + col_block * size_sym, size_sym, ncols);
+                        Matrix C(scl_fourier_sym + fourier_begin[jm] + col * nb_fields * n_imag, nb_fields * n_imag,
+                                 ncols);
                         linalg::matrix_multiply(A, B, C, linalg_backend);
-                        /*Log::info() << "sym: ";
-                        for ( int j = 0; j < size_sym * ( nlatsLegReduced_ - nlat0_[jm] ); j++ ) {
-                            Log::info() << legendre_sym_[j + legendre_sym_begin_[jm] + nlat0_[jm] * size_sym] << " ";
-                        }
-                        Log::info() << std::endl;*/
                     }
                     if (size_asym > 0) {
-                        linalg::Matrix A(scalar_asym, nb_fields * n_imag, size_asym);
-                        linalg::Matrix B(legendre_asym_ + legendre_asym_begin_[jm] + nlat0_[jm] * size_asym, size_asym,
-                                         nlatsLegReduced_ - nlat0_[jm]);
-                        linalg::Matrix C(scl_fourier_asym, nb_fields * n_imag, nlatsLegReduced_ - nlat0_[jm]);
+                        Matrix A(scalar_asym + scalar_asym_begin[jm], nb_fields * n_imag, size_asym);
+                        Matrix B(block_asym + block_asym_begin[jm] + col_block * size_asym, size_asym, ncols);
+                        Matrix C(scl_fourier_asym + fourier_begin[jm] + col * nb_fields * n_imag, nb_fields * n_imag,
+                                 ncols);
                         linalg::matrix_multiply(A, B, C, linalg_backend);
-                        /*Log::info() << "asym: ";
-                        for ( int j = 0; j < size_asym * ( nlatsLegReduced_ - nlat0_[jm] ); j++ ) {
-                            Log::info() << legendre_asym_[j + legendre_asym_begin_[jm] + nlat0_[jm] * size_asym] << " ";
-                        }
-                        Log::info() << std::endl;*/
                     }
                 }
-                {
-                    //ATLAS_TRACE( "merge spheres" );
-                    // northern hemisphere:
-                    for (int jlat = 0; jlat < nlatsNH_; jlat++) {
-                        if (nlatsLegReduced_ - nlat0_[jm] - nlatsNH_ + jlat >= 0) {
-                            for (int imag = 0; imag < n_imag; imag++) {
-                                for (int jfld = 0; jfld < nb_fields; jfld++) {
-                                    int idx = posFourier(jfld, imag, jlat, jm, nlatsNH_);
-                                    scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)] =
-                                        scl_fourier_sym[idx] + scl_fourier_asym[idx];
-                                }
-                            }
-                        }
-                        else {
-                            for (int imag = 0; imag < n_imag; imag++) {
-                                for (int jfld = 0; jfld < nb_fields; jfld++) {
-                                    scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)] = 0.;
-                                }
-                            }
-                        }
-                        /*for ( int imag = 0; imag < n_imag; imag++ ) {
-                        for ( int jfld = 0; jfld < nb_fields; jfld++ ) {
-                            if ( scl_fourier[posMethod( jfld, imag, jlat, jm, nb_fields, nlats )] > 0. ) {
-                                Log::info() << "jm=" << jm << " jlat=" << jlat << " nlatsLeg_=" << nlatsLeg_
-                                            << " nlat0=" << nlat0_[jm] << " nlatsNH=" << nlatsNH_ << std::endl;
-                            }
-                        }
-                    }*/
+            }
+
+            for (int jm = 0; jm <= truncation_; jm++) {
+                if (active[jm]) {
+                    merge(jm, scl_fourier_sym + fourier_begin[jm], scl_fourier_asym + fourier_begin[jm]);
+                }
+                else if (owns_zonal_wavenumber(jm)) {
+                    zero(jm);
+                }
+            }
+            free_aligned(scalar_sym);
+            free_aligned(scalar_asym);
+            free_aligned(scl_fourier_sym);
+            free_aligned(scl_fourier_asym);
+            free_aligned(block_sym);
+            free_aligned(block_asym);
+            return;
+        }
+
+        for (int jm = 0; jm <= truncation_; jm++) {
+            if (not owns_zonal_wavenumber(jm)) {
+                continue;
+            }
+            size_t size_sym  = num_n(truncation_ + 1, jm, true);
+            size_t size_asym = num_n(truncation_ + 1, jm, false);
+            const int n_imag = (jm ? 2 : 1);
+            int size_fourier = nb_fields * n_imag * (nlatsLegReduced_ - nlat0_[jm]);
+            if (size_fourier > 0) {
+                // THESE ARE REALLOCATED FOR EACH jm ???
+                // THEY COULD ALLOCATED ONCE BEFORE jm LOOP WITH A MAXIMUM SIZE?
+                Value* scalar_sym;
+                Value* scalar_asym;
+                Value* scl_fourier_sym;
+                Value* scl_fourier_asym;
+                alloc_aligned(scalar_sym, n_imag * nb_fields * size_sym);
+                alloc_aligned(scalar_asym, n_imag * nb_fields * size_asym);
+                alloc_aligned(scl_fourier_sym, size_fourier);
+                alloc_aligned(scl_fourier_asym, size_fourier);
+                split(jm, scalar_sym, scalar_asym);
+                if (nlatsLegReduced_ - nlat0_[jm] > 0) {
+                    ATLAS_TRACE("matrix_multiply (" + std::string(linalg_backend) + ")");
+                    {
+                        Matrix A(scalar_sym, nb_fields * n_imag, size_sym);
+                        Matrix B(legendre_sym<Value>() + legendre_sym_begin_[jm] + nlat0_[jm] * size_sym, size_sym,
+                                 nlatsLegReduced_ - nlat0_[jm]);
+                        Matrix C(scl_fourier_sym, nb_fields * n_imag, nlatsLegReduced_ - nlat0_[jm]);
+                        linalg::matrix_multiply(A, B, C, linalg_backend);
                     }
-                    // southern hemisphere:
-                    for (int jlat = 0; jlat < nlatsSH_; jlat++) {
-                        int jslat = nlats - jlat - 1;
-                        if (nlatsLegReduced_ - nlat0_[jm] - nlatsSH_ + jlat >= 0) {
-                            for (int imag = 0; imag < n_imag; imag++) {
-                                for (int jfld = 0; jfld < nb_fields; jfld++) {
-                                    int idx = posFourier(jfld, imag, jlat, jm, nlatsSH_);
-                                    scl_fourier[posMethod(jfld, imag, jslat, jm, nb_fields, nlats)] =
-                                        scl_fourier_sym[idx] - scl_fourier_asym[idx];
-                                }
-                            }
-                        }
-                        else {
-                            for (int imag = 0; imag < n_imag; imag++) {
-                                for (int jfld = 0; jfld < nb_fields; jfld++) {
-                                    scl_fourier[posMethod(jfld, imag, jslat, jm, nb_fields, nlats)] = 0.;
-                                }
-                            }
-                        }
+                    if (size_asym > 0) {
+                        Matrix A(scalar_asym, nb_fields * n_imag, size_asym);
+                        Matrix B(legendre_asym<Value>() + legendre_asym_begin_[jm] + nlat0_[jm] * size_asym,
+                                 size_asym, nlatsLegReduced_ - nlat0_[jm]);
+                        Matrix C(scl_fourier_asym, nb_fields * n_imag, nlatsLegReduced_ - nlat0_[jm]);
+                        linalg::matrix_multiply(A, B, C, linalg_backend);
                     }
                 }
+                merge(jm, scl_fourier_sym, scl_fourier_asym);
                 free_aligned(scalar_sym);
                 free_aligned(scalar_asym);
                 free_aligned(scl_fourier_sym);
                 free_aligned(scl_fourier_asym);
             }
             else {
-                for (int jlat = 0; jlat < nlats; jlat++) {
-                    for (int imag = 0; imag < n_imag; imag++) {
-                        for (int jfld = 0; jfld < nb_fields; jfld++) {
-                            scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)] = 0.;
-                        }
-                    }
-                }
+                zero(jm);
             }
         }
     }
@@ -1086,39 +1678,42 @@ void TransLocal::invtrans_legendre(const int truncation, const int nlats, const
 
 // --------------------------------------------------------------------------------------------------------------------
 
-void TransLocal::invtrans_fourier_regular(const int nlats, const int nlons, const int nb_fields, double scl_fourier[],
-                                          double gp_fields[], const eckit::Configuration&) const {
+template <typename Value>
+void TransLocal::invtrans_fourier_regular(const int nlats, const int nlons, const int nb_fields, Value scl_fourier[],
+                                          Value gp_fields[], const eckit::Configuration&) const {
+    using Matrix = dense_matrix_t<Value>;
     // Fourier transformation:
     if (useFFT_) {
 #if ATLAS_HAVE_FFTW && !TRANSLOCAL_DGEMM2
         {
+            auto& fftw      = fftw_->plans<Value>();
             int num_complex = (nlonsMaxGlobal_ / 2) + 1;
             {
                 ATLAS_TRACE("Inverse Fourier Transform (FFTW, RegularGrid)");
+                const int nlats_band = jlatEnd_ - jlatBegin_;
                 for (int jfld = 0; jfld < nb_fields; jfld++) {
                     int idx = 0;
-                    for (int jlat = 0; jlat < nlats; jlat++) {
-                        fftw_->in[idx++][0] = scl_fourier[posMethod(jfld, 0, jlat, 0, nb_fields, nlats)];
+                    for (int jlat = jlatBegin_; jlat < jlatEnd_; jlat++) {
+                        fftw.in[idx++][0] = scl_fourier[posMethod(jfld, 0, jlat, 0, nb_fields, nlats)];
                         for (int jm = 1; jm < num_complex; jm++, idx++) {
                             for (int imag = 0; imag < 2; imag++) {
                                 if (jm <= truncation_) {
-                                    fftw_->in[idx][imag] =
-                                        scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)];
+                                    fftw.in[idx][imag] = scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)];
                                 }
                                 else {
-                                    fftw_->in[idx][imag] = 0.;
+                                    fftw.in[idx][imag] = 0.;
                                 }
                             }
                         }
                     }
-                    fftw_execute_dft_c2r(fftw_->plans[0], fftw_->in, fftw_->out);
-                    for (int jlat = 0; jlat < nlats; jlat++) {
+                    fftw.execute(0);
+                    for (int jlat = 0; jlat < nlats_band; jlat++) {
                         for (int jlon = 0; jlon < nlons; jlon++) {
                             int j = jlon + jlonMin_[0];
                             if (j >= nlonsMaxGlobal_) {
                                 j -= nlonsMaxGlobal_;
                             }
-                            gp_fields[jlon + nlons * (jlat + nlats * jfld)] = fftw_->out[j + nlonsMaxGlobal_ * jlat];
+                            gp_fields[jlon + nlons * (jlat + nlats_band * jfld)] = fftw.out[j + nlonsMaxGlobal_ * jlat];
                         }
                     }
                 }
@@ -1133,23 +1728,34 @@ void TransLocal::invtrans_fourier_regular(const int nlats, const int nlons, cons
         {
             ATLAS_TRACE("Inverse Fourier Transform (NoFFT,matrix_multiply=" + detect_linalg_backend(linalg_backend_) +
                         ")");
-            linalg::Matrix A(fourier_, nlons, (truncation_ + 1) * 2);
-            linalg::Matrix B(scl_fourier, (truncation_ + 1) * 2, nb_fields * nlats);
-            linalg::Matrix C(gp_fields, nlons, nb_fields * nlats);
-
-            linalg::matrix_multiply(A, B, C, linalg_backend);
+            Matrix A(fourier<Value>(), nlons, (truncation_ + 1) * 2);
+            const int nlats_band = jlatEnd_ - jlatBegin_;
+            if (nlats_band == nlats) {
+                Matrix B(scl_fourier, (truncation_ + 1) * 2, nb_fields * nlats);
+                Matrix C(gp_fields, nlons, nb_fields * nlats);
+                linalg::matrix_multiply(A, B, C, linalg_backend);
+            }
+            else {
+                // latitude band of a distributed transform: one matrix_multiply per field
+                for (int jfld = 0; jfld < nb_fields; jfld++) {
+                    Matrix B(scl_fourier + posMethod(jfld, 0, jlatBegin_, 0, nb_fields, nlats), (truncation_ + 1) * 2,
+                             nlats_band);
+                    Matrix C(gp_fields + size_t(jfld) * nlons * nlats_band, nlons, nlats_band);
+                    linalg::matrix_multiply(A, B, C, linalg_backend);
+                }
+            }
         }
 #else
         // dgemm-method 2
         // should be faster for small domains or large truncation
         // but have not found any significant speedup so far
-        double* gp;
+        Value* gp;
         alloc_aligned(gp, nb_fields * grid_.size());
         {
             ATLAS_TRACE("Fourier dgemm method 2");
-            linalg::Matrix A(scl_fourier, nb_fields * nlats, (truncation_ + 1) * 2);
-            linalg::Matrix B(fourier_, (truncation_ + 1) * 2, nlons);
-            linalg::Matrix C(gp, nb_fields * nlats, nlons);
+            Matrix A(scl_fourier, nb_fields * nlats, (truncation_ + 1) * 2);
+            Matrix B(fourier<Value>(), (truncation_ + 1) * 2, nlons);
+            Matrix C(gp, nb_fields * nlats, nlons);
             linalg::matrix_multiply(A, B, C, linalg_backend);
         }
 
@@ -1174,52 +1780,64 @@ void TransLocal::invtrans_fourier_regular(const int nlats, const int nlons, cons
 
 // --------------------------------------------------------------------------------------------------------------------
 
+template <typename Value>
 void TransLocal::invtrans_fourier_reduced(const int nlats, const StructuredGrid& g, const int nb_fields,
-                                          double scl_fourier[], double gp_fields[], const eckit::Configuration&) const {
+                                          Value scl_fourier[], Value gp_fields[], const eckit::Configuration&) const {
     // Fourier transformation:
     if (useFFT_) {
 #if ATLAS_HAVE_FFTW && !TRANSLOCAL_DGEMM2
         {
+            auto& fftw          = fftw_->plans<Value>();
+            const auto& batches = fftw_->batches;
             {
                 ATLAS_TRACE("Inverse Fourier Transform (FFTW, ReducedGrid)");
-                int jgp = 0;
-                for (int jfld = 0; jfld < nb_fields; jfld++) {
-                    for (int jlat = 0; jlat < nlats; jlat++) {
-                        int idx = 0;
-                        //Log::info() << jlat << "in:" << std::endl;
-                        int num_complex     = (nlonsGlobal_[jlat] / 2) + 1;
-                        fftw_->in[idx++][0] = scl_fourier[posMethod(jfld, 0, jlat, 0, nb_fields, nlats)];
-                        //Log::info() << fftw_->in[0][0] << " ";
-                        for (int jm = 1; jm < num_complex; jm++, idx++) {
+                // offset of each latitude in a grid point field
+                std::vector<size_t> gp_offset(jlatEnd_ - jlatBegin_ + 1, 0);
+                for (int jlat = jlatBegin_; jlat < jlatEnd_; jlat++) {
+                    gp_offset[jlat - jlatBegin_ + 1] = gp_offset[jlat - jlatBegin_] + g.nx(jlat);
+                }
+                const size_t nb_gp   = gp_offset.back();
+                const int nb_batches = static_cast<int>(batches.size());
+                const int nb_tasks   = nb_fields * nb_batches;
+                const int nb_threads = fftw_->nb_threads;
+                atlas_omp_pragma(omp parallel for schedule(dynamic) num_threads(nb_threads))
+                for (int jtask = 0; jtask < nb_tasks; jtask++) {
+                    const int jfld        = jtask / nb_batches;
+                    const int jbatch      = jtask % nb_batches;
+                    const auto& batch     = batches[jbatch];
+                    const int thread      = atlas_omp_get_thread_num();
+                    const int nlons       = batch.nlons;
+                    const int num_complex = (nlons / 2) + 1;
+                    auto* in              = fftw.in + thread * fftw.stride_complex;
+                    auto* out             = fftw.out + thread * fftw.stride_real;
+                    for (size_t jb = 0; jb < batch.jlats.size(); jb++) {
+                        const int jlat = batch.jlats[jb];
+                        auto* in_lat   = in + jb * num_complex;
+                        in_lat[0][0]   = scl_fourier[posMethod(jfld, 0, jlat, 0, nb_fields, nlats)];
+                        in_lat[0][1]   = 0.;
+                        for (int jm = 1; jm < num_complex; jm++) {
                             for (int imag = 0; imag < 2; imag++) {
                                 if (jm <= truncation_) {
-                                    fftw_->in[idx][imag] =
-                                        scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)];
+                                    in_lat[jm][imag] = scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)];
                                 }
                                 else {
-                                    fftw_->in[idx][imag] = 0.;
+                                    in_lat[jm][imag] = 0.;
                                 }
-                                //Log::info() << fftw_->in[idx][imag] << " ";
                             }
                         }
-                        //Log::info() << std::endl;
-                        //Log::info() << jlat << "out:" << std::endl;
-                        int jplan = nlatsLegDomain_ - nlatsNH_ + jlat;
-                        if (jplan >= nlatsLegDomain_) {
-                            jplan = nlats - 1 + nlatsLegDomain_ - nlatsSH_ - jlat;
-                        };
-                        //ASSERT( jplan < nlatsLeg_ && jplan >= 0 );
-                        fftw_execute_dft_c2r(fftw_->plans[jplan], fftw_->in, fftw_->out);
+                    }
+                    fftw.execute(jbatch, thread);
+                    for (size_t jb = 0; jb < batch.jlats.size(); jb++) {
+                        const int jlat      = batch.jlats[jb];
+                        const auto* out_lat = out + jb * nlons;
+                        Value* gp           = gp_fields + jfld * nb_gp + gp_offset[jlat - jlatBegin_];
                         for (int jlon = 0; jlon < g.nx(jlat); jlon++) {
                             int j = jlon + jlonMin_[jlat];
-                            if (j >= nlonsGlobal_[jlat]) {
-                                j -= nlonsGlobal_[jlat];
+                            if (j >= nlons) {
+                                j -= nlons;
                             }
-                            //Log::info() << fftw_->out[j] << " ";
-                            ATLAS_ASSERT(j < nlonsMaxGlobal_);
-                            gp_fields[jgp++] = fftw_->out[j];
+                            gp[jlon] = out_lat[j];
                         }
-                        //Log::info() << std::endl;
                     }
                 }
             }
@@ -1428,6 +2046,92 @@ void TransLocal::invtrans_unstructured(const int truncation, const int nb_fields
     free_aligned(zfn);
 }
 
+template <typename Value>
+void TransLocal::invtrans_structured(const int truncation, const int nb_fields, const int nb_vordiv_fields,
+                                     const double scalar_spectra[], double gp_fields[],
+                                     const eckit::Configuration& config) const {
+    auto g = StructuredGrid(grid_);
+    ATLAS_TRACE("invtrans_uv structured");
+    int nlats            = g.ny();
+    int nlons            = g.nxmax();
+    int size_fourier_max = nb_fields * 2 * nlats;
+    Value* scl_fourier;
+    alloc_aligned(scl_fourier, size_fourier_max * (truncation_ + 1));
+
+    // ATLAS-159 workaround begin
+    for (int i = 0; i < size_fourier_max * (truncation_ + 1); ++i) {
+        scl_fourier[i] = 0.;
+    }
+    // ATLAS-159 workaround end
+
+    // Legendre transformation:
+    invtrans_legendre(truncation, nlats, nb_fields, nb_vordiv_fields, scalar_spectra, scl_fourier, config);
+
+    // Fourier transformation of the latitude band into a temporary buffer when distributed or in single precision
+    Value* gp_band        = nullptr;
+    const bool copy_band  = distribution_ || not std::is_same_v<Value, double>;
+    const idx_t band_size = distribution_ ? distribution_->nb_band_points() : grid_.size();
+    if (distribution_) {
+        distribution_->transpose_fourier(nb_fields, scl_fourier, [&](int jfld, int imag, int jlat, int jm) {
+            return posMethod(jfld, imag, jlat, jm, nb_fields, nlats);
+        });
+    }
+    if (copy_band) {
+        alloc_aligned(gp_band, size_t(nb_fields) * band_size);
+    }
+    else if constexpr (std::is_same_v<Value, double>) {
+        gp_band = gp_fields;
+    }
+
+    // Fourier transformation:
+    if (RegularGrid(gridGlobal_)) {
+        invtrans_fourier_regular(nlats, nlons, nb_fields, scl_fourier, gp_band, config);
+    }
+    else {
+        invtrans_fourier_reduced(nlats, g, nb_fields, scl_fourier, gp_band, config);
+    }
+
+    // Computing u,v from U,V:
+    {
+        if (nb_vordiv_fields > 0) {
+            ATLAS_TRACE("compute u,v from U,V");
+            std::vector<double> coslatinvs(nlats);
+            for (idx_t j = 0; j < nlats; ++j) {
+                double lat = g.y(j);
+                if (lat > latPole) {
+                    lat = latPole;
+                }
+                if (lat < -latPole) {
+                    lat = -latPole;
+                }
+                double coslat = std::cos(lat * util::Constants::degreesToRadians());
+                coslatinvs[j] = 1. / coslat;
+                //Log::info() << "lat=" << g.y( j ) << " coslat=" << coslat << std::endl;
+            }
+            int idx = 0;
+            for (idx_t jfld = 0; jfld < 2 * nb_vordiv_fields && jfld < nb_fields; jfld++) {
+                for (idx_t jlat = jlatBegin_; jlat < jlatEnd_; jlat++) {
+                    for (idx_t jlon = 0; jlon < g.nx(jlat); jlon++) {
+                        gp_band[idx] *= coslatinvs[jlat];
+                        idx++;
+                    }
+                }
+            }
+        }
+    }
+    free_aligned(scl_fourier);
+
+    if (copy_band) {
+        if (distribution_) {
+            distribution().exchange_gridpoints(nb_fields, gp_band, gp_fields);
+        }
+        else {
+            std::copy(gp_band, gp_band + size_t(nb_fields) * band_size, gp_fields);
+        }
+        free_aligned(gp_band);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Routine to compute the spectral transform by using a Local Fourier transformation
 // for a grid (same latitude for all longitudes, allows to compute Legendre functions
@@ -1447,65 +2151,16 @@ void TransLocal::invtrans_uv(const int truncation, const int nb_scalar_fields, c
                              const double scalar_spectra[], double gp_fields[],
                              const eckit::Configuration& config) const {
     if (nb_scalar_fields > 0) {
-        int nb_fields = nb_scalar_fields;
-
         // Transform
         if (StructuredGrid(grid_) && not grid_.projection()) {
-            auto g = StructuredGrid(grid_);
-            ATLAS_TRACE("invtrans_uv structured");
-            int nlats            = g.ny();
-            int nlons            = g.nxmax();
-            int size_fourier_max = nb_fields * 2 * nlats;
-            double* scl_fourier;
-            alloc_aligned(scl_fourier, size_fourier_max * (truncation_ + 1));
-
-            // ATLAS-159 workaround begin
-            for (int i = 0; i < size_fourier_max * (truncation_ + 1); ++i) {
-                scl_fourier[i] = 0.;
-            }
-            // ATLAS-159 workaround end
-
-            // Legendre transformation:
-            invtrans_legendre(truncation, nlats, nb_scalar_fields, nb_vordiv_fields, scalar_spectra, scl_fourier,
-                              config);
-
-            // Fourier transformation:
-            if (RegularGrid(gridGlobal_)) {
-                invtrans_fourier_regular(nlats, nlons, nb_fields, scl_fourier, gp_fields, config);
+            if (single_precision_) {
+                invtrans_structured<float>(truncation, nb_scalar_fields, nb_vordiv_fields, scalar_spectra, gp_fields,
+                                           config);
             }
             else {
-                invtrans_fourier_reduced(nlats, g, nb_fields, scl_fourier, gp_fields, config);
-            }
-
-            // Computing u,v from U,V:
-            {
-                if (nb_vordiv_fields > 0) {
-                    ATLAS_TRACE("compute u,v from U,V");
-                    std::vector<double> coslatinvs(nlats);
-                    for (idx_t j = 0; j < nlats; ++j) {
-                        double lat = g.y(j);
-                        if (lat > latPole) {
-                            lat = latPole;
-                        }
-                        if (lat < -latPole) {
-                            lat = -latPole;
-                        }
-                        double coslat = std::cos(lat * util::Constants::degreesToRadians());
-                        coslatinvs[j] = 1. / coslat;
-                        //Log::info() << "lat=" << g.y( j ) << " coslat=" << coslat << std::endl;
-                    }
-                    int idx = 0;
-                    for (idx_t jfld = 0; jfld < 2 * nb_vordiv_fields && jfld < nb_fields; jfld++) {
-                        for (idx_t jlat = 0; jlat < g.ny(); jlat++) {
-                            for (idx_t jlon = 0; jlon < g.nx(jlat); jlon++) {
-                                gp_fields[idx] *= coslatinvs[jlat];
-                                idx++;
-                            }
-                        }
-                    }
-                }
+                invtrans_structured<double>(truncation, nb_scalar_fields, nb_vordiv_fields, scalar_spectra, gp_fields,
+                                            config);
             }
-            free_aligned(scl_fourier);
         }
         else {
             if (unstruct_precomp_) {
@@ -1554,7 +2209,7 @@ void extend_truncation(const int old_truncation, const int nb_fields, const doub
 void TransLocal::invtrans(const int nb_scalar_fields, const double scalar_spectra[], const int nb_vordiv_fields,
                           const double vorticity_spectra[], const double divergence_spectra[], double gp_fields[],
                           const eckit::Configuration& config) const {
-    int nb_gp = grid_.size();
+    int nb_gp = nb_gridpoints();
     if (nb_vordiv_fields > 0) {
         // collect all spectral data into one array "all_spectra":
         ATLAS_TRACE("TransLocal::invtrans");
@@ -1652,17 +2307,23 @@ void TransLocal::invtrans_adj(const int nb_scalar_fields, const double gp_fields
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::dirtrans(const Field& gpfield, Field& spfield, const eckit::Configuration& config) const {
-    ATLAS_NOTIMPLEMENTED;
-    // Not implemented and not planned.
-    // Use the TransIFS implementation instead.
+    ATLAS_ASSERT(gpfield.rank() == 1, "Only rank-1 fields supported at the moment");
+    ATLAS_ASSERT(spfield.rank() == 1, "Only rank-1 fields supported at the moment");
+    const auto gp_fields = array::make_view<double, 1>(gpfield);
+    auto scalar_spectra  = array::make_view<double, 1>(spfield);
+    ATLAS_ASSERT(gp_fields.shape(0) >= nb_gridpoints());
+    ATLAS_ASSERT(size_t(scalar_spectra.shape(0)) == 2 * legendre_size(truncation_));
+
+    dirtrans(1, gp_fields.data(), scalar_spectra.data(), config);
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::dirtrans(const FieldSet& gpfields, FieldSet& spfields, const eckit::Configuration& config) const {
-    ATLAS_NOTIMPLEMENTED;
-    // Not implemented and not planned.
-    // Use the TransIFS implementation instead.
+    ATLAS_ASSERT(gpfields.size() == spfields.size());
+    for (idx_t f = 0; f < gpfields.size(); ++f) {
+        dirtrans(gpfields[f], spfields[f], config);
+    }
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -1697,13 +2358,241 @@ void TransLocal::dirtrans_wind2vordiv_adj(const Field& spvor, const Field& spdiv
 }
 
 
+// --------------------------------------------------------------------------------------------------------------------
+
+void TransLocal::dirtrans_fourier(const StructuredGrid& g, const int nb_fields, const double gp_fields[],
+                                  double scl_fourier[]) const {
+    const int nlats = g.ny();
+    // offset of each latitude in a grid point field
+    std::vector<size_t> gp_offset(nlats + 1, 0);
+    for (int jlat = 0; jlat < nlats; jlat++) {
+        gp_offset[jlat + 1] = gp_offset[jlat] + g.nx(jlat);
+    }
+    const size_t nb_gp = gp_offset.back();
+
+    // The Fourier coefficients are the discrete Fourier coefficients divided by the number of longitudes, so that
+    // invtrans_fourier reproduces the grid point values. Zonal wavenumbers which are not resolved by the latitude are
+    // set to zero.
+    auto store = [&](int jfld, int jlat, int nlons, const auto& coefficient) {
+        const int nm = std::min(truncation_, (nlons - 1) / 2);
+        for (int jm = 0; jm <= truncation_; jm++) {
+            for (int imag = 0; imag < 2; imag++) {
+                scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)] =
+                    (jm <= nm && (jm > 0 || imag == 0)) ? coefficient(jm, imag) / nlons : 0.;
+            }
+        }
+    };
+
+    if (useFFT_) {
+#if ATLAS_HAVE_FFTW && !TRANSLOCAL_DGEMM2
+        auto& fftw = fftw_->direct;
+        std::call_once(fftw_->direct_plans_created, [&]() {
+            ATLAS_TRACE("Fourier precomputations (FFTW, direct)");
+            auto& wisdom          = FFTWWisdom::instance();
+            auto lock             = wisdom.lock();
+            size_t max_batch_size = 0;
+            auto& batches         = fftw_->direct_batches;
+            batches = detail::fftw_latitude_batches(0, nlats, [&](int jlat) { return g.nx(jlat); }, max_batch_size);
+            fftw_->direct_nb_threads = atlas_omp_get_max_threads();
+            fftw.allocate(max_batch_size * (nlonsMaxGlobal_ / 2 + 1), max_batch_size * nlonsMaxGlobal_,
+                          fftw_->direct_nb_threads);
+            fftw.plans.resize(batches.size());
+            for (size_t jbatch = 0; jbatch < batches.size(); ++jbatch) {
+                const int nlons = batches[jbatch].nlons;
+                fftw.plans[jbatch] =
+                    fftw.plan_many_r2c(nlons, batches[jbatch].jlats.size(), nlons, nlons / 2 + 1, fftw_->planning);
+            }
+            if (fftw_->planning != FFTW_ESTIMATE) {
+                wisdom.planned();
+            }
+        });
+
+        ATLAS_TRACE("Direct Fourier Transform (FFTW)");
+        const auto& batches  = fftw_->direct_batches;
+        const bool regular   = RegularGrid(gridGlobal_);
+        const int nb_batches = static_cast<int>(batches.size());
+        const int nb_tasks   = nb_fields * nb_batches;
+        // Tasks are distributed dynamically over one slot per allocated buffer, so that buffers are indexed
+        // independently of the number of OpenMP threads at the time of the call
+        const int nb_slots = std::min(fftw_->direct_nb_threads, nb_tasks);
+        std::atomic<int> next_task{0};
+        atlas_omp_parallel_for(int jslot = 0; jslot < nb_slots; jslot++) {
+            auto* in  = fftw.in + jslot * fftw.stride_complex;
+            auto* out = fftw.out + jslot * fftw.stride_real;
+            for (int jtask = next_task++; jtask < nb_tasks; jtask = next_task++) {
+                const int jfld        = jtask / nb_batches;
+                const int jbatch      = jtask % nb_batches;
+                const auto& batch     = batches[jbatch];
+                const int nlons       = batch.nlons;
+                const int num_complex = (nlons / 2) + 1;
+                for (size_t jb = 0; jb < batch.jlats.size(); jb++) {
+                    const int jlat     = batch.jlats[jb];
+                    const int jlon_min = regular ? jlonMin_[0] : jlonMin_[jlat];
+                    double* out_lat    = out + jb * nlons;
+                    const double* gp   = gp_fields + jfld * nb_gp + gp_offset[jlat];
+                    for (int jlon = 0; jlon < nlons; jlon++) {
+                        int j = jlon + jlon_min;
+                        if (j >= nlons) {
+                            j -= nlons;
+                        }
+                        out_lat[j] = gp[jlon];
+                    }
+                }
+                fftw.execute_r2c(jbatch, jslot);
+                for (size_t jb = 0; jb < batch.jlats.size(); jb++) {
+                    const auto* in_lat = in + jb * num_complex;
+                    store(jfld, batch.jlats[jb], nlons, [&](int jm, int imag) { return in_lat[jm][imag]; });
+                }
+            }
+        }
+#endif
+    }
+    else {
+        if (not RegularGrid(gridGlobal_)) {
+            throw_NotImplemented(
+                "Using dgemm in Fourier transform for reduced grids is extremely slow. Please install and use FFTW!",
+                Here());
+        }
+        ATLAS_TRACE("Direct Fourier Transform (NoFFT)");
+        // Discrete Fourier transform with the precomputed coefficients of the inverse transform, which include the
+        // factor 2 of the nonzero zonal wavenumbers
+        const int nlons = g.nxmax();
+        auto fourier    = [&](int jlon, int jm, int imag) {
+#if !TRANSLOCAL_DGEMM2
+            return fourier_[jlon + nlons * (imag + 2 * jm)];
+#else
+            return fourier_[imag + 2 * (jm + (truncation_ + 1) * jlon)];
+#endif
+        };
+        atlas_omp_parallel_for(int jtask = 0; jtask < nb_fields * nlats; jtask++) {
+            const int jfld   = jtask / nlats;
+            const int jlat   = jtask % nlats;
+            const double* gp = gp_fields + jfld * nb_gp + gp_offset[jlat];
+            store(jfld, jlat, nlons, [&](int jm, int imag) {
+                double sum = 0.;
+                for (int jlon = 0; jlon < nlons; jlon++) {
+                    sum += fourier(jlon, jm, imag) * gp[jlon];
+                }
+                return jm ? 0.5 * sum : sum;
+            });
+        }
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+void TransLocal::dirtrans_legendre(const int nlats, const int nb_fields, const double scl_fourier[],
+                                   double scalar_spectra[]) const {
+    ATLAS_TRACE("Direct Legendre Transform (GEMM)");
+    linalg::dense::Backend linalg_backend{linalg_backend_};
+    const int trc = truncation_ + 1;
+
+    // Gaussian quadrature weights of the latitudes from the north pole to the equator, summing up to 1/2
+    std::vector<double> lats(nlatsLeg_);
+    std::vector<double> weights(nlatsLeg_);
+    util::gaussian_quadrature_npole_equator(nlatsLeg_, lats.data(), weights.data());
+
+    // For each zonal wavenumber, the spectral coefficients are the quadrature of the Fourier coefficients times the
+    // Legendre polynomials. The sum and the difference of both hemispheres are multiplied by the symmetric and
+    // antisymmetric polynomials, in the layout of invtrans_legendre: descending total wavenumbers from truncation_+1,
+    // and latitudes from nlat0_[jm] to the equator.
+    atlas_omp_parallel_for(int jm = 0; jm <= truncation_; jm++) {
+        const int n_imag       = (jm ? 2 : 1);
+        const int nk           = nb_fields * n_imag;
+        const size_t size_sym  = num_n(trc, jm, true);
+        const size_t size_asym = num_n(trc, jm, false);
+        const int ncols        = nlatsLeg_ - nlat0_[jm];
+        const size_t ioff      = size_t(2 * truncation_ + 3 - jm) * jm / 2 * nb_fields * 2;
+
+        std::vector<double> spectra_sym(size_sym * nk, 0.);
+        std::vector<double> spectra_asym(size_asym * nk, 0.);
+        if (ncols > 0) {
+            std::vector<double> fourier_sym(size_t(ncols) * nk);
+            std::vector<double> fourier_asym(size_t(ncols) * nk);
+            for (int jcol = 0; jcol < ncols; jcol++) {
+                const int jlat  = nlat0_[jm] + jcol;
+                const int jslat = nlats - 1 - jlat;
+                const double w  = weights[jlat];
+                for (int imag = 0; imag < n_imag; imag++) {
+                    for (int jfld = 0; jfld < nb_fields; jfld++) {
+                        const size_t idx   = jcol + size_t(ncols) * (jfld + nb_fields * imag);
+                        const double north = scl_fourier[posMethod(jfld, imag, jlat, jm, nb_fields, nlats)];
+                        const double south = scl_fourier[posMethod(jfld, imag, jslat, jm, nb_fields, nlats)];
+                        fourier_sym[idx]   = w * (north + south);
+                        fourier_asym[idx]  = w * (north - south);
+                    }
+                }
+            }
+            if (size_sym > 0) {
+                linalg::Matrix A(legendre_sym_ + legendre_sym_begin_[jm] + nlat0_[jm] * size_sym, size_sym, ncols);
+                linalg::Matrix B(fourier_sym.data(), ncols, nk);
+                linalg::Matrix C(spectra_sym.data(), size_sym, nk);
+                linalg::matrix_multiply(A, B, C, linalg_backend);
+            }
+            if (size_asym > 0) {
+                linalg::Matrix A(legendre_asym_ + legendre_asym_begin_[jm] + nlat0_[jm] * size_asym, size_asym,
+                                 ncols);
+                linalg::Matrix B(fourier_asym.data(), ncols, nk);
+                linalg::Matrix C(spectra_asym.data(), size_asym, nk);
+                linalg::matrix_multiply(A, B, C, linalg_backend);
+            }
+        }
+
+        size_t is = 0, ia = 0;
+        for (int jn = trc; jn >= jm; jn--) {
+            const bool symmetric = (jn - jm) % 2 == 0;
+            const size_t row     = symmetric ? is++ : ia++;
+            if (jn > truncation_) {
+                continue;
+            }
+            for (int imag = 0; imag < 2; imag++) {
+                for (int jfld = 0; jfld < nb_fields; jfld++) {
+                    double& sp = scalar_spectra[jfld + nb_fields * (imag + 2 * (jn - jm)) + ioff];
+                    if (imag < n_imag) {
+                        const size_t k = jfld + nb_fields * imag;
+                        sp = symmetric ? spectra_sym[row + size_sym * k] : spectra_asym[row + size_asym * k];
+                    }
+                    else {
+                        sp = 0.;
+                    }
+                }
+            }
+        }
+    }
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::dirtrans(const int nb_fields, const double scalar_fields[], double scalar_spectra[],
                           const eckit::Configuration&) const {
-    ATLAS_NOTIMPLEMENTED;
-    // Not implemented and not planned.
-    // Use the TransIFS implementation instead.
+    ATLAS_TRACE("TransLocal::dirtrans");
+    if (not(GaussianGrid(grid_) && not grid_.projection())) {
+        throw_NotImplemented("TransLocal::dirtrans is only implemented for global Gaussian grids", Here());
+    }
+    if (distribution_) {
+        throw_NotImplemented("TransLocal::dirtrans is not implemented for more than 1 MPI task", Here());
+    }
+    if (single_precision_ || legendre_on_the_fly_) {
+        throw_NotImplemented(
+            "TransLocal::dirtrans requires Legendre polynomials precomputed in double precision", Here());
+    }
+    ATLAS_ASSERT(nlatsLegReduced_ == nlatsLeg_ && nlatsNH_ == nlatsLeg_ && nlatsSH_ == nlatsLeg_);
+    if (nb_fields == 0) {
+        return;
+    }
+
+    StructuredGrid g(grid_);
+    const int nlats = g.ny();
+    double* scl_fourier;
+    alloc_aligned(scl_fourier, size_t(nb_fields) * 2 * nlats * (truncation_ + 1));
+
+    // Fourier transformation:
+    dirtrans_fourier(g, nb_fields, scalar_fields, scl_fourier);
+
+    // Legendre transformation:
+    dirtrans_legendre(nlats, nb_fields, scl_fourier, scalar_spectra);
+
+    free_aligned(scl_fourier);
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -37,6 +37,7 @@ namespace trans {
 
 namespace detail {
 struct FFTW_Data;
+class TransLocalDistribution;
 }
 
 class LegendreCacheCreatorLocal;
@@ -59,8 +60,19 @@ int fourier_truncation(const int truncation,  // truncation
 ///  - support multiple fields
 ///  - support atlas::Field and atlas::FieldSet based on function spaces
 ///
-/// @note: Direct transforms are not implemented and cannot be unless
-///        the grid is global. There are no plans to support this at the moment.
+/// @note: Direct transforms of scalar fields (dirtrans) are implemented for global Gaussian grids, regular or
+///        reduced, on a single MPI task and in double precision. They use Gaussian quadrature with the precomputed
+///        Legendre polynomials, and real-to-complex FFTW plans created at the first direct transform.
+///        They throw NotImplemented for a transform distributed over more than 1 MPI task, with "precision" set to
+///        "single", or with "legendre_on_the_fly".
+///        The gradient of scalar fields (invtrans_grad) is computed from the spectral Laplacian, as the wind of
+///        the corresponding divergence. The gradient field holds the eastward and northward components.
+///
+/// @note: With more than 1 MPI task, only global structured grids are supported. The zonal wavenumbers are
+///        distributed over the tasks for the Legendre transform, and latitude bands for the Fourier transform.
+///        Spectral coefficients are not distributed. Grid point fields are distributed as the StructuredColumns
+///        function space given to the constructor, or else following the "partitioner" configuration
+///        (default "equal_regions").
 ///
 /// @note: The matrix_multiply (GEMM) implementation can be configured within the Configuration argument in the constructor
 ///        using "matrix_multiply" key or if not given, it will use the atlas::linalg::dense::current_backend(),
@@ -72,6 +84,25 @@ int fourier_truncation(const int truncation,  // truncation
 ///        - "lapack"  : "lapack"  backend for eckit::linalg::LinearAlgebra
 ///        - "openmp"  : "openmp"  backend for eckit::linalg::LinearAlgebra, or "generic" if "openmp" is not available.
 ///        - "eigen"   : "eigen"   backend for eckit::linalg::LinearAlgebra
+///
+/// @note: With "precision" set to "single" in the Configuration argument in the constructor, the transforms of
+///        structured grids are computed in single precision: Legendre coefficients are stored in single precision,
+///        and the matrix multiplications and FFTs are single precision (FFTs fall back to double precision if
+///        the single precision FFTW library is not available). Spectral and grid point fields remain double precision.
+///
+/// @note: The FFTW planning effort is set with "fftw_planning" in the Configuration argument in the constructor:
+///        "estimate" (default), "measure" or "patient". Wisdom gathered while planning is shared by all TransLocal
+///        instances, and is persisted across runs when ATLAS_FFTW_WISDOM is set to a file path (see FFTWWisdom).
+///
+/// @note: With "legendre_on_the_fly" set to true in the Configuration argument in the constructor, the Legendre
+///        polynomials of structured grids are not stored, but recomputed in each transform for blocks of
+///        "legendre_block_size" latitudes (default 16). This reduces memory by orders of magnitude for high
+///        truncations, at the cost of computing the polynomials again. It cannot be combined with a Legendre cache.
+///
+/// @note: Legendre caches written or exported by TransLocal start with a header holding the truncation, a digest of
+///        the latitudes, the precision and the layout version of the polynomials. A cache which does not match the
+///        transform is rejected from its header. A MappedLegendreCache maps the cache file into memory instead of
+///        reading it, so that all processes on a node share one copy in the page cache.
 
 class TransLocal : public trans::TransImpl {
 public:
@@ -145,14 +176,17 @@ public:
                               double divergence_spectra[],
                               const eckit::Configuration& = util::NoConfig()) const override;
 
-    // -- NOT SUPPORTED -- //
-
     virtual void dirtrans(const Field& gpfield, Field& spfield,
                           const eckit::Configuration& = util::NoConfig()) const override;
 
     virtual void dirtrans(const FieldSet& gpfields, FieldSet& spfields,
                           const eckit::Configuration& = util::NoConfig()) const override;
 
+    virtual void dirtrans(const int nb_fields, const double scalar_fields[], double scalar_spectra[],
+                          const eckit::Configuration& = util::NoConfig()) const override;
+
+    // -- NOT SUPPORTED -- //
+
     virtual void dirtrans_wind2vordiv(const Field& gpwind, Field& spvor, Field& spdiv,
                                       const eckit::Configuration& = util::NoConfig()) const override;
 
@@ -165,13 +199,28 @@ public:
     virtual void dirtrans_wind2vordiv_adj(const Field& spvor, const Field& spdiv, Field& gpwind,
                                           const eckit::Configuration& = util::NoConfig()) const override;
 
-    virtual void dirtrans(const int nb_fields, const double scalar_fields[], double scalar_spectra[],
-                          const eckit::Configuration& = util::NoConfig()) const override;
-
     virtual void dirtrans(const int nb_fields, const double wind_fields[], double vorticity_spectra[],
                           double divergence_spectra[], const eckit::Configuration& = util::NoConfig()) const override;
 
+protected:
+    /// @brief Construct with the grid points of this MPI task, as 0-based global indices in the order of the grid
+    /// point fields, instead of distributing them with the "partitioner"
+    TransLocal(const Cache&, const Grid&, const long truncation, const std::vector<gidx_t>& gridpoints,
+               const eckit::Configuration&);
+
 private:
+    TransLocal(const Cache&, const Grid&, const Domain&, const long truncation, const std::vector<gidx_t>* gridpoints,
+               const eckit::Configuration&);
+
+    /// @brief Set up the grid point exchange of the MPI distribution, which is collective
+    void setup_gridpoints(const std::vector<gidx_t>* gridpoints);
+
+    /// @brief Number of grid points of this MPI task
+    idx_t nb_gridpoints() const;
+
+    /// @brief MPI distribution, set up in the constructor
+    const detail::TransLocalDistribution& distribution() const;
+
     int posMethod(const int jfld, const int imag, const int jlat, const int jm, const int nb_fields,
                   const int nlats) const {
 #if !TRANSLOCAL_DGEMM2
@@ -181,15 +230,37 @@ private:
 #endif
     }
 
+    /// @brief Legendre and Fourier coefficients in the precision of the transform
+    template <typename Value>
+    Value* legendre_sym() const;
+    template <typename Value>
+    Value* legendre_asym() const;
+    template <typename Value>
+    Value* fourier() const;
+
+    template <typename Value>
+    void invtrans_structured(const int truncation, const int nb_fields, const int nb_vordiv_fields,
+                             const double scalar_spectra[], double gp_fields[],
+                             const eckit::Configuration& config) const;
+
+    template <typename Value>
     void invtrans_legendre(const int truncation, const int nlats, const int nb_fields, const int nb_vordiv_fields,
-                           const double scalar_spectra[], double scl_fourier[],
+                           const double scalar_spectra[], Value scl_fourier[],
                            const eckit::Configuration& config) const;
 
-    void invtrans_fourier_regular(const int nlats, const int nlons, const int nb_fields, double scl_fourier[],
-                                  double gp_fields[], const eckit::Configuration& config) const;
+    template <typename Value>
+    void invtrans_fourier_regular(const int nlats, const int nlons, const int nb_fields, Value scl_fourier[],
+                                  Value gp_fields[], const eckit::Configuration& config) const;
 
-    void invtrans_fourier_reduced(const int nlats, const StructuredGrid& g, const int nb_fields, double scl_fourier[],
-                                  double gp_fields[], const eckit::Configuration& config) const;
+    template <typename Value>
+    void invtrans_fourier_reduced(const int nlats, const StructuredGrid& g, const int nb_fields, Value scl_fourier[],
+                                  Value gp_fields[], const eckit::Configuration& config) const;
+
+    void dirtrans_fourier(const StructuredGrid& g, const int nb_fields, const double gp_fields[],
+                          double scl_fourier[]) const;
+
+    void dirtrans_legendre(const int nlats, const int nb_fields, const double scl_fourier[],
+                           double scalar_spectra[]) const;
 
     void invtrans_unstructured_precomp(const int truncation, const int nb_scalar_fields, const int nb_vordiv_fields,
                                        const double scalar_spectra[], double gp_fields[],
@@ -215,6 +286,9 @@ private:
     bool dgemmMethod1_;
     bool unstruct_precomp_;
     bool no_symmetry_;
+    bool single_precision_;
+    bool legendre_on_the_fly_{false};
+    int legendre_block_size_{16};
     int truncation_;
     idx_t nlatsNH_;
     idx_t nlatsSH_;
@@ -234,9 +308,14 @@ private:
     double* legendre_asym_;
     double* fourier_;
     double* fouriertp_;
+    float* legendre_sym_f_{nullptr};
+    float* legendre_asym_f_{nullptr};
+    float* fourier_f_{nullptr};
     std::vector<size_t> legendre_begin_;
     std::vector<size_t> legendre_sym_begin_;
     std::vector<size_t> legendre_asym_begin_;
+    std::vector<double> legendre_lats_;  // latitudes of the Legendre polynomials computed on the fly
+    std::vector<double> legendre_zfn_;   // coefficients of the recurrence for the polynomials computed on the fly
 
     Cache cache_;
     Cache export_legendre_;
@@ -247,6 +326,11 @@ private:
 
     std::unique_ptr<detail::FFTW_Data> fftw_;
 
+    std::unique_ptr<detail::TransLocalDistribution> distribution_;
+    std::string partitioner_;
+    idx_t jlatBegin_{0};  // latitudes of the Fourier transform on this task
+    idx_t jlatEnd_{0};
+
     std::string linalg_backend_;
     int warning_ = 0;
 };
@@ -0,0 +1,178 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/trans/local/TransLocalDistribution.h"
+
+#include <algorithm>
+#include <string>
+
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace trans {
+namespace detail {
+
+//-----------------------------------------------------------------------------
+
+TransLocalDistribution::TransLocalDistribution(const StructuredGrid& grid, int truncation, const mpi::Comm& comm):
+    comm_(comm), nb_parts_(static_cast<int>(comm.size())), part_(static_cast<int>(comm.rank())) {
+    ATLAS_ASSERT(grid);
+
+    // Zonal wavenumbers in snake order, so that each part gets both small and large wavenumbers
+    zonal_wavenumbers_.resize(nb_parts_);
+    zonal_wavenumber_part_.resize(truncation + 1);
+    for (int jm = 0, p = 0, direction = 1; jm <= truncation; ++jm) {
+        zonal_wavenumbers_[p].emplace_back(jm);
+        zonal_wavenumber_part_[jm] = p;
+        if (p + direction == nb_parts_ || p + direction < 0) {
+            direction = -direction;
+        }
+        else {
+            p += direction;
+        }
+    }
+
+    // Latitude bands with a balanced number of grid points
+    const idx_t ny = grid.ny();
+    lat_offset_.resize(ny + 1);
+    lat_offset_[0] = 0;
+    for (idx_t j = 0; j < ny; ++j) {
+        lat_offset_[j + 1] = lat_offset_[j] + grid.nx(j);
+    }
+    if (ny < nb_parts_) {
+        throw_Exception("TransLocal: cannot distribute " + std::to_string(ny) + " latitudes over " +
+                            std::to_string(nb_parts_) + " MPI tasks",
+                        Here());
+    }
+    const gidx_t size = lat_offset_[ny];
+    jlat_begin_.resize(nb_parts_ + 1);
+    idx_t j = 0;
+    for (int p = 0; p < nb_parts_; ++p) {
+        while (j < ny && lat_offset_[j] * nb_parts_ < size * p) {
+            ++j;
+        }
+        // every part gets at least one latitude
+        j              = std::min<idx_t>(std::max<idx_t>(j, p ? jlat_begin_[p - 1] + 1 : 0), ny - (nb_parts_ - p));
+        jlat_begin_[p] = j;
+    }
+    jlat_begin_[nb_parts_] = ny;
+}
+
+//-----------------------------------------------------------------------------
+
+void TransLocalDistribution::setup_gridpoints(const std::vector<gidx_t>& points) {
+    ATLAS_TRACE("TransLocal: setup grid point exchange");
+    const gidx_t size = lat_offset_.back();
+
+    // Request each point from the part that computes its latitude
+    std::vector<std::vector<gidx_t>> requests(nb_parts_);
+    std::vector<std::vector<idx_t>> positions(nb_parts_);
+    for (size_t i = 0; i < points.size(); ++i) {
+        const gidx_t g = points[i];
+        ATLAS_ASSERT(g >= 0 && g < size);
+        const idx_t jlat =
+            static_cast<idx_t>(std::upper_bound(lat_offset_.begin(), lat_offset_.end(), g) - lat_offset_.begin()) - 1;
+        const int p = static_cast<int>(
+                          std::upper_bound(jlat_begin_.begin(), jlat_begin_.begin() + nb_parts_, jlat) -
+                          jlat_begin_.begin()) -
+                      1;
+        requests[p].emplace_back(g);
+        positions[p].emplace_back(static_cast<idx_t>(i));
+    }
+
+    recv_counts_.assign(nb_parts_, 0);
+    recv_displs_.assign(nb_parts_, 0);
+    recv_index_.clear();
+    recv_index_.reserve(points.size());
+    std::vector<gidx_t> request_buffer;
+    request_buffer.reserve(points.size());
+    for (int p = 0; p < nb_parts_; ++p) {
+        recv_counts_[p] = static_cast<int>(requests[p].size());
+        recv_displs_[p] = p ? recv_displs_[p - 1] + recv_counts_[p - 1] : 0;
+        request_buffer.insert(request_buffer.end(), requests[p].begin(), requests[p].end());
+        recv_index_.insert(recv_index_.end(), positions[p].begin(), positions[p].end());
+    }
+
+    send_counts_.assign(nb_parts_, 0);
+    send_displs_.assign(nb_parts_, 0);
+    comm_.allToAll(recv_counts_, send_counts_);
+    for (int p = 1; p < nb_parts_; ++p) {
+        send_displs_[p] = send_displs_[p - 1] + send_counts_[p - 1];
+    }
+    std::vector<gidx_t> requested(send_displs_.back() + send_counts_.back());
+    comm_.allToAllv(request_buffer.data(), recv_counts_.data(), recv_displs_.data(), requested.data(),
+                    send_counts_.data(), send_displs_.data());
+
+    const gidx_t band_begin = lat_offset_[jlat_begin()];
+    const gidx_t band_end   = lat_offset_[jlat_end()];
+    send_index_.resize(requested.size());
+    for (size_t i = 0; i < requested.size(); ++i) {
+        ATLAS_ASSERT(requested[i] >= band_begin && requested[i] < band_end);
+        send_index_[i] = static_cast<idx_t>(requested[i] - band_begin);
+    }
+
+    nb_gridpoints_  = static_cast<idx_t>(points.size());
+    has_gridpoints_ = true;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename Value>
+void TransLocalDistribution::exchange_gridpoints(int nb_fields, const Value band[], double gridpoints[]) const {
+    ATLAS_TRACE("TransLocal: exchange grid points");
+    ATLAS_ASSERT(has_gridpoints_);
+    const idx_t band_size = nb_band_points();
+
+    std::vector<int> send_counts(nb_parts_);
+    std::vector<int> send_displs(nb_parts_);
+    std::vector<int> recv_counts(nb_parts_);
+    std::vector<int> recv_displs(nb_parts_);
+    for (int p = 0; p < nb_parts_; ++p) {
+        send_counts[p] = nb_fields * send_counts_[p];
+        send_displs[p] = nb_fields * send_displs_[p];
+        recv_counts[p] = nb_fields * recv_counts_[p];
+        recv_displs[p] = nb_fields * recv_displs_[p];
+    }
+
+    std::vector<Value> send(nb_fields * send_index_.size());
+    std::vector<Value> recv(nb_fields * recv_index_.size());
+
+    size_t c = 0;
+    for (int p = 0; p < nb_parts_; ++p) {
+        for (int jfld = 0; jfld < nb_fields; ++jfld) {
+            const Value* field = band + size_t(jfld) * band_size;
+            for (int i = send_displs_[p]; i < send_displs_[p] + send_counts_[p]; ++i) {
+                send[c++] = field[send_index_[i]];
+            }
+        }
+    }
+
+    comm_.allToAllv(send.data(), send_counts.data(), send_displs.data(), recv.data(), recv_counts.data(),
+                    recv_displs.data());
+
+    c = 0;
+    for (int p = 0; p < nb_parts_; ++p) {
+        for (int jfld = 0; jfld < nb_fields; ++jfld) {
+            double* field = gridpoints + size_t(jfld) * nb_gridpoints_;
+            for (int i = recv_displs_[p]; i < recv_displs_[p] + recv_counts_[p]; ++i) {
+                field[recv_index_[i]] = recv[c++];
+            }
+        }
+    }
+}
+
+template void TransLocalDistribution::exchange_gridpoints<double>(int, const double[], double[]) const;
+template void TransLocalDistribution::exchange_gridpoints<float>(int, const float[], double[]) const;
+
+//-----------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace trans
+}  // namespace atlas
@@ -0,0 +1,147 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "atlas/grid/StructuredGrid.h"
+#include "atlas/library/config.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/Trace.h"
+
+namespace atlas {
+namespace trans {
+namespace detail {
+
+//-----------------------------------------------------------------------------
+
+/// @class TransLocalDistribution
+///
+/// Distribution of the work of TransLocal over MPI tasks, for global structured grids.
+///
+/// - Legendre transform: zonal wavenumbers are distributed in a "snake" order
+///   (0,1,..,P-1,P-1,..,1,0,0,1,..) which balances the number of coefficients per task.
+/// - Fourier transform: each task handles a contiguous band of latitudes, with a balanced number of grid points.
+/// - Grid points: values are exchanged from the latitude bands to any requested distribution of grid points,
+///   e.g. the one of a StructuredColumns function space.
+///
+/// Spectral coefficients are not distributed: every task holds all of them.
+class TransLocalDistribution {
+public:
+    TransLocalDistribution(const StructuredGrid&, int truncation, const mpi::Comm& = mpi::comm());
+
+    int nb_parts() const { return nb_parts_; }
+    int part() const { return part_; }
+
+    /// Zonal wavenumbers handled by given part in the Legendre transform
+    const std::vector<int>& zonal_wavenumbers(int part) const { return zonal_wavenumbers_[part]; }
+    bool owns_zonal_wavenumber(int m) const { return zonal_wavenumber_part_[m] == part_; }
+
+    /// Latitudes [jlat_begin,jlat_end) handled by given part in the Fourier transform
+    idx_t jlat_begin(int part) const { return jlat_begin_[part]; }
+    idx_t jlat_end(int part) const { return jlat_begin_[part + 1]; }
+    idx_t jlat_begin() const { return jlat_begin(part_); }
+    idx_t jlat_end() const { return jlat_end(part_); }
+
+    /// Number of grid points in the latitude band of this part
+    idx_t nb_band_points() const { return static_cast<idx_t>(lat_offset_[jlat_end()] - lat_offset_[jlat_begin()]); }
+
+    /// Set the grid points of this part, as 0-based global indices in the order of the output fields
+    void setup_gridpoints(const std::vector<gidx_t>& points);
+    bool has_gridpoints() const { return has_gridpoints_; }
+    idx_t nb_gridpoints() const { return nb_gridpoints_; }
+
+    /// Exchange fields from the layout of the latitude band to the grid points of this part
+    /// Both layouts store fields one after another. Values are communicated in the precision of the band.
+    template <typename Value>
+    void exchange_gridpoints(int nb_fields, const Value band[], double gridpoints[]) const;
+
+    /// Transpose Fourier coefficients in place, from the zonal wavenumbers of this part for all latitudes,
+    /// to all zonal wavenumbers for the latitude band of this part.
+    /// @param position  returns the index in scl_fourier of (jfld, imag, jlat, jm)
+    template <typename Value, typename Position>
+    void transpose_fourier(int nb_fields, Value scl_fourier[], const Position& position) const;
+
+private:
+    const mpi::Comm& comm_;
+    int nb_parts_;
+    int part_;
+    std::vector<std::vector<int>> zonal_wavenumbers_;
+    std::vector<int> zonal_wavenumber_part_;
+    std::vector<idx_t> jlat_begin_;  // size nb_parts+1
+    std::vector<gidx_t> lat_offset_;  // global index of first point of each latitude, size ny+1
+
+    bool has_gridpoints_{false};
+    idx_t nb_gridpoints_{0};
+    std::vector<int> send_counts_;
+    std::vector<int> send_displs_;
+    std::vector<int> recv_counts_;
+    std::vector<int> recv_displs_;
+    std::vector<idx_t> send_index_;  // offset in latitude band, grouped by destination
+    std::vector<idx_t> recv_index_;  // offset in grid points, grouped by source
+};
+
+//-----------------------------------------------------------------------------
+
+template <typename Value, typename Position>
+void TransLocalDistribution::transpose_fourier(int nb_fields, Value scl_fourier[], const Position& position) const {
+    ATLAS_TRACE("TransLocal: transpose Fourier coefficients");
+    std::vector<int> send_counts(nb_parts_);
+    std::vector<int> recv_counts(nb_parts_);
+    std::vector<int> send_displs(nb_parts_, 0);
+    std::vector<int> recv_displs(nb_parts_, 0);
+    const auto& my_wavenumbers = zonal_wavenumbers(part_);
+    for (int p = 0; p < nb_parts_; ++p) {
+        send_counts[p] = 2 * nb_fields * static_cast<int>(my_wavenumbers.size()) * (jlat_end(p) - jlat_begin(p));
+        recv_counts[p] = 2 * nb_fields * static_cast<int>(zonal_wavenumbers(p).size()) * (jlat_end() - jlat_begin());
+        if (p > 0) {
+            send_displs[p] = send_displs[p - 1] + send_counts[p - 1];
+            recv_displs[p] = recv_displs[p - 1] + recv_counts[p - 1];
+        }
+    }
+    std::vector<Value> send(send_displs.back() + send_counts.back());
+    std::vector<Value> recv(recv_displs.back() + recv_counts.back());
+
+    size_t c = 0;
+    for (int p = 0; p < nb_parts_; ++p) {
+        for (int jm : my_wavenumbers) {
+            for (idx_t jlat = jlat_begin(p); jlat < jlat_end(p); ++jlat) {
+                for (int imag = 0; imag < 2; ++imag) {
+                    for (int jfld = 0; jfld < nb_fields; ++jfld) {
+                        send[c++] = scl_fourier[position(jfld, imag, jlat, jm)];
+                    }
+                }
+            }
+        }
+    }
+
+    comm_.allToAllv(send.data(), send_counts.data(), send_displs.data(), recv.data(), recv_counts.data(),
+                    recv_displs.data());
+
+    c = 0;
+    for (int p = 0; p < nb_parts_; ++p) {
+        for (int jm : zonal_wavenumbers(p)) {
+            for (idx_t jlat = jlat_begin(); jlat < jlat_end(); ++jlat) {
+                for (int imag = 0; imag < 2; ++imag) {
+                    for (int jfld = 0; jfld < nb_fields; ++jfld) {
+                        scl_fourier[position(jfld, imag, jlat, jm)] = recv[c++];
+                    }
+                }
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace trans
+}  // namespace atlas
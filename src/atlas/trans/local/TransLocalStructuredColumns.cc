@@ -0,0 +1,52 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/trans/local/TransLocalStructuredColumns.h"
+
+#include <vector>
+
+#include "atlas/array.h"
+#include "atlas/functionspace/Spectral.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/trans/detail/TransFactory.h"
+
+namespace atlas {
+namespace trans {
+
+TransLocalStructuredColumns::TransLocalStructuredColumns(const functionspace::StructuredColumns& gp,
+                                                         const functionspace::Spectral& sp,
+                                                         const eckit::Configuration& config):
+    TransLocalStructuredColumns(Cache(), gp, sp, config) {}
+
+namespace {
+std::vector<gidx_t> owned_gridpoints(const functionspace::StructuredColumns& gp) {
+    const auto global_index = array::make_view<gidx_t, 1>(gp.global_index());
+    std::vector<gidx_t> points(gp.sizeOwned());
+    for (idx_t n = 0; n < gp.sizeOwned(); ++n) {
+        points[n] = global_index(n) - 1;
+    }
+    return points;
+}
+}  // namespace
+
+TransLocalStructuredColumns::TransLocalStructuredColumns(const Cache& cache,
+                                                         const functionspace::StructuredColumns& gp,
+                                                         const functionspace::Spectral& sp,
+                                                         const eckit::Configuration& config):
+    TransLocal(cache, gp.grid(), sp.truncation(), owned_gridpoints(gp), config) {}
+
+TransLocalStructuredColumns::~TransLocalStructuredColumns() = default;
+
+namespace {
+static TransBuilderFunctionSpace<TransLocalStructuredColumns> builder("local(StructuredColumns,Spectral)", "local");
+}  // namespace
+
+}  // namespace trans
+}  // namespace atlas
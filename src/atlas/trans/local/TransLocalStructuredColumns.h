@@ -0,0 +1,51 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include "atlas/trans/local/TransLocal.h"
+
+//-----------------------------------------------------------------------------
+// Forward declarations
+
+namespace atlas {
+namespace functionspace {
+class StructuredColumns;
+class Spectral;
+}  // namespace functionspace
+}  // namespace atlas
+
+//-----------------------------------------------------------------------------
+
+namespace atlas {
+namespace trans {
+
+//-----------------------------------------------------------------------------
+
+/// @class TransLocalStructuredColumns
+///
+/// TransLocal with grid point fields distributed as the given StructuredColumns function space,
+/// e.g. partitioned with the TransPartitioner or any other partitioner.
+/// Only the owned points (without halo) of the grid point fields are computed.
+class TransLocalStructuredColumns : public trans::TransLocal {
+public:
+    TransLocalStructuredColumns(const functionspace::StructuredColumns&, const functionspace::Spectral&,
+                                const eckit::Configuration& = util::Config());
+
+    TransLocalStructuredColumns(const Cache&, const functionspace::StructuredColumns&, const functionspace::Spectral&,
+                                const eckit::Configuration& = util::Config());
+
+    virtual ~TransLocalStructuredColumns();
+};
+
+//-----------------------------------------------------------------------------
+
+}  // namespace trans
+}  // namespace atlas
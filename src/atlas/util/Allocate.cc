@@ -63,6 +63,20 @@ void deallocate_host(void* ptr, size_t /*bytes*/) {
     free(ptr);
 }
 
+void allocate_pinned(void** ptr, size_t bytes) {
+    allocate_host(ptr, bytes);
+    if constexpr (ATLAS_HAVE_GPU) {
+        HIC_CALL(hicHostRegister(*ptr, bytes, hicHostRegisterMapped));
+    }
+}
+
+void deallocate_pinned(void* ptr, size_t bytes) {
+    if constexpr (ATLAS_HAVE_GPU) {
+        HIC_CALL(hicHostUnregister(ptr));
+    }
+    deallocate_host(ptr, bytes);
+}
+
 //------------------------------------------------------------------------------
 }  // namespace detail
 //------------------------------------------------------------------------------
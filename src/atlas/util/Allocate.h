@@ -27,6 +27,9 @@ void deallocate_device(void* ptr, size_t bytes);
 void allocate_host(void** ptr, size_t bytes);
 void deallocate_host(void* ptr, size_t bytes);
 
+void allocate_pinned(void** ptr, size_t bytes);
+void deallocate_pinned(void* ptr, size_t bytes);
+
 }  // namespace detail
 
 template <typename T>
@@ -74,6 +77,20 @@ void delete_hostmem(T*& data, size_t N) {
     }
 }
 
+template <typename T>
+void allocate_pinnedmem(T*& data, size_t N) {
+    if (N != 0) {
+        detail::allocate_pinned(reinterpret_cast<void**>(&data), N * sizeof(T));
+    }
+}
+
+template <typename T>
+void delete_pinnedmem(T*& data, size_t N) {
+    if (data) {
+        detail::deallocate_pinned(data, N * sizeof(T));
+        data = nullptr;
+    }
+}
 
 //------------------------------------------------------------------------------
 
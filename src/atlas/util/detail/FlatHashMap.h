@@ -0,0 +1,173 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace atlas {
+namespace util {
+namespace detail {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Hash for integral keys, mixing all bits of the key (splitmix64 finalizer).
+/// Keys with structure in their low bits, such as uids from util::unique_lonlat, are spread evenly over the
+/// power-of-two sized tables of FlatHashMap.
+struct IntegerHash {
+    size_t operator()(uint64_t x) const {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return static_cast<size_t>(x);
+    }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// @brief Open-addressing hash map with linear probing, for lookups of small keys such as uids or indices
+///
+/// All entries are stored in a single contiguous table, so that inserting does not allocate per entry.
+/// Clearing keeps the allocated table, so that a map that is cleared and refilled repeatedly, e.g. once
+/// for each halo level, only allocates when it needs to grow.
+/// Entries cannot be erased individually.
+template <typename Key, typename Value, typename Hash = IntegerHash>
+class FlatHashMap {
+public:
+    using key_type    = Key;
+    using mapped_type = Value;
+
+    FlatHashMap() = default;
+    explicit FlatHashMap(size_t size) { reserve(size); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /// Remove all entries, but keep the allocated table
+    void clear() {
+        std::fill(used_.begin(), used_.end(), 0);
+        size_ = 0;
+    }
+
+    /// Make room for given number of entries without further allocation
+    void reserve(size_t size) {
+        if (2 * size > capacity()) {
+            rehash(table_size(size));
+        }
+    }
+
+    /// Insert given value for given key, unless the key is already present.
+    /// Returns pointer to the value of the key, and whether the value was inserted
+    std::pair<Value*, bool> insert(const Key& key, const Value& value) {
+        reserve(size_ + 1);
+        size_t i = probe(key);
+        if (used_[i]) {
+            return {&entries_[i].second, false};
+        }
+        used_[i]    = 1;
+        entries_[i] = {key, value};
+        ++size_;
+        return {&entries_[i].second, true};
+    }
+
+    /// Access the value of given key, inserting a value-initialised value if the key is not present
+    Value& operator[](const Key& key) { return *insert(key, Value()).first; }
+
+    /// Pointer to the value of given key, or nullptr if the key is not present
+    Value* find(const Key& key) {
+        if (size_ == 0) {
+            return nullptr;
+        }
+        size_t i = probe(key);
+        return used_[i] ? &entries_[i].second : nullptr;
+    }
+
+    const Value* find(const Key& key) const { return const_cast<FlatHashMap*>(this)->find(key); }
+
+    bool contains(const Key& key) const { return find(key) != nullptr; }
+
+private:
+    size_t capacity() const { return entries_.size(); }
+
+    // Smallest power of two that keeps the load factor at most 1/2
+    static size_t table_size(size_t size) {
+        size_t n = 16;
+        while (n < 2 * size) {
+            n *= 2;
+        }
+        return n;
+    }
+
+    // Index of the slot holding given key, or of the empty slot where it would be inserted
+    size_t probe(const Key& key) const {
+        const size_t mask = capacity() - 1;
+        size_t i          = Hash()(static_cast<uint64_t>(key)) & mask;
+        while (used_[i] && not(entries_[i].first == key)) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void rehash(size_t new_capacity) {
+        std::vector<std::pair<Key, Value>> entries(new_capacity);
+        std::vector<uint8_t> used(new_capacity, 0);
+        entries_.swap(entries);
+        used_.swap(used);
+        for (size_t j = 0; j < used.size(); ++j) {
+            if (used[j]) {
+                size_t i    = probe(entries[j].first);
+                used_[i]    = 1;
+                entries_[i] = std::move(entries[j]);
+            }
+        }
+    }
+
+private:
+    std::vector<std::pair<Key, Value>> entries_;
+    std::vector<uint8_t> used_;
+    size_t size_{0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// @brief Open-addressing hash set, see FlatHashMap
+template <typename Key, typename Hash = IntegerHash>
+class FlatHashSet {
+public:
+    using key_type = Key;
+
+    FlatHashSet() = default;
+    explicit FlatHashSet(size_t size): map_(size) {}
+
+    size_t size() const { return map_.size(); }
+    bool empty() const { return map_.empty(); }
+    void clear() { map_.clear(); }
+    void reserve(size_t size) { map_.reserve(size); }
+
+    /// Insert given key, and return whether it was not yet present
+    bool insert(const Key& key) { return map_.insert(key, true).second; }
+
+    bool contains(const Key& key) const { return map_.contains(key); }
+
+private:
+    FlatHashMap<Key, bool, Hash> map_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace util
+}  // namespace atlas
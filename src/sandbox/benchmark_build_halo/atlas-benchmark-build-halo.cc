@@ -0,0 +1,108 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+// Benchmark of BuildHalo, for increasing halo sizes.
+//
+// Example, to compare timings across MPI task counts:
+//     for n in 8 16 32 64; do mpirun -np $n atlas-benchmark-build-halo --grid=O1280 --halo=3; done
+
+#include <algorithm>
+#include <iomanip>
+#include <string>
+
+#include "atlas/grid.h"
+#include "atlas/mesh.h"
+#include "atlas/mesh/actions/BuildHalo.h"
+#include "atlas/meshgenerator.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+
+//------------------------------------------------------------------------------
+
+using namespace atlas;
+
+//------------------------------------------------------------------------------
+
+class Tool : public AtlasTool {
+    int execute(const Args& args) override;
+    std::string briefDescription() override { return "Benchmark of building mesh halos of increasing size"; }
+    std::string usage() override { return name() + " [--grid=name] [--halo=N] [--iterations=N] [--help]"; }
+
+public:
+    Tool(int argc, char** argv);
+};
+
+//-----------------------------------------------------------------------------
+
+Tool::Tool(int argc, char** argv): AtlasTool(argc, argv) {
+    add_option(new SimpleOption<std::string>(
+        "grid", "Grid unique identifier (default=O1280)\n" + indent() + "     Example values: N80, F40, O24, L32"));
+    add_option(new SimpleOption<long>("halo", "Largest halo size to benchmark, starting at 1 (default=3)"));
+    add_option(new SimpleOption<long>("iterations", "Number of iterations per halo size (default=1)"));
+}
+
+//-----------------------------------------------------------------------------
+
+int Tool::execute(const Args& args) {
+    std::string gridname = args.getString("grid", "O1280");
+    long max_halo        = args.getLong("halo", 3);
+    long iterations      = args.getLong("iterations", 1);
+
+    Grid grid(gridname);
+
+    Log::info() << "Configuration" << std::endl;
+    Log::info() << "~~~~~~~~~~~~~" << std::endl;
+    Log::info() << "  Grid       : " << grid.name() << std::endl;
+    Log::info() << "  Halo       : 1.." << max_halo << std::endl;
+    Log::info() << "  Iterations : " << iterations << std::endl;
+    Log::info() << "  MPI        : " << mpi::comm().size() << std::endl;
+    Log::info() << "  OpenMP     : " << atlas_omp_get_max_threads() << std::endl;
+
+    MeshGenerator meshgenerator("structured", util::Config("partitioner", "equal_regions"));
+
+    Log::info() << std::endl;
+    Log::info() << std::setw(6) << "halo" << std::setw(16) << "min [s]" << std::setw(16) << "max [s]" << std::endl;
+
+    for (long halo = 1; halo <= max_halo; ++halo) {
+        double min_time = 0.;
+        double max_time = 0.;
+        for (long i = 0; i < iterations; ++i) {
+            Mesh mesh = meshgenerator.generate(grid);
+            mpi::comm().barrier();
+
+            // Time on the slowest task, as BuildHalo is collective
+            Trace timer(Here(), "halo " + std::to_string(halo));
+            mesh::actions::build_halo(mesh, halo);
+            mpi::comm().barrier();
+            timer.stop();
+
+            double time = timer.elapsed();
+            mpi::comm().allReduceInPlace(time, eckit::mpi::max());
+            min_time = (i == 0) ? time : std::min(min_time, time);
+            max_time = std::max(max_time, time);
+        }
+        Log::info() << std::setw(6) << halo << std::fixed << std::setprecision(3) << std::setw(16) << min_time
+                    << std::setw(16) << max_time << std::endl;
+    }
+
+    Log::info() << std::endl << Trace::report() << std::endl;
+    return success();
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    Tool tool(argc, argv);
+    return tool.start();
+}
@@ -6,6 +6,7 @@
  */
 
 
+#include <cmath>
 #include <string>
 
 #include "atlas/array.h"
@@ -280,6 +281,52 @@ CASE("dot-product test for the rigridding from high to low resolution; grid type
 }
 
 
+/// test to check that the rigridding from 'high' to 'low' resolution
+/// with "compact_matrix" gives the result of the double precision matrix,
+/// to single precision
+///
+CASE("rigridding from high to low resolution with compact matrix; grid type: O") {
+
+  // source grid (high res.)
+  auto ncgrid_s = Grid("O32");
+  auto ncfs_s = functionspace::StructuredColumns(ncgrid_s, option::halo(3));
+
+  // target grid (low res.)
+  auto ncgrid_t = Grid("O16");
+  auto ncfs_t = functionspace::StructuredColumns(ncgrid_t, option::halo(3));
+
+  size_t nb_levels = 1;
+
+  auto field_01_s = getVortexField(ncfs_s, "field_01_s", nb_levels);
+  auto field_01_t = ncfs_t.createField<double>(option::name("field_01_t") |
+                                               option::levels(nb_levels));
+  auto field_01_c = ncfs_t.createField<double>(option::name("field_01_c") |
+                                               option::levels(nb_levels));
+
+  const auto scheme = util::Config("type", "binning") |
+                      util::Config("scheme", option::type("structured-bilinear"));
+
+  // "compact_matrix" is also requested for the ancillary scheme, which
+  // must nevertheless be set up with double precision weights
+  const auto scheme_compact = util::Config("type", "binning") |
+                              util::Config("compact_matrix", true) |
+                              util::Config("scheme", option::type("structured-bilinear") |
+                                                     util::Config("compact_matrix", true));
+
+  Interpolation(scheme, ncfs_s, ncfs_t).execute(field_01_s, field_01_t);
+
+  Interpolation regrid_compact(scheme_compact, ncfs_s, ncfs_t);
+  EXPECT(interpolation::MatrixCache(interpolation::Cache(regrid_compact)).compact());
+  regrid_compact.execute(field_01_s, field_01_c);
+
+  const auto view_t = array::make_view<double, 2>(field_01_t);
+  const auto view_c = array::make_view<double, 2>(field_01_c);
+  for (idx_t i = 0; i < ncfs_t.sizeOwned(); ++i) {
+    EXPECT_APPROX_EQ(view_c(i, 0), view_t(i, 0), 1.e-5 * std::abs(view_t(i, 0)));
+  }
+}
+
+
 }  // namespace test
 }  // namespace atlas
 
@@ -8,7 +8,10 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <sstream>
+#include <string>
 
 #include "eckit/types/FloatCompare.h"
 
@@ -19,6 +22,8 @@
 #include "atlas/interpolation.h"
 #include "atlas/mesh.h"
 #include "atlas/meshgenerator.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/util/CoordinateEnums.h"
 
 #include "tests/AtlasTestEnvironment.h"
@@ -78,6 +83,147 @@ CASE("test_interpolation_finite_element") {
     }
 }
 
+CASE("test_interpolation_finite_element fieldset equals per field") {
+    Grid grid("O32");
+    Mesh mesh(grid);
+    NodeColumns fs(mesh);
+    PointCloud pointcloud({{05., 10.}, {15., -20.}, {125., 30.}, {240., -45.}, {300., 60.}, {355., 0.}});
+
+    auto lonlat = array::make_view<double, 2>(fs.nodes().lonlat());
+
+    // Fields of different rank and data type, which are interpolated together per data type
+    auto create_source = [&]() {
+        FieldSet fields;
+        fields.add(fs.createField<double>(option::name("r1")));
+        fields.add(fs.createField<double>(option::name("r2") | option::levels(4)));
+        fields.add(fs.createField<double>(option::name("r3") | option::levels(3) | option::variables(2)));
+        fields.add(fs.createField<float>(option::name("f1")));
+        fields.add(fs.createField<float>(option::name("f2") | option::levels(5)));
+        for (auto& field : fields) {
+            const idx_t var = field.rank() == 1 ? 1 : field.stride(0);
+            for (idx_t j = 0; j < fs.nodes().size(); ++j) {
+                for (idx_t k = 0; k < var; ++k) {
+                    const double value =
+                        std::sin((k + 1) * lonlat(j, LON) * M_PI / 180.) * std::cos(lonlat(j, LAT) * M_PI / 180.);
+                    if (field.datatype().kind() == array::DataType::KIND_REAL64) {
+                        field.array().host_data<double>()[j * var + k] = value;
+                    }
+                    else {
+                        field.array().host_data<float>()[j * var + k] = static_cast<float>(value);
+                    }
+                }
+            }
+        }
+        return fields;
+    };
+    auto create_target = [&]() {
+        const idx_t size = pointcloud.size();
+        FieldSet fields;
+        fields.add(Field("r1", array::make_datatype<double>(), array::make_shape(size)));
+        fields.add(Field("r2", array::make_datatype<double>(), array::make_shape(size, 4)));
+        fields.add(Field("r3", array::make_datatype<double>(), array::make_shape(size, 3, 2)));
+        fields.add(Field("f1", array::make_datatype<float>(), array::make_shape(size)));
+        fields.add(Field("f2", array::make_datatype<float>(), array::make_shape(size, 5)));
+        return fields;
+    };
+
+    for (std::string backend : {"openmp", "openmp_blocked"}) {
+        SECTION(backend) {
+            auto config = option::type("finite-element") | util::Config("sparse_matrix_multiply", backend);
+            Interpolation interpolation(config, fs, pointcloud);
+
+            FieldSet source          = create_source();
+            FieldSet target_fieldset = create_target();
+            FieldSet target_field    = create_target();
+
+            interpolation.execute(source, target_fieldset);
+            for (idx_t i = 0; i < source.size(); ++i) {
+                interpolation.execute(source[i], target_field[i]);
+            }
+
+            for (idx_t i = 0; i < source.size(); ++i) {
+                const Field& a    = target_fieldset[i];
+                const Field& b    = target_field[i];
+                const bool real64 = a.datatype().kind() == array::DataType::KIND_REAL64;
+                EXPECT_EQ(a.size(), b.size());
+                for (idx_t j = 0; j < a.size(); ++j) {
+                    const double va = real64 ? a.array().host_data<double>()[j] : a.array().host_data<float>()[j];
+                    const double vb = real64 ? b.array().host_data<double>()[j] : b.array().host_data<float>()[j];
+                    EXPECT(eckit::types::is_approximately_equal(va, vb, 1.e-6));
+                }
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_interpolation_finite_element matrix does not depend on number of threads") {
+    Grid grid("O32");
+    Mesh mesh(grid);
+    NodeColumns fs(mesh);
+    PointCloud pointcloud(Grid("O24"));
+
+    const int max_threads = atlas_omp_get_max_threads();
+    auto create_matrix    = [&](int nb_threads) {
+        atlas_omp_set_num_threads(nb_threads);
+        Interpolation interpolation(option::type("finite-element"), fs, pointcloud);
+        atlas_omp_set_num_threads(max_threads);
+        return interpolation::MatrixCache(interpolation);
+    };
+
+    auto serial   = create_matrix(1);
+    auto threaded = create_matrix(std::max(max_threads, 4));
+
+    const auto& a = serial.matrix();
+    const auto& b = threaded.matrix();
+    EXPECT_EQ(a.rows(), b.rows());
+    EXPECT_EQ(a.cols(), b.cols());
+    EXPECT_EQ(a.nonZeros(), b.nonZeros());
+    for (size_t r = 0; r <= a.rows(); ++r) {
+        EXPECT_EQ(a.outer()[r], b.outer()[r]);
+    }
+    for (size_t i = 0; i < a.nonZeros(); ++i) {
+        EXPECT_EQ(a.inner()[i], b.inner()[i]);
+        EXPECT_EQ(a.data()[i], b.data()[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_interpolation_finite_element print stencils of compact matrix") {
+    Mesh source_mesh(Grid("O16"));
+    Mesh target_mesh(Grid("O8"), grid::MatchingPartitioner(source_mesh));
+    NodeColumns source(source_mesh);
+    NodeColumns target(target_mesh);
+
+    auto print = [&](bool compact) {
+        Interpolation interpolation(option::type("finite-element") | util::Config("compact_matrix", compact), source,
+                                    target);
+        std::stringstream out;
+        interpolation.print(out);
+        return out.str();
+    };
+    std::stringstream expected(print(false));
+    std::stringstream printed(print(true));
+
+    // Each stencil line holds the target index and the global indices of up to 4 source points, then the
+    // weights, which differ in single precision
+    const size_t points_width = 13 + 4 * 10;
+    std::string expected_line, printed_line;
+    size_t nb_stencils = 0;
+    while (std::getline(expected, expected_line)) {
+        EXPECT(std::getline(printed, printed_line));
+        if (expected_line.find(" : ") == 10) {
+            EXPECT_EQ(printed_line.substr(0, points_width), expected_line.substr(0, points_width));
+            ++nb_stencils;
+        }
+    }
+    if (mpi::comm().rank() == 0) {
+        EXPECT(nb_stencils > 0);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -9,6 +9,9 @@
  */
 
 #include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <vector>
 
 #include "eckit/log/Bytes.h"
 
@@ -17,6 +20,7 @@
 #include "atlas/functionspace/PointCloud.h"
 #include "atlas/grid.h"
 #include "atlas/interpolation.h"
+#include "atlas/interpolation/MatrixCacheFile.h"
 #include "atlas/linalg/sparse.h"
 #include "atlas/mesh.h"
 #include "atlas/meshgenerator.h"
@@ -170,6 +174,99 @@ CASE("extract cache, copy it, and pass non-owning pointer") {
 
 //-----------------------------------------------------------------------------
 
+CASE("write cache to file and map it for use") {
+    Grid grid_source("F32");
+    Grid grid_target("F16");
+
+    Field field_source("source", array::make_datatype<double>(), array::make_shape(grid_source.size()));
+    Field field_target("target", array::make_datatype<double>(), array::make_shape(grid_target.size()));
+
+    set_field(field_source, grid_source, func);
+
+    eckit::PathName path("atlas_test_interpolation_finite_element_cached.matrix");
+    std::string key = interpolation::MatrixCacheFile::key(grid_source, grid_target, option::type("finite-element"));
+
+    interpolation::MatrixCacheFile::write(path, get_or_create_cache(grid_source, grid_target), key);
+
+    EXPECT_THROWS(interpolation::MatrixCacheFile::read(path, "wrong key"));
+
+    ATLAS_TRACE_SCOPE("Interpolate with mapped cache") {
+        auto cache = interpolation::MatrixCacheFile::read(path, key);
+        EXPECT(cache.compact());
+        EXPECT(not cache.compact_matrix().owns_data());
+        EXPECT_EQ(cache.compact_matrix().rows(), static_cast<std::size_t>(grid_target.size()));
+        EXPECT_EQ(cache.compact_matrix().cols(), static_cast<std::size_t>(grid_source.size()));
+
+        Interpolation interpolation_using_cache(option::type("finite-element"), grid_source, grid_target, cache);
+        interpolation_using_cache.execute(field_source, field_target);
+    }
+
+    check_field(field_target, grid_target, func, 1.e-4);
+
+    path.unlink();
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("reject corrupt cache file") {
+    Grid grid_source("F32");
+    Grid grid_target("F16");
+
+    eckit::PathName path("atlas_test_interpolation_finite_element_cached_corrupt.matrix");
+    interpolation::MatrixCacheFile::write(path, get_or_create_cache(grid_source, grid_target));
+    EXPECT(interpolation::MatrixCacheFile::read(path).compact());
+
+    // header: magic[8], 4 x uint32, then rows, cols, nnz, outer_offset, inner_offset, ...
+    auto header_field = [&](std::fstream& file, int i) {
+        std::uint64_t value;
+        file.seekg(8 + 4 * 4 + 8 * i);
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    };
+    auto overwrite_first_index = [&](int array_offset_field, std::int32_t index) {
+        std::fstream file(path.asString(), std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(header_field(file, array_offset_field));
+        file.write(reinterpret_cast<const char*>(&index), sizeof(index));
+    };
+
+    SECTION("inner index out of range") {
+        overwrite_first_index(4, static_cast<std::int32_t>(grid_source.size()));
+        EXPECT_THROWS(interpolation::MatrixCacheFile::read(path, "", true));
+    }
+    SECTION("outer offsets out of range") {
+        overwrite_first_index(3, -1);
+        EXPECT_THROWS(interpolation::MatrixCacheFile::read(path, "", true));
+    }
+    SECTION("corrupt header") {
+        std::fstream file(path.asString(), std::ios::in | std::ios::out | std::ios::binary);
+        const std::uint64_t cols = header_field(file, 1) + 1;
+        file.seekp(8 + 4 * 4 + 8 * 1);
+        file.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
+        file.close();
+        EXPECT_THROWS(interpolation::MatrixCacheFile::read(path));
+    }
+
+    path.unlink();
+}
+
+CASE("reject lossy single precision conversion") {
+    eckit::PathName path("atlas_test_interpolation_finite_element_cached_lossy.matrix");
+
+    // 0.1 is not exactly representable in single precision
+    std::vector<eckit::linalg::Triplet> triplets{{0, 0, 0.1}, {0, 1, 0.9}, {1, 1, 1.}};
+    interpolation::MatrixCache cache(interpolation::MatrixCache::Matrix(2, 2, triplets));
+
+    EXPECT_THROWS(interpolation::MatrixCacheFile::write(path, cache, "", 0.));
+    EXPECT(not path.exists());
+
+    interpolation::MatrixCacheFile::write(path, cache);
+    EXPECT(interpolation::MatrixCacheFile::read(path).compact());
+
+    path.unlink();
+}
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
@@ -249,6 +249,45 @@ CASE("test_interpolation_grid_box_average matrix with cache") {
     ATLAS_TRACE_SCOPE("Interpolate with cache") { Interpolation(config, gridA, gridB, cache).execute(fieldA, fieldB); }
 }
 
+CASE("test_interpolation_grid_box_maximum with compact matrix") {
+    Grid gridA("O32");
+    Grid gridB("O16");
+
+    auto config         = option::type("grid-box-maximum").set("matrix_free", false);
+    auto config_compact = option::type("grid-box-maximum").set("matrix_free", false).set("compact_matrix", true);
+
+    Field fieldA(create_field("A", gridA.size()));
+    Field fieldB(create_field("B", gridB.size()));
+    Field fieldB_compact(create_field("B_compact", gridB.size()));
+
+    auto values = array::make_view<double, 1>(fieldA);
+    for (idx_t i = 0; i < values.size(); ++i) {
+        values(i) = std::sin(double(i));
+    }
+
+    Interpolation(config, gridA, gridB).execute(fieldA, fieldB);
+
+    interpolation::Cache cache;
+    SECTION("setup") {
+        Interpolation interpolation(config_compact, gridA, gridB);
+        interpolation.execute(fieldA, fieldB_compact);
+        cache = interpolation::Cache(interpolation);
+        EXPECT(interpolation::MatrixCache(cache));
+        EXPECT(interpolation::MatrixCache(cache).compact());
+    }
+    SECTION("cache") {
+        cache = interpolation::Cache(Interpolation(config_compact, gridA, gridB));
+        Interpolation(config, gridA, gridB, cache).execute(fieldA, fieldB_compact);
+    }
+
+    // the maximum only depends on the sparsity pattern, so the result is identical
+    auto b         = array::make_view<double, 1>(fieldB);
+    auto b_compact = array::make_view<double, 1>(fieldB_compact);
+    for (idx_t i = 0; i < b.size(); ++i) {
+        EXPECT_EQ(b(i), b_compact(i));
+    }
+}
+
 }  // namespace test
 }  // namespace atlas
 
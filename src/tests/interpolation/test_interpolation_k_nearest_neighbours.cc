@@ -110,6 +110,22 @@ CASE("test_multiple_fs") {
     interpolation12.execute(f1, f2);
 }
 
+//-----------------------------------------------------------------------------
+
+CASE("test_sort_queries") {
+    Grid gridA("O32");
+    Grid gridB("O64");
+
+    for (std::string type : {"k-nearest-neighbours", "nearest-neighbour"}) {
+        SECTION(type) {
+            auto config = option::type(type) | Config("k-nearest-neighbours", 4) | Config("batch_size", 100);
+            Interpolation natural(config, gridA, gridB);
+            Interpolation sorted(config | Config("sort_queries", true), gridA, gridB);
+            EXPECT_EQ(Access{natural}.hash(), Access{sorted}.hash());
+        }
+    }
+}
+
 }  // namespace test
 }  // namespace atlas
 
@@ -135,6 +135,65 @@ CASE("matrix matrix multiply (gemm)") {
     }
 }
 
+CASE("matrix matrix multiply (gemm) in single precision") {
+    // column-major storage
+    std::vector<float> a{1.f, -4.f, -2.f, 2.f};
+    std::vector<float> z{9.f, -12.f, -6.f, 12.f};
+    MatrixFloat A(a.data(), 2, 2);
+
+    SECTION("bad sizes") {
+        std::vector<float> y(2, -42.f);
+        MatrixFloat Y(y.data(), 1, 2);
+        EXPECT_THROWS_AS(linalg::matrix_multiply(A, A, Y), eckit::AssertionFailed);
+    }
+
+    SECTION("unsupported backend") {
+        std::vector<float> y(4, -42.f);
+        MatrixFloat Y(y.data(), 2, 2);
+        EXPECT_THROWS_AS(linalg::matrix_multiply(A, A, Y, util::Config("type", "unsupported")),
+                         eckit::NotImplemented);
+    }
+
+    // "mkl" and "lapack" call cblas_sgemm when atlas is built with CBLAS, the others a generic implementation
+    std::vector<std::string> backends{"eckit_linalg", "generic", "openmp", "lapack", "mkl", "eigen"};
+    for (auto& backend : backends) {
+        if (dense::Backend{backend}.available()) {
+            SECTION(backend) {
+                std::vector<float> y(4, -42.f);
+                MatrixFloat Y(y.data(), 2, 2);
+                linalg::matrix_multiply(A, A, Y, dense::Backend{backend});
+                expect_equal(y.data(), z.data(), z.size());
+            }
+        }
+    }
+
+    SECTION("compare with double precision") {
+        const size_t m = 7, k = 300, n = 9;
+        Matrix Ad(m, k), Bd(k, n), Cd(m, n);
+        std::vector<float> af(m * k), bf(k * n), cf(m * n);
+        for (size_t i = 0; i < m * k; ++i) {
+            af[i]        = static_cast<float>(i % 13) / 13.f;
+            Ad.data()[i] = af[i];
+        }
+        for (size_t i = 0; i < k * n; ++i) {
+            bf[i]        = static_cast<float>(i % 7) / 7.f - 0.5f;
+            Bd.data()[i] = bf[i];
+        }
+        MatrixFloat Af(af.data(), m, k), Bf(bf.data(), k, n);
+        linalg::matrix_multiply(Ad, Bd, Cd);
+        for (auto& backend : backends) {
+            if (dense::Backend{backend}.available()) {
+                std::fill(cf.begin(), cf.end(), -42.f);
+                MatrixFloat Cf(cf.data(), m, n);
+                linalg::matrix_multiply(Af, Bf, Cf, dense::Backend{backend});
+                for (size_t i = 0; i < m * n; ++i) {
+                    EXPECT_APPROX_EQ(double(cf[i]), Cd.data()[i], 1.e-5 * k);
+                }
+            }
+        }
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace test
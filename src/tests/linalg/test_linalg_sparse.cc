@@ -8,6 +8,9 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <cmath>
+#include <functional>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -28,8 +31,9 @@ namespace test {
 //----------------------------------------------------------------------------------------------------------------------
 
 // strings to be used in the tests
-static std::string eckit_linalg = sparse::backend::eckit_linalg::type();
-static std::string openmp       = sparse::backend::openmp::type();
+static std::string eckit_linalg   = sparse::backend::eckit_linalg::type();
+static std::string openmp         = sparse::backend::openmp::type();
+static std::string openmp_blocked = sparse::backend::openmp_blocked::type();
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -208,7 +212,7 @@ CASE("sparse_matrix vector multiply (spmv)") {
     // y = 1 2 3
     SparseMatrix A{3, 3, {{0, 0, 2.}, {0, 2, -3.}, {1, 1, 2.}, {2, 2, 2.}}};
 
-    for (std::string backend : {openmp, eckit_linalg}) {
+    for (std::string backend : {openmp, openmp_blocked, eckit_linalg}) {
         sparse::current_backend(backend);
 
         SECTION("test_identity [backend=" + sparse::current_backend().type() + "]") {
@@ -272,7 +276,7 @@ CASE("sparse_matrix matrix multiply (spmm)") {
     Matrix m{{1., 2.}, {3., 4.}, {5., 6.}};
     Matrix c_exp{{-13., -14.}, {6., 8.}, {10., 12.}};
 
-    for (std::string backend : {openmp, eckit_linalg}) {
+    for (std::string backend : {openmp, openmp_blocked, eckit_linalg}) {
         sparse::current_backend(backend);
 
         SECTION("eckit::Matrix [backend=" + sparse::current_backend().type() + "]") {
@@ -330,6 +334,80 @@ CASE("sparse_matrix matrix multiply (spmm)") {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+CASE("sparse_matrix_multiply [backend=openmp_blocked] compared to [backend=openmp]") {
+    // Matrices with fixed (bilinear, bicubic) and variable number of non-zeros per row
+    auto make_matrix = [](idx_t rows, idx_t cols, std::function<idx_t(idx_t)> nnz) {
+        std::vector<eckit::linalg::Triplet> triplets;
+        for (idx_t r = 0; r < rows; ++r) {
+            for (idx_t j = 0; j < nnz(r); ++j) {
+                triplets.emplace_back(r, (7 * r + 3 * j) % cols, 1. / (1. + j + r % 5));
+            }
+        }
+        return SparseMatrix{static_cast<eckit::linalg::Size>(rows), static_cast<eckit::linalg::Size>(cols), triplets};
+    };
+    const idx_t rows   = 211;
+    const idx_t cols   = 157;
+    const idx_t levels = 13;
+    std::vector<std::pair<std::string, SparseMatrix>> matrices;
+    matrices.emplace_back("nnz=4", make_matrix(rows, cols, [](idx_t) { return 4; }));
+    matrices.emplace_back("nnz=16", make_matrix(rows, cols, [](idx_t) { return 16; }));
+    matrices.emplace_back("nnz=variable", make_matrix(rows, cols, [](idx_t r) { return r % 7; }));
+
+    for (auto& matrix : matrices) {
+        const auto& A = matrix.second;
+        for (auto& indexing : {Indexing::layout_left, Indexing::layout_right}) {
+            SECTION(matrix.first + (indexing == Indexing::layout_left ? " layout_left" : " layout_right")) {
+                const bool left = (indexing == Indexing::layout_left);
+                array::ArrayT<double> src(left ? cols : levels, left ? levels : cols);
+                array::ArrayT<double> tgt(left ? rows : levels, left ? levels : rows);
+                array::ArrayT<double> tgt_ref(left ? rows : levels, left ? levels : rows);
+                auto src_v = array::make_view<double, 2>(src);
+                for (idx_t i = 0; i < src_v.shape(0); ++i) {
+                    for (idx_t j = 0; j < src_v.shape(1); ++j) {
+                        src_v(i, j) = std::sin(0.1 * i) + 0.01 * j;
+                    }
+                }
+                auto tgt_v     = array::make_view<double, 2>(tgt);
+                auto tgt_ref_v = array::make_view<double, 2>(tgt_ref);
+                tgt_v.assign(-1.);
+                sparse_matrix_multiply(A, src_v, tgt_ref_v, indexing, sparse::backend::openmp());
+                sparse_matrix_multiply(A, src_v, tgt_v, indexing, sparse::backend::openmp_blocked());
+                expect_equal(tgt_v, tgt_ref_v);
+            }
+        }
+    }
+}
+
+CASE("sparse_matrix_multiply with CompactSparseMatrix") {
+    SparseMatrix A{3, 3, {{0, 0, 2.}, {0, 2, -3.}, {1, 1, 2.}, {2, 2, 2.}}};
+    CompactSparseMatrix B{A};
+    EXPECT_EQ(B.rows(), A.rows());
+    EXPECT_EQ(B.cols(), A.cols());
+    EXPECT_EQ(B.nonZeros(), A.nonZeros());
+    EXPECT(B.footprint() < A.footprint());
+    EXPECT_EQ(B.max_weight_error(), 0.);
+
+    Matrix m{{1., 2.}, {3., 4.}, {5., 6.}};
+    Matrix c_exp{{-13., -14.}, {6., 8.}, {10., 12.}};
+
+    for (std::string backend : {openmp, openmp_blocked, eckit_linalg}) {
+        SECTION("View of atlas::Array [backend=" + backend + "]") {
+            ArrayVector<double> x(Vector{1., 2., 3.});
+            ArrayVector<double> y(3);
+            sparse_matrix_multiply(B, x.view(), y.view(), sparse::Backend{backend});
+            expect_equal(y.view(), Vector{-7., 4., 6.});
+        }
+        SECTION("View of atlas::Array PointsRight [backend=" + backend + "]") {
+            ArrayMatrix<float, Indexing::layout_right> ma(m);
+            ArrayMatrix<float, Indexing::layout_right> c(3, 2);
+            sparse_matrix_multiply(B, ma.view(), c.view(), Indexing::layout_right, sparse::Backend{backend});
+            expect_equal(c.view(), ArrayMatrix<float, Indexing::layout_right>(c_exp).view());
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
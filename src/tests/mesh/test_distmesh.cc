@@ -9,7 +9,12 @@
  */
 
 #include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "eckit/types/FloatCompare.h"
 
@@ -29,6 +34,8 @@
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/CoordinateEnums.h"
+#include "atlas/util/MicroDeg.h"
+#include "atlas/util/Unique.h"
 
 #include "tests/AtlasTestEnvironment.h"
 #include "tests/TestMeshes.h"
@@ -129,6 +136,87 @@ CASE("test_distribute_t63") {
     }
     Log::info() << "]" << std::endl;
 }
+
+//-----------------------------------------------------------------------------
+
+CASE("test_edges_partition_invariants") {
+    // Partition boundary edges are exchanged only with partitions that can have them. Every copy of an edge,
+    // including periodic images, must name the same owner, and that owner must hold a copy of the edge.
+    auto build_mesh = [](const std::string& grid, const std::string& partitioner, int halo) {
+        StructuredMeshGenerator generate(util::Config("partitioner", partitioner));
+        Mesh mesh = generate(Grid(grid));
+        mesh::actions::build_parallel_fields(mesh);
+        mesh::actions::build_periodic_boundaries(mesh);
+        mesh::actions::build_halo(mesh, halo);
+        mesh::actions::build_edges(mesh);
+        mesh::actions::build_edges_parallel_fields(mesh);
+        return mesh;
+    };
+
+    // Identify an edge by its centroid, with longitude modulo 360 so that periodic images coincide
+    auto edge_key = [](const Mesh& mesh, idx_t jedge) -> gidx_t {
+        const auto lonlat     = array::make_view<double, 2>(mesh.nodes().lonlat());
+        const auto& edge_node = mesh.edges().node_connectivity();
+        const idx_t n1        = edge_node(jedge, 0);
+        const idx_t n2        = edge_node(jedge, 1);
+        constexpr int full    = 360000000;
+        int lon               = util::microdeg(0.5 * (lonlat(n1, LON) + lonlat(n2, LON)));
+        int lat               = util::microdeg(0.5 * (lonlat(n1, LAT) + lonlat(n2, LAT)));
+        lon                   = ((lon % full) + full) % full;
+        return util::unique_lonlat_microdeg(lon, lat);
+    };
+
+    const int mpi_size = mpi::size();
+    for (std::string grid : {"N16", "O32"}) {
+        for (std::string partitioner : {"equal_regions", "equal_bands"}) {
+            for (int halo : {1, 2}) {
+                SECTION(grid + " " + partitioner + " halo " + std::to_string(halo)) {
+                    Mesh mesh       = build_mesh(grid, partitioner, halo);
+                    const auto part = array::make_view<int, 1>(mesh.edges().partition());
+
+                    // Send every local edge to a rank determined by its key, together with its partition
+                    std::vector<std::vector<gidx_t>> send_key(mpi_size);
+                    std::vector<std::vector<int>> send_part(mpi_size);
+                    for (idx_t jedge = 0; jedge < mesh.edges().size(); ++jedge) {
+                        gidx_t key = edge_key(mesh, jedge);
+                        int dest   = static_cast<int>(static_cast<std::uint64_t>(key) % std::uint64_t(mpi_size));
+                        send_key[dest].push_back(key);
+                        send_part[dest].push_back(part(jedge));
+                    }
+                    std::vector<std::vector<gidx_t>> recv_key(mpi_size);
+                    std::vector<std::vector<int>> recv_part(mpi_size);
+                    mpi::comm().allToAll(send_key, recv_key);
+                    mpi::comm().allToAll(send_part, recv_part);
+
+                    std::map<gidx_t, std::set<int>> holders;
+                    std::map<gidx_t, std::set<int>> owners;
+                    for (int p = 0; p < mpi_size; ++p) {
+                        for (size_t j = 0; j < recv_key[p].size(); ++j) {
+                            holders[recv_key[p][j]].insert(p);
+                            owners[recv_key[p][j]].insert(recv_part[p][j]);
+                        }
+                    }
+
+                    idx_t nb_disagreeing = 0;
+                    idx_t nb_not_held    = 0;
+                    for (const auto& edge : owners) {
+                        if (edge.second.size() != 1) {
+                            ++nb_disagreeing;
+                        }
+                        else if (holders[edge.first].count(*edge.second.begin()) == 0) {
+                            ++nb_not_held;
+                        }
+                    }
+                    mpi::comm().allReduceInPlace(nb_disagreeing, eckit::mpi::sum());
+                    mpi::comm().allReduceInPlace(nb_not_held, eckit::mpi::sum());
+                    EXPECT_EQ(nb_disagreeing, 0);
+                    EXPECT_EQ(nb_not_held, 0);
+                }
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -8,14 +8,21 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <vector>
+
 #include "atlas/grid/Grid.h"
 #include "atlas/library/config.h"
 #include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/actions/BuildEdges.h"
+#include "atlas/mesh/actions/BuildHalo.h"
+#include "atlas/mesh/actions/BuildParallelFields.h"
+#include "atlas/mesh/actions/BuildPeriodicBoundaries.h"
 #include "atlas/mesh/detail/AccumulateFacets.h"
 #include "atlas/meshgenerator.h"
 #include "atlas/option.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/util/Unique.h"
 
 #include "tests/AtlasTestEnvironment.h"
@@ -512,6 +519,42 @@ CASE("test_build_edges_triangles_only") {
 
 //-----------------------------------------------------------------------------
 
+CASE("test_build_edges_does_not_depend_on_number_of_threads") {
+    auto build = [](int nb_threads) {
+        const int max_threads = atlas_omp_get_max_threads();
+        atlas_omp_set_num_threads(nb_threads);
+        Mesh mesh = StructuredMeshGenerator().generate(Grid("O32"));
+        mesh::actions::build_parallel_fields(mesh);
+        mesh::actions::build_periodic_boundaries(mesh);
+        mesh::actions::build_halo(mesh, 2);
+        mesh::actions::build_edges(mesh);
+        mesh::actions::build_node_to_edge_connectivity(mesh);
+        atlas_omp_set_num_threads(max_threads);
+        return mesh;
+    };
+    auto values = [](const auto& connectivity) {
+        std::vector<idx_t> v;
+        for (idx_t row = 0; row < connectivity.rows(); ++row) {
+            v.push_back(connectivity.cols(row));
+            for (idx_t col = 0; col < connectivity.cols(row); ++col) {
+                v.push_back(connectivity(row, col));
+            }
+        }
+        return v;
+    };
+
+    Mesh serial   = build(1);
+    Mesh threaded = build(std::max(4, atlas_omp_get_max_threads()));
+
+    EXPECT_EQ(threaded.edges().size(), serial.edges().size());
+    EXPECT(values(threaded.edges().node_connectivity()) == values(serial.edges().node_connectivity()));
+    EXPECT(values(threaded.edges().cell_connectivity()) == values(serial.edges().cell_connectivity()));
+    EXPECT(values(threaded.cells().edge_connectivity()) == values(serial.cells().edge_connectivity()));
+    EXPECT(values(threaded.nodes().edge_connectivity()) == values(serial.nodes().edge_connectivity()));
+}
+
+//-----------------------------------------------------------------------------
+
 CASE("test_pole_edge_default") {
     auto pole_edges = [](const Grid& grid) {
         auto mesh = StructuredMeshGenerator().generate(grid);
@@ -11,7 +11,12 @@
 
 //-----------------------------------------------------------------
 
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include "atlas/functionspace.h"
 #include "atlas/grid.h"
@@ -19,6 +24,9 @@
 #include "atlas/meshgenerator.h"
 
 #include "atlas/mesh/actions/BuildEdges.h"
+#include "atlas/mesh/actions/BuildHalo.h"
+#include "atlas/mesh/actions/BuildParallelFields.h"
+#include "atlas/mesh/actions/BuildPeriodicBoundaries.h"
 #include "atlas/mesh/actions/Reorder.h"
 #include "atlas/output/Gmsh.h"
 #include "atlas/runtime/Log.h"
@@ -360,6 +368,123 @@ CASE("test_none_reordering") {
     test_reordering(reorder_config);
 }
 
+CASE("test_reordering_with_halo_and_edges") {
+    if (grid_name() == "unstructured") {
+        Log::warning() << "Mesh with halo and edges is only tested for structured grids" << std::endl;
+        return;
+    }
+    auto mesh = StructuredMeshGenerator(util::Config("triangulate", true))(Grid{grid_name()});
+    mesh::actions::build_parallel_fields(mesh);
+    mesh::actions::build_periodic_boundaries(mesh);
+    mesh::actions::build_halo(mesh, 2);
+    mesh::actions::build_edges(mesh);
+    mesh::actions::build_node_to_edge_connectivity(mesh);
+
+    // Connectivities expressed with global indices, which are invariant under reordering
+    using Connections = std::map<gidx_t, std::multiset<gidx_t>>;
+
+    auto connections = [](const mesh::IrregularConnectivityImpl& connectivity, const Field& from, const Field& to) {
+        auto from_glb_idx = array::make_view<gidx_t, 1>(from);
+        auto to_glb_idx   = array::make_view<gidx_t, 1>(to);
+        Connections result;
+        for (idx_t r = 0; r < connectivity.rows(); ++r) {
+            auto& connected = result[from_glb_idx(r)];
+            for (idx_t c = 0; c < connectivity.cols(r); ++c) {
+                idx_t n = connectivity(r, c);
+                connected.insert(n == connectivity.missing_value() ? -1 : to_glb_idx(n));
+            }
+        }
+        return result;
+    };
+    auto all_connections = [&]() {
+        auto& nodes = mesh.nodes();
+        auto& cells = mesh.cells();
+        auto& edges = mesh.edges();
+        return std::vector<Connections>{
+            connections(nodes.edge_connectivity(), nodes.global_index(), edges.global_index()),
+            connections(cells.node_connectivity(), cells.global_index(), nodes.global_index()),
+            connections(cells.edge_connectivity(), cells.global_index(), edges.global_index()),
+            connections(edges.node_connectivity(), edges.global_index(), nodes.global_index()),
+            connections(edges.cell_connectivity(), edges.global_index(), cells.global_index())};
+    };
+    auto expected_connections = all_connections();
+
+    auto metrics_before = mesh::actions::ReorderImpl::computeLocalityMetrics(mesh);
+
+    auto reorder = mesh::actions::Reorder{option::type("hilbert")};
+    reorder(mesh);
+
+    auto metrics_after = mesh::actions::ReorderImpl::computeLocalityMetrics(mesh);
+    Log::info() << "Locality before reordering: " << metrics_before << std::endl;
+    Log::info() << "Locality after reordering:  " << metrics_after << std::endl;
+    EXPECT(metrics_after.mean_span <= metrics_after.bandwidth);
+
+    EXPECT(all_connections() == expected_connections);
+
+    // Grouped by halo, and within each halo owned entities first
+    const int mpi_rank = static_cast<int>(mpi::comm().rank());
+
+    auto check_grouped_by_halo = [mpi_rank](const Field& halo_field, const Field& part_field, idx_t begin,
+                                            idx_t end) {
+        auto halo  = array::make_view<int, 1>(halo_field);
+        auto part  = array::make_view<int, 1>(part_field);
+        auto group = [&](idx_t j) { return std::make_pair(halo(j), part(j) != mpi_rank); };
+        for (idx_t j = begin + 1; j < end; ++j) {
+            EXPECT(group(j - 1) <= group(j));
+        }
+    };
+    check_grouped_by_halo(mesh.nodes().halo(), mesh.nodes().partition(), 0, mesh.nodes().size());
+    for (idx_t t = 0; t < mesh.cells().nb_types(); ++t) {
+        check_grouped_by_halo(mesh.cells().halo(), mesh.cells().partition(), mesh.cells().elements(t).begin(),
+                              mesh.cells().elements(t).end());
+    }
+
+    // Remote indices of owned nodes point to the node itself
+    auto ridx  = array::make_indexview<idx_t, 1>(mesh.nodes().remote_index());
+    auto part  = array::make_view<int, 1>(mesh.nodes().partition());
+    auto ghost = array::make_view<int, 1>(mesh.nodes().ghost());
+    for (idx_t j = 0; j < mesh.nodes().size(); ++j) {
+        if (part(j) == mpi_rank && not ghost(j)) {
+            EXPECT_EQ(ridx(j), j);
+        }
+    }
+
+    // Remote indices of all nodes point to the same node, or its periodic image, in the new order of the owner
+    const int mpi_size = static_cast<int>(mpi::comm().size());
+    auto lonlat        = array::make_view<double, 2>(mesh.nodes().lonlat());
+    std::vector<std::vector<idx_t>> send_ridx(mpi_size);
+    std::vector<std::vector<idx_t>> recv_ridx(mpi_size);
+    std::vector<std::vector<idx_t>> send_nodes(mpi_size);
+    for (idx_t j = 0; j < mesh.nodes().size(); ++j) {
+        send_ridx[part(j)].push_back(ridx(j));
+        send_nodes[part(j)].push_back(j);
+    }
+    mpi::comm().allToAll(send_ridx, recv_ridx);
+    std::vector<std::vector<double>> send_lonlat(mpi_size);
+    std::vector<std::vector<double>> recv_lonlat(mpi_size);
+    for (int p = 0; p < mpi_size; ++p) {
+        for (idx_t r : recv_ridx[p]) {
+            EXPECT(r >= 0 && r < mesh.nodes().size());
+            r = std::max(idx_t{0}, std::min(r, mesh.nodes().size() - 1));
+            send_lonlat[p].push_back(lonlat(r, LON));
+            send_lonlat[p].push_back(lonlat(r, LAT));
+        }
+    }
+    mpi::comm().allToAll(send_lonlat, recv_lonlat);
+    idx_t nb_wrong_remote_index = 0;
+    for (int p = 0; p < mpi_size; ++p) {
+        for (size_t k = 0; k < send_nodes[p].size(); ++k) {
+            const idx_t j     = send_nodes[p][k];
+            const double dlon = std::remainder(lonlat(j, LON) - recv_lonlat[p][2 * k + 0], 360.);
+            const double dlat = lonlat(j, LAT) - recv_lonlat[p][2 * k + 1];
+            if (std::abs(dlon) > 1.e-9 || std::abs(dlat) > 1.e-9) {
+                ++nb_wrong_remote_index;
+            }
+        }
+    }
+    EXPECT_EQ(nb_wrong_remote_index, 0);
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -0,0 +1,87 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "atlas/library/config.h"
+#include "atlas/parallel/GlobalIndexRenumbering.h"
+#include "atlas/parallel/mpi/Buffer.h"
+#include "atlas/parallel/mpi/mpi.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+// Reference numbering, computed from the global list of values on every task
+std::vector<gidx_t> reference_renumbering(const std::vector<gidx_t>& values, gidx_t base) {
+    mpi::Buffer<gidx_t, 1> recv(mpi::comm().size());
+    mpi::comm().allGatherv(values.begin(), values.end(), recv);
+    std::vector<gidx_t> sorted(recv.buffer);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::vector<gidx_t> renumbered(values.size());
+    for (size_t j = 0; j < values.size(); ++j) {
+        renumbered[j] = base + 1 + (std::lower_bound(sorted.begin(), sorted.end(), values[j]) - sorted.begin());
+    }
+    return renumbered;
+}
+
+std::vector<gidx_t> random_values(size_t size, gidx_t max, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<gidx_t> distribution(-max, max);
+    std::vector<gidx_t> values(size);
+    for (auto& v : values) {
+        v = distribution(generator);
+    }
+    return values;
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_renumber_global_index") {
+    const size_t rank = mpi::comm().rank();
+
+    SECTION("overlapping values") {
+        // Small range of values, so that values are duplicated within and across tasks
+        auto values = random_values(1000 + 100 * rank, 2000, 7 + rank);
+        auto ref    = reference_renumbering(values, 0);
+        parallel::renumber_global_index(values);
+        EXPECT(values == ref);
+    }
+
+    SECTION("uneven distribution with offset") {
+        // Only the last task has values
+        auto values = random_values(rank == mpi::comm().size() - 1 ? 5000 : 0, 1000000, 11);
+        auto ref    = reference_renumbering(values, 100);
+        parallel::renumber_global_index(values, 100);
+        EXPECT(values == ref);
+    }
+
+    SECTION("no values") {
+        std::vector<gidx_t> values;
+        parallel::renumber_global_index(values);
+        EXPECT(values.empty());
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
@@ -225,6 +225,120 @@ void test_rank1(Fixture& f) {
     }
 }
 
+void test_plan_reuse(Fixture& f) {
+    EXPECT_EQ(f.halo_exchange.nb_plans(), 0);
+
+    // Repeated exchanges of fields with same datatype and shape share one plan
+    for (int iter = 0; iter < 3; ++iter) {
+        test_rank1(f);
+        EXPECT_EQ(f.halo_exchange.nb_plans(), 1);
+    }
+
+    // Different number of variables per point requires a new plan
+    test_rank0_arrview(f);
+    EXPECT_EQ(f.halo_exchange.nb_plans(), 2);
+
+    // Interleaving with an existing plan does not create new ones
+    test_rank1(f);
+    EXPECT_EQ(f.halo_exchange.nb_plans(), 2);
+}
+
+void test_multiple_arrays(Fixture& f) {
+    // Arrays of mixed datatype and rank exchanged within a single message per partition
+    array::ArrayT<POD> arr1(f.N);
+    array::ArrayT<float> arr2(f.N, 3);
+    array::ArrayT<int> arr3(f.N, 2, 2);
+    auto v1 = array::make_host_view<POD, 1>(arr1);
+    auto v2 = array::make_host_view<float, 2>(arr2);
+    auto v3 = array::make_host_view<int, 3>(arr3);
+    auto rank = mpi::comm().rank();
+    for (int j = 0; j < f.N; ++j) {
+        bool owned = size_t(f.part[j]) == rank;
+        v1(j)      = owned ? f.gidx[j] : 0;
+        for (idx_t k = 0; k < 3; ++k) {
+            v2(j, k) = owned ? float(f.gidx[j] * (k + 1)) : 0.f;
+        }
+        for (idx_t k = 0; k < 2; ++k) {
+            for (idx_t l = 0; l < 2; ++l) {
+                v3(j, k, l) = owned ? int(f.gidx[j]) * 10 + 2 * k + l : 0;
+            }
+        }
+    }
+
+    f.halo_exchange.execute({&arr1, &arr2, &arr3});
+    EXPECT_EQ(f.halo_exchange.nb_plans(), 1);
+
+    std::vector<POD> expected;
+    switch (rank) {
+        case 0:
+            expected = {9, 1, 2, 3, 4};
+            break;
+        case 1:
+            expected = {3, 4, 5, 6, 7, 8};
+            break;
+        case 2:
+            expected = {5, 6, 7, 8, 9, 1, 2};
+            break;
+    }
+    for (int j = 0; j < f.N; ++j) {
+        EXPECT_EQ(v1(j), expected[j]);
+        for (idx_t k = 0; k < 3; ++k) {
+            EXPECT_EQ(v2(j, k), float(expected[j] * (k + 1)));
+        }
+        for (idx_t k = 0; k < 2; ++k) {
+            for (idx_t l = 0; l < 2; ++l) {
+                EXPECT_EQ(v3(j, k, l), int(expected[j]) * 10 + 2 * k + l);
+            }
+        }
+    }
+}
+
+void test_split_phase(Fixture& f) {
+    array::ArrayT<POD> arr(f.N);
+    auto arrv = array::make_host_view<POD, 1>(arr);
+    auto rank = mpi::comm().rank();
+    for (int j = 0; j < f.N; ++j) {
+        arrv(j) = (size_t(f.part[j]) != rank ? 0 : f.gidx[j]);
+    }
+
+    bool completed = false;
+    auto handle    = f.halo_exchange.exchange_begin(arr);
+    handle.on_completion([&completed]() { completed = true; });
+    EXPECT(handle.active());
+
+    // Interior values are untouched by the exchange and can be used while it is in flight
+    auto interior = f.halo_exchange.interior_indices();
+    for (idx_t j : interior) {
+        EXPECT_EQ(arrv(j), f.gidx[j]);
+    }
+
+    // The communication pattern cannot be redefined while the exchange is in flight
+    EXPECT_THROWS_AS(f.halo_exchange.setup(f.part.data(), f.ridx.data(), 0, f.N), eckit::Exception);
+
+    f.halo_exchange.exchange_end(handle);
+    EXPECT(not handle.active());
+    EXPECT(completed);
+
+    std::vector<POD> expected;
+    switch (rank) {
+        case 0:
+            expected = {9, 1, 2, 3, 4};
+            EXPECT_EQ(interior.size(), 3);
+            break;
+        case 1:
+            expected = {3, 4, 5, 6, 7, 8};
+            EXPECT_EQ(interior.size(), 3);
+            break;
+        case 2:
+            expected = {5, 6, 7, 8, 9, 1, 2};
+            EXPECT_EQ(interior.size(), 3);
+            break;
+    }
+    for (int j = 0; j < f.N; ++j) {
+        EXPECT_EQ(arrv(j), expected[j]);
+    }
+}
+
 void test_rank1_strided_v1(Fixture& f) {
     // create a 2d field from the gidx data, with two components per grid point
     array::ArrayT<POD> arr_t(f.N, 2);
@@ -733,6 +847,12 @@ CASE("test_haloexchange") {
     SECTION("test_rank2_paralleldim_2") { test_rank2_paralleldim2(f); }
 
     SECTION("test_rank1_cinterface") { test_rank1_cinterface(f); }
+
+    SECTION("test_plan_reuse") { test_plan_reuse(f); }
+
+    SECTION("test_multiple_arrays") { test_multiple_arrays(f); }
+
+    SECTION("test_split_phase") { test_split_phase(f); }
 }
 
 #if ATLAS_HAVE_GPU
@@ -489,6 +489,33 @@ CASE("Structured grid") {
 
         test.execute();
     }
+
+    SECTION("Point Cloud with empty partitions") {
+        // All source points are on the first task, and target points are dealt out round-robin, so that
+        // owners of matching points are unrelated to each other and to the home task of the UID directory.
+        const auto mpi_rank = static_cast<idx_t>(mpi::comm().rank());
+        const auto mpi_size = static_cast<idx_t>(mpi::comm().size());
+
+        auto sourceLonLat = std::vector<PointXY>{};
+        auto targetLonLat = std::vector<PointXY>{};
+        idx_t j           = 0;
+        for (const auto& p : grid.lonlat()) {
+            if (mpi_rank == 0) {
+                sourceLonLat.emplace_back(p.lon(), p.lat());
+            }
+            if (j % mpi_size == mpi_size - 1 - mpi_rank) {
+                targetLonLat.emplace_back(p.lon(), p.lat());
+            }
+            ++j;
+        }
+
+        const auto sourcePointCloud = functionspace::PointCloud(sourceLonLat);
+        const auto targetPointCloud = functionspace::PointCloud(targetLonLat);
+
+        auto test = TestRedistributionPoints2<double>(sourcePointCloud, targetPointCloud);
+
+        test.execute();
+    }
 }
 
 CASE("Cubed sphere grid") {
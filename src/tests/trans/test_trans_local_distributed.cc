@@ -0,0 +1,129 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "atlas/array.h"
+#include "atlas/field.h"
+#include "atlas/functionspace/Spectral.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/grid.h"
+#include "atlas/grid/Distribution.h"
+#include "atlas/option.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/trans/Trans.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+struct AtlasTransEnvironment : public AtlasTestEnvironment {
+    AtlasTransEnvironment(int argc, char* argv[]): AtlasTestEnvironment(argc, argv) {
+        trans::Trans::backend("local");
+        trans::Trans::config(option::warning(0));
+    }
+};
+
+std::vector<double> spectra(int truncation, int nb_fields) {
+    std::vector<double> sp(nb_fields * (truncation + 1) * (truncation + 2));
+    for (size_t i = 0; i < sp.size(); ++i) {
+        sp[i] = std::cos(0.1 * i) / (1. + 0.01 * i);
+    }
+    return sp;
+}
+
+// Reference computed without distribution, by every task on its own
+std::vector<double> invtrans_serial(const Grid& grid, int truncation, int nb_scalar_fields, int nb_vordiv_fields) {
+    mpi::Scope scope("self");
+    trans::Trans trans(grid, truncation, option::type("local"));
+    auto scalar     = spectra(truncation, nb_scalar_fields);
+    auto vorticity  = spectra(truncation, nb_vordiv_fields);
+    auto divergence = spectra(truncation, nb_vordiv_fields);
+    std::vector<double> gp((nb_scalar_fields + 2 * nb_vordiv_fields) * grid.size());
+    trans.invtrans(nb_scalar_fields, scalar.data(), nb_vordiv_fields, vorticity.data(), divergence.data(), gp.data());
+    return gp;
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_invtrans_distributed_structuredcolumns") {
+    const int truncation = 31;
+    for (std::string gridname : {"O32", "F32"}) {
+        SECTION(gridname) {
+            Grid grid(gridname);
+            functionspace::StructuredColumns gp(grid, grid::Partitioner("equal_regions"));
+            functionspace::Spectral sp(truncation);
+            trans::Trans trans(gp, sp);
+
+            Field spfield = sp.createField<double>(option::name("sp"));
+            Field gpfield = gp.createField<double>(option::name("gp"));
+            auto values   = spectra(truncation, 1);
+            auto spview   = array::make_view<double, 1>(spfield);
+            for (idx_t i = 0; i < spview.size(); ++i) {
+                spview(i) = values[i];
+            }
+
+            trans.invtrans(spfield, gpfield);
+
+            auto reference    = invtrans_serial(grid, truncation, 1, 0);
+            auto gpview       = array::make_view<double, 1>(gpfield);
+            auto global_index = array::make_view<gidx_t, 1>(gp.global_index());
+            for (idx_t n = 0; n < gp.sizeOwned(); ++n) {
+                EXPECT_APPROX_EQ(gpview(n), reference[global_index(n) - 1], 1.e-10);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_invtrans_distributed_vordiv") {
+    const int truncation         = 31;
+    const int nb_scalar_fields   = 2;
+    const int nb_vordiv_fields   = 1;
+    const int nb_fields          = nb_scalar_fields + 2 * nb_vordiv_fields;
+    Grid grid("O32");
+
+    // Without function space, grid points are distributed with the "partitioner" configuration
+    trans::Trans trans(grid, truncation, option::type("local") | util::Config("partitioner", "equal_regions"));
+    grid::Distribution distribution(grid, util::Config("type", "equal_regions"));
+    std::vector<gidx_t> points;
+    for (gidx_t n = 0; n < grid.size(); ++n) {
+        if (distribution.partition(n) == mpi::rank()) {
+            points.emplace_back(n);
+        }
+    }
+
+    auto scalar     = spectra(truncation, nb_scalar_fields);
+    auto vorticity  = spectra(truncation, nb_vordiv_fields);
+    auto divergence = spectra(truncation, nb_vordiv_fields);
+    std::vector<double> gp(nb_fields * points.size());
+    trans.invtrans(nb_scalar_fields, scalar.data(), nb_vordiv_fields, vorticity.data(), divergence.data(), gp.data());
+
+    auto reference = invtrans_serial(grid, truncation, nb_scalar_fields, nb_vordiv_fields);
+    for (int jfld = 0; jfld < nb_fields; ++jfld) {
+        for (size_t n = 0; n < points.size(); ++n) {
+            EXPECT_APPROX_EQ(gp[jfld * points.size() + n], reference[jfld * grid.size() + points[n]], 1.e-10);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main(int argc, char** argv) {
+    return atlas::test::run<atlas::test::AtlasTransEnvironment>(argc, argv);
+}
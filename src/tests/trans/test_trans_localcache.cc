@@ -9,16 +9,23 @@
  */
 
 #include <algorithm>
+#include <fstream>
 #include <iomanip>
+#include <string>
+#include <vector>
 
+#include "eckit/filesystem/PathName.h"
 #include "eckit/utils/MD5.h"
 
 #include "atlas/grid.h"
+#include "atlas/library/defines.h"
 #include "atlas/option.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Trace.h"
+#include "atlas/trans/Cache.h"
 #include "atlas/trans/LegendreCacheCreator.h"
 #include "atlas/trans/Trans.h"
+#include "atlas/trans/local/FFTWWisdom.h"
 #include "atlas/util/Constants.h"
 
 #include "tests/AtlasTestEnvironment.h"
@@ -36,8 +43,10 @@ struct AtlasTransEnvironment : public AtlasTestEnvironment {
 };
 
 using trans::Cache;
+using trans::FFTWWisdom;
 using trans::LegendreCache;
 using trans::LegendreCacheCreator;
+using trans::MappedLegendreCache;
 using trans::Trans;
 using XSpace        = StructuredGrid::XSpace;
 using YSpace        = StructuredGrid::YSpace;
@@ -261,6 +270,89 @@ CASE("test cache creator in memory") {
     auto trans2 = Trans(cache, grid_global, truncation);
 }
 
+CASE("test mapped cache with header") {
+    auto truncation = 31;
+    Grid grid("O32");
+
+    LegendreCacheCreator legendre_cache_creator(grid, truncation);
+    auto cachefile =
+        CacheFile("leg_mapped_" + legendre_cache_creator.uid() + "." + std::to_string(mpi::comm().rank()) + ".bin");
+    legendre_cache_creator.create(cachefile);
+
+    // The mapped cache holds the same bytes as the cache read into memory
+    Cache cache = MappedLegendreCache(cachefile);
+    EXPECT(hash(cache) == hash(cachefile));
+
+    std::vector<double> sp((truncation + 1) * (truncation + 2));
+    for (size_t i = 0; i < sp.size(); ++i) {
+        sp[i] = 1. / (1. + i);
+    }
+    std::vector<double> gp_mapped(grid.size());
+    std::vector<double> gp(grid.size());
+    Trans(cache, grid, truncation).invtrans(1, sp.data(), gp_mapped.data());
+    Trans(grid, truncation).invtrans(1, sp.data(), gp.data());
+    EXPECT(gp_mapped == gp);
+
+    // A cache for another truncation, other latitudes or another precision is rejected
+    EXPECT_THROWS(Trans(cache, grid, truncation - 1));
+    EXPECT_THROWS(Trans(cache, Grid("O48"), truncation));
+    EXPECT_THROWS(Trans(cache, grid, truncation, util::Config("precision", "single")));
+
+    // The same cache file is valid for other grids with the same latitudes
+    Trans(cache, Grid("F32"), truncation);
+
+    cache = Cache();
+    cachefile.unlink();
+}
+
+#if ATLAS_HAVE_FFTW
+CASE("test fftw wisdom with measured planning") {
+    auto truncation = 31;
+    Grid grid("O32");
+    util::Config options;
+    options.set(option::type("local"));
+    options.set("fftw_planning", "measure");
+
+    auto trans1 = Trans(grid, truncation, options);
+    auto trans2 = Trans(grid, truncation, options);  // reuses the wisdom gathered by trans1
+#if ATLAS_HAVE_FFTW_SINGLE
+    auto trans3 = Trans(grid, truncation, options | util::Config("precision", "single"));
+#endif
+
+    // Wisdom is a list "(fftw-3.x fftw_wisdom ...\n (entry)\n ...)", with one entry per measured plan
+    auto nb_wisdom_entries = [](const eckit::PathName& file) {
+        std::ifstream in(file.asString());
+        std::string line;
+        std::getline(in, line);
+        EXPECT(line.find("fftw_wisdom") != std::string::npos);
+        size_t entries = 0;
+        while (std::getline(in, line)) {
+            entries += (line.find("(fftw") != std::string::npos);
+        }
+        return entries;
+    };
+
+    eckit::PathName path("atlas_test_trans_localcache.fftw-wisdom." + std::to_string(mpi::comm().rank()));
+    eckit::PathName path_single(path.asString() + ".single");
+    FFTWWisdom::instance().save(path);
+    EXPECT(path.exists());
+    EXPECT(nb_wisdom_entries(path) > 0);
+#if ATLAS_HAVE_FFTW_SINGLE
+    EXPECT(path_single.exists());
+    EXPECT(nb_wisdom_entries(path_single) > 0);
+#endif
+    FFTWWisdom::instance().load(path);
+    for (auto& file : {path, path_single}) {
+        if (file.exists()) {
+            file.unlink();
+        }
+    }
+
+    options.set("fftw_planning", "unknown");
+    EXPECT_THROWS(Trans(grid, truncation, options));
+}
+#endif
+
 CASE("ATLAS-256: Legendre coefficient expected unique identifiers") {
     util::Config options;
     options.set(option::type("local"));
@@ -1838,6 +1838,217 @@ CASE( "test_trans_fourier_truncation" ) {
     // TODO: create some real criterion to test fourier_truncation. So far only comparison with trans library through print statements.
 }
 #endif
+
+//-----------------------------------------------------------------------------
+
+CASE("test_trans_single_precision") {
+    Log::info() << "test_trans_single_precision" << std::endl;
+    // compare the single precision path of TransLocal with the double precision one
+
+    const int trc       = 31;
+    const int nb_scalar = 2;
+    const int nb_vordiv = 1;
+    const int nb_spec   = (trc + 1) * (trc + 2);
+    std::vector<double> sp(nb_scalar * nb_spec);
+    std::vector<double> vor(nb_vordiv * nb_spec);
+    std::vector<double> div(nb_vordiv * nb_spec);
+    for (int i = 0; i < nb_scalar * nb_spec; ++i) {
+        sp[i] = std::sin(0.1 * i) / (1. + 0.01 * i);
+    }
+    for (int i = 0; i < nb_vordiv * nb_spec; ++i) {
+        vor[i] = std::cos(0.2 * i) / (1. + 0.01 * i);
+        div[i] = std::sin(0.3 * i) / (1. + 0.01 * i);
+    }
+
+    auto compare = [&](const std::string& gridname, const util::Config& config) {
+        Log::info() << "grid " << gridname << " with config " << config << std::endl;
+        Grid g(gridname);
+        trans::Trans trans_dp(g, trc, option::type("local") | config);
+        trans::Trans trans_sp(g, trc, option::type("local") | config | util::Config("precision", "single"));
+
+        const size_t nb_gp = size_t(nb_scalar + 2 * nb_vordiv) * g.size();
+        std::vector<double> gp_dp(nb_gp);
+        std::vector<double> gp_sp(nb_gp);
+        trans_dp.invtrans(nb_scalar, sp.data(), nb_vordiv, vor.data(), div.data(), gp_dp.data());
+        trans_sp.invtrans(nb_scalar, sp.data(), nb_vordiv, vor.data(), div.data(), gp_sp.data());
+
+        double max     = 0.;
+        double maxdiff = 0.;
+        for (size_t i = 0; i < nb_gp; ++i) {
+            max     = std::max(max, std::abs(gp_dp[i]));
+            maxdiff = std::max(maxdiff, std::abs(gp_sp[i] - gp_dp[i]));
+        }
+        Log::info() << "max = " << max << "  maxdiff = " << maxdiff << std::endl;
+        EXPECT(max > 0.);
+        EXPECT(maxdiff < 1.e-4 * max);
+    };
+
+    compare("F32", util::Config("fft", "OFF"));
+#if ATLAS_HAVE_FFTW
+    compare("F32", util::Config("fft", "FFTW"));
+    compare("O32", util::Config("fft", "FFTW"));
+#endif
+
+    EXPECT_THROWS(trans::Trans(Grid("F32"), trc, option::type("local") | util::Config("precision", "half")));
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_trans_legendre_on_the_fly") {
+    Log::info() << "test_trans_legendre_on_the_fly" << std::endl;
+    // compare Legendre polynomials computed on the fly with precomputed ones
+
+    const int trc       = 47;
+    const int nb_scalar = 3;
+    const int nb_spec   = (trc + 1) * (trc + 2);
+    std::vector<double> sp(nb_scalar * nb_spec);
+    for (int i = 0; i < nb_scalar * nb_spec; ++i) {
+        sp[i] = std::sin(0.1 * i) / (1. + 0.01 * i);
+    }
+
+    auto compare = [&](const std::string& gridname, const util::Config& config, double tolerance) {
+        Log::info() << "grid " << gridname << " with config " << config << std::endl;
+        Grid g(gridname);
+        trans::Trans trans_precomputed(g, trc, option::type("local") | config);
+        for (int block_size : {1, 7, 64}) {
+            trans::Trans trans_on_the_fly(g, trc,
+                                          option::type("local") | config | util::Config("legendre_on_the_fly", true) |
+                                              util::Config("legendre_block_size", block_size));
+
+            std::vector<double> gp_precomputed(nb_scalar * g.size());
+            std::vector<double> gp_on_the_fly(nb_scalar * g.size());
+            trans_precomputed.invtrans(nb_scalar, sp.data(), gp_precomputed.data());
+            trans_on_the_fly.invtrans(nb_scalar, sp.data(), gp_on_the_fly.data());
+            for (size_t i = 0; i < gp_precomputed.size(); ++i) {
+                EXPECT_APPROX_EQ(gp_on_the_fly[i], gp_precomputed[i], tolerance);
+            }
+        }
+    };
+
+    compare("F32", util::Config("fft", "OFF"), 1.e-10);
+    compare("F32", util::Config("fft", "OFF") | util::Config("precision", "single"), 1.e-4);
+#if ATLAS_HAVE_FFTW
+    compare("O32", util::Config("fft", "FFTW"), 1.e-10);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_trans_dirtrans") {
+    Log::info() << "test_trans_dirtrans" << std::endl;
+    // the direct transform of the inverse transform reproduces the spectral coefficients
+
+    const int trc       = 31;
+    const int nb_scalar = 3;
+    const int nb_spec   = (trc + 1) * (trc + 2);
+    // Coefficients of zonal wavenumber trc, and imaginary parts of zonal wavenumber 0, do not contribute to the
+    // grid point values (checked below), so they cannot be reproduced and are left zero
+    std::vector<double> sp(nb_scalar * nb_spec);
+    std::vector<double> sp_ignored(nb_scalar * nb_spec);
+    for (int jm = 0, i = 0; jm <= trc; jm++) {
+        for (int jn = jm; jn <= trc; jn++) {
+            for (int imag = 0; imag < 2; imag++) {
+                for (int jfld = 0; jfld < nb_scalar; jfld++, i++) {
+                    const bool ignored = (jm == trc || (jm == 0 && imag == 1));
+                    sp[i]              = ignored ? 0. : std::sin(0.1 * i) / (1. + 0.01 * i);
+                    sp_ignored[i]      = ignored ? std::sin(0.1 * i) / (1. + 0.01 * i) : 0.;
+                }
+            }
+        }
+    }
+
+    auto roundtrip = [&](const std::string& gridname, const util::Config& config, double tolerance) {
+        Log::info() << "grid " << gridname << " with config " << config << std::endl;
+        Grid g(gridname);
+        trans::Trans trans(g, trc, option::type("local") | config);
+
+        std::vector<double> gp(nb_scalar * g.size());
+        trans.invtrans(nb_scalar, sp_ignored.data(), gp.data());
+        EXPECT(std::all_of(gp.begin(), gp.end(), [](double v) { return v == 0.; }));
+
+        std::vector<double> sp_dir(nb_scalar * nb_spec);
+        trans.invtrans(nb_scalar, sp.data(), gp.data());
+        trans.dirtrans(nb_scalar, gp.data(), sp_dir.data());
+
+        double max     = 0.;
+        double maxdiff = 0.;
+        for (size_t i = 0; i < sp.size(); ++i) {
+            max     = std::max(max, std::abs(sp[i]));
+            maxdiff = std::max(maxdiff, std::abs(sp_dir[i] - sp[i]));
+        }
+        Log::info() << "max = " << max << "  maxdiff = " << maxdiff << std::endl;
+        EXPECT(maxdiff < tolerance * max);
+    };
+
+    roundtrip("F32", util::Config("fft", "OFF"), 1.e-10);
+#if ATLAS_HAVE_FFTW
+    roundtrip("F32", util::Config("fft", "FFTW"), 1.e-10);
+    // latitudes near the poles do not contribute to the largest zonal wavenumbers
+    roundtrip("O32", util::Config("fft", "FFTW"), 1.e-6);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_trans_invtrans_grad") {
+    Log::info() << "test_trans_invtrans_grad" << std::endl;
+    // s = P_1^0(sin(lat)) = sqrt(3) sin(lat) has the gradient (0, sqrt(3) cos(lat) / a)
+    const int trc     = 31;
+    const int nb_spec = (trc + 1) * (trc + 2);
+    Grid g("F32");
+    trans::Trans trans(g, trc, option::type("local"));
+    Field spf("sp", array::make_datatype<double>(), array::make_shape(nb_spec));
+    Field gpf("gp", array::make_datatype<double>(), array::make_shape(g.size()));
+    Field gradf("grad", array::make_datatype<double>(), array::make_shape(g.size(), 2));
+    auto spv = array::make_view<double, 1>(spf);
+    spv.assign(0.);
+    spv(2) = 1.;  // jm = 0, jn = 1, real part
+    trans.invtrans(spf, gpf);
+    trans.invtrans_grad(spf, gradf);
+
+    const double a = util::Earth::radius();
+    auto gp        = array::make_view<double, 1>(gpf);
+    auto grad      = array::make_view<double, 2>(gradf);
+    idx_t n        = 0;
+    for (auto p : g.lonlat()) {
+        const double lat = p.lat() * util::Constants::degreesToRadians();
+        EXPECT_APPROX_EQ(gp(n), std::sqrt(3.) * std::sin(lat), 1.e-10);
+        EXPECT_APPROX_EQ(grad(n, 0) * a, 0., 1.e-10);
+        EXPECT_APPROX_EQ(grad(n, 1) * a, std::sqrt(3.) * std::cos(lat), 1.e-8);
+        ++n;
+    }
+
+    // s = A cos(lat) cos(lon), with A following from the normalisation of P_1^1, has the non-zonal gradient
+    // (-A sin(lon), -A sin(lat) cos(lon)) / a
+    spv.assign(0.);
+    spv(2 * (trc + 1)) = 1.;  // jm = 1, jn = 1, real part
+    trans.invtrans(spf, gpf);
+    trans.invtrans_grad(spf, gradf);
+
+    // least squares fit of A
+    double num = 0.;
+    double den = 0.;
+    n          = 0;
+    for (auto p : g.lonlat()) {
+        const double f = std::cos(p.lat() * util::Constants::degreesToRadians()) *
+                         std::cos(p.lon() * util::Constants::degreesToRadians());
+        num += gp(n++) * f;
+        den += f * f;
+    }
+    const double A = num / den;
+    EXPECT(std::abs(A) > 0.1);
+
+    n = 0;
+    for (auto p : g.lonlat()) {
+        const double lat = p.lat() * util::Constants::degreesToRadians();
+        const double lon = p.lon() * util::Constants::degreesToRadians();
+        EXPECT_APPROX_EQ(gp(n), A * std::cos(lat) * std::cos(lon), 1.e-10);
+        EXPECT_APPROX_EQ(grad(n, 0) * a, -A * std::sin(lon), 1.e-8);
+        EXPECT_APPROX_EQ(grad(n, 1) * a, -A * std::sin(lat) * std::cos(lon), 1.e-8);
+        ++n;
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -0,0 +1,79 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <map>
+#include <random>
+
+#include "atlas/library/config.h"
+#include "atlas/util/detail/FlatHashMap.h"
+#include "tests/AtlasTestEnvironment.h"
+
+using atlas::util::detail::FlatHashMap;
+using atlas::util::detail::FlatHashSet;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+CASE("test_flat_hash_map") {
+    FlatHashMap<gidx_t, idx_t> map;
+    std::map<gidx_t, idx_t> reference;
+
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<gidx_t> distribution(-100000, 100000);
+
+    // Repeatedly clear and refill, as done for each halo level in BuildHalo
+    for (int iteration = 0; iteration < 3; ++iteration) {
+        map.clear();
+        reference.clear();
+        EXPECT(map.empty());
+        for (idx_t j = 0; j < 50000; ++j) {
+            gidx_t key    = 1024 * distribution(generator);
+            bool inserted = map.insert(key, j).second;
+            EXPECT_EQ(inserted, reference.emplace(key, j).second);
+        }
+        EXPECT_EQ(map.size(), reference.size());
+        for (const auto& entry : reference) {
+            const idx_t* found = map.find(entry.first);
+            EXPECT(found != nullptr);
+            EXPECT_EQ(*found, entry.second);
+        }
+        EXPECT(not map.contains(1));
+    }
+
+    map[1] = 5;
+    EXPECT_EQ(*map.find(1), 5);
+    map[1] = 6;
+    EXPECT_EQ(*map.find(1), 6);
+    EXPECT_EQ(map.insert(1, 7).second, false);
+    EXPECT_EQ(*map.find(1), 6);
+}
+
+CASE("test_flat_hash_set") {
+    FlatHashSet<gidx_t> set;
+    EXPECT(not set.contains(3));
+    EXPECT(set.insert(3));
+    EXPECT(not set.insert(3));
+    EXPECT(set.contains(3));
+    EXPECT(set.insert(-3));
+    EXPECT_EQ(set.size(), size_t(2));
+    set.clear();
+    EXPECT(not set.contains(3));
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}